@@ -0,0 +1,5976 @@
+#if !defined(_WIN32)
+/*fseeko() and 64 bit file offsets for tiled maps*/
+#define _POSIX_C_SOURCE  200809L
+#define _FILE_OFFSET_BITS 64
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <stdatomic.h>
+#include <signal.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if !defined(_WIN32)
+#include <pthread.h>
+#include <sched.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+#include "GPS_Explorer.h"
+
+
+/*==================================================================================*/
+/*==================================================================================*/
+/*Macros*/
+/*=========================================*/
+
+/*Input map status of a surrounding cell of current cell , read from cell source of explorer if it has one*/
+#define INPUT_CELL(Explorer,Index)   ((NULL == (Explorer)->Source) ? MAP_GET(&(Explorer)->Inputmap,(Index)) : u8ReadInputCell((Explorer),(Index)))
+
+
+/*==================================================================================*/
+/*==================================================================================*/
+/*Functions Prototypes*/
+/*=========================================*/
+
+/*this function checks that a map size can be searched , both sides are not 0 , Stride (Width+2) fits in u32
+ *and every cell including borders is reachable by a u32 index
+ *Arguments : number of columns and number of rows without borders
+ *Return    : TRUE if map size is supported , FALSE otherwise */
+static u8 u8IsMapSizeSupported(u32 Width, u32 Height);
+
+/*this function writes one run of cells of a map archive band
+ *Arguments : pointer to encoded bytes , status of run cells , run length (1 or more)
+ *Return    : number of bytes written (1 to 6) */
+static u32 u32EncodeRun(u8 *Bytes, u8 Status, u32 Length);
+
+/*this function moves file position of a map archive
+ *Arguments : pointer to open map archive , file offset
+ *Return    : ERROR_NONE or ERROR_READ_FILE */
+static u8 u8SeekArchive(maparchive *Archive, u64 Offset);
+
+/*this function writes a u32 number as little endian bytes
+ *Arguments : pointer to first byte , number
+ *Return    : void */
+static void voidWriteLittleEndian(u8 *Bytes, u32 Value);
+
+/*this function releases a one byte per cell status array
+ *Arguments : status array , number of cells , storage of the array (MAP_STORAGE_xxx)
+ *Return    : void */
+static void voidReleaseStatus(u8 *Status, u64 NumberOfCells, u8 Storage);
+
+#if MAP_PACKED == TRUE
+/*this function allocates cleared bit planes of a packed map
+ *Arguments : pointer to map with Width and Height set , number of bit planes , arena they are taken from (MAP_ARENA)
+ *Return    : ERROR_NONE , ERROR_NO_MEMORY , ERROR_ARENA_FULL or ERROR_MAP_SIZE (map bigger than arena map size) */
+static u8 u8CreatePackedMap(cellmap *map, u8 Planes, arena *Arena);
+#endif
+
+/*this function converts a cell status to its packed code
+ *Arguments : cell status
+ *Return    : packed code */
+static u8 u8StatusToCode(u8 Status);
+
+#if MAP_PACKED == TRUE
+/*this function packs a one byte per cell status array into bit planes of a packed map
+ *Arguments : pointer to map created by u8CreatePackedMap(); , status array including borders
+ *Return    : void */
+static void voidPackMap(cellmap *map, const u8 *Source);
+#endif
+
+#if MAP_TILED == TRUE
+/*this function sets up tile cache of a tiled map over its backing file , backing file is closed if
+ *tile cache can not be allocated
+ *Arguments : pointer to map with Width and Height set , backing file , file offset of first status byte ,
+ *            backing file layout (TILE_LAYOUT_xxx)
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY */
+static u8 u8OpenTiledMap(cellmap *map, FILE *File, u64 DataOffset, u8 Layout);
+#endif
+
+/*this function closes backing file of a tiled map and releases its tile cache
+ *Arguments : pointer to map
+ *Return    : void */
+static void voidCloseTiledMap(cellmap *map);
+
+/*this function reads a tile into least recently used cache slot , tile in that slot is written back
+ *first if it was changed , a tile that can not be read is filled with BORDER cells so explorer never
+ *enters it and first failure is kept in tile cache Error (see u8TiledMapError();)
+ *Arguments : pointer to map , tile number
+ *Return    : cache slot */
+static u32 u32PageInTile(const cellmap *map, u32 Tile);
+
+/*this function moves backing file position of a tiled map
+ *Arguments : pointer to tile cache , file offset
+ *Return    : ERROR_NONE or ERROR_READ_FILE */
+static u8 u8SeekTileFile(tilecache *Cache, u64 Offset);
+
+/*this function keeps first tile read or write failure of a tiled map
+ *Arguments : pointer to tile cache , error code
+ *Return    : void */
+static void voidSetTileError(tilecache *Cache, u8 Error);
+
+/*this function returns next number of a seeded random sequence (xorshift64*) so a seed always
+ *generates the same map on every platform
+ *Arguments : pointer to random state , never 0
+ *Return    : random number */
+static u32 u32NextRandom(u64 *State);
+
+/*this function records an output map cell change so it is written with the step it belongs to
+ *Arguments : pointer to explorer , cell index and cell status before the change
+ *Return    : void */
+static void voidTraceCellChange(explorer *Explorer, u32 Index, u8 OldStatus);
+
+/*this function writes changed cells of current step or whole output map depending on trace level
+ *Arguments : pointer to explorer
+ *Return    : void */
+static void voidTraceStep(explorer *Explorer);
+
+/*this function writes pending cell changes recorded by voidTraceCellChange(); that really changed
+ *Arguments : pointer to explorer
+ *Return    : void */
+static void voidTraceFlushDeltas(explorer *Explorer);
+
+#if MAP_FIXED_WIDTH != 0
+/*this function is the searching loop of u8WalkMap(); for MAP_FIXED_WIDTH x MAP_FIXED_HEIGHT maps searched
+ *without step trace , cell source , monitor , checkpoints or search counters , surrounding cell offsets are
+ *constants and a step does the work of voidUpdateOutputMap(); and voidTakeAction(); without calls except
+ *at dead ends so it takes the same moves
+ *Arguments : pointer to explorer with current cell set
+ *Return    : ERROR_NONE once dead end is reached or error that stopped the search */
+static u8 u8WalkFixedMap(explorer *Explorer);
+#endif
+
+/*this function contain the algorithm used for decision making based on surrounding cell status
+ *it decide which cell should be visited next from available cells found by voidUpdateOutputMap();
+ *Arguments : pointer to explorer
+ *Return    : void */
+static void voidTakeAction(explorer *Explorer);
+
+/*this function responsible for changing output map cell's status based on discovered input map cells
+ *it also saves last available cell coordinates in case the algorithm got stuck in a dead end rout
+ *it could reposition itself to a cell that has available routs
+ *ie cells that is surrounded by more than one NOT_MINE Cells
+ *
+ *Arguments : pointer to explorer
+ *Return    : void */
+static void voidUpdateOutputMap(explorer *Explorer);
+
+/*this function reads input map status of a surrounding cell of current cell from cell source of explorer ,
+ *cells already known from output map are not read again (INPUT_CELL() reads input map without cell source)
+ *Arguments : pointer to explorer with cell source , cell index
+ *Return    : input map status of cell */
+static u8 u8ReadInputCell(explorer *Explorer, u32 Index);
+
+/*this function probes NOT_DISCOVERED cells up to a number of moves from current cell in one cell source probe
+ *Arguments : pointer to explorer with cell source , number of moves (1 for surrounding cells)
+ *Return    : void */
+static void voidProbeCells(explorer *Explorer, u32 Moves);
+
+/*this function reposition current cell position to last available cell so that
+ *search algorithm can take new rout
+ *Arguments : pointer to explorer
+ *Return    : void */
+static void voidBackPropagate(explorer *Explorer);
+
+/*this function finds shortest route over VISITED cells from current cell to a target cell or to the nearest
+ *DISCOVERED_NOT_MINE cell (breadth first search , every move costs one cell)
+ *cell marks are kept between searches and a new search only starts a new mark generation
+ *so every search touches only cells it reaches instead of clearing a whole map
+ *search memory that can not be allocated is kept in explorer Error and no route is found
+ *Arguments : pointer to explorer , target cell index or 0 for nearest DISCOVERED_NOT_MINE cell , pointer that receives route length
+ *Return    : cell index route ends at or 0 if there is no route */
+static u32 u32FindRoute(explorer *Explorer, u32 Target, u32 *Length);
+
+/*this function starts new route search mark generations , marks are allocated by first call
+ *marks that can not be allocated are kept in explorer Error (ERROR_NO_MEMORY or ERROR_ARENA_FULL)
+ *Arguments : pointer to explorer , number of generations needed
+ *Return    : first new generation , generations up to first+number-1 are new , 0 if marks can not be allocated */
+static u32 u32NewRouteGenerations(explorer *Explorer, u32 Count);
+
+/*this function releases route search marks and queue
+ *Arguments : pointer to explorer
+ *Return    : void */
+static void voidFreeRoutes(explorer *Explorer);
+
+/*this function saves a branch point on top of branch stack , stack grows when it is full
+ *a branch point that can not be saved is also kept in explorer Error so the search stops
+ *Arguments : pointer to explorer , cell index of branch point
+ *Return    : ERROR_NONE , ERROR_NO_MEMORY or ERROR_ARENA_FULL (ARENA_BRANCH_POINTS branch points saved) */
+static u8 u8PushBranch(explorer *Explorer, u32 Index);
+
+/*this function removes last saved branch point from branch stack
+ *Arguments : pointer to explorer
+ *Return    : cell index of branch point */
+static u32 u32PopBranch(explorer *Explorer);
+
+/*this function changes status of an output map cell and keeps number of frontier
+ *(DISCOVERED_NOT_MINE) cells up to date , every output map status change goes through it
+ *Arguments : pointer to explorer , cell index , new status
+ *Return    : void */
+static void voidSetOutputStatus(explorer *Explorer, u32 Index, u8 Status);
+
+#if FRONTIER_CHECK == TRUE
+/*this function counts DISCOVERED_NOT_MINE cells by scanning whole output map
+ *it is only used to validate frontier counter in FRONTIER_CHECK mode
+ *Arguments : pointer to explorer
+ *Return    : number of DISCOVERED_NOT_MINE cells */
+static u32 u32ScanFrontierCells(explorer *Explorer);
+#endif
+
+/*this function reposition current cell position to a surrounding cell
+ *Arguments : pointer to explorer , move (MOVE_RIGHT , MOVE_UP , MOVE_LOW or MOVE_LEFT)
+ *Return    : void */
+static void voidGotoCell(explorer *Explorer, u8 Move);
+
+/*this function finds root of a union find set and halves path to it on the way
+ *Arguments : union find parent array , cell index
+ *Return    : cell index of root */
+static u32 u32FindRoot(u32 *Parent, u32 Index);
+
+#if (MAP_PACKED == FALSE) && (MAP_TILED == FALSE) && !defined(_WIN32)
+/*this function is run by every parallel explorer , it explores cells of its own deque and
+ *steals cells from other explorers when its deque is empty until no claimed cell is left
+ *Arguments : pointer to worker
+ *Return    : NULL */
+static void *pvExploreWorker(void *Argument);
+
+/*this function explores a claimed cell , its mine neighbors are copied to shared output map
+ *and its NOT_MINE neighbors that are still NOT_DISCOVERED are claimed and pushed to worker deque
+ *Arguments : pointer to worker , cell index
+ *Return    : void */
+static void voidExploreCell(worker *Worker, u32 Index);
+
+/*this function pushes a cell on bottom of worker own deque , deque grows when it is full
+ *Arguments : pointer to worker , cell index
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY if deque can not grow (cell is not pushed) */
+static u8 u8PushWork(worker *Worker, u32 Index);
+
+/*this function takes last pushed cell from bottom of worker own deque
+ *Arguments : pointer to worker
+ *Return    : cell index or 0 if deque is empty */
+static u32 u32TakeWork(worker *Worker);
+
+/*this function steals oldest cell from top of another worker deque
+ *Arguments : pointer to stealing worker
+ *Return    : cell index or 0 if no cell could be stolen */
+static u32 u32StealWork(worker *Thief);
+#endif
+
+/*this function finds distance field of a destination in field cache or builds it by a breadth first
+ *search over destination component , least recently used field is replaced
+ *Arguments : pointer to path index , destination cell index (a safe cell)
+ *Return    : distance of every cell to destination , NULL if there is no memory for it */
+static u32 *pu32GetDistanceField(pathindex *Index, u32 Target);
+
+/*this function builds row bits of a map , passable cells are the ones an explorer can enter
+ *(NOT_MINE of input maps , VISITED DISCOVERED_NOT_MINE and CURRENT_LOCATION of output maps)
+ *Arguments : pointer to row bits , pointer to map
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY */
+static u8 u8CreateRowBits(rowbits *Bits, cellmap *map);
+
+/*this function releases row bits
+ *Arguments : pointer to row bits
+ *Return    : void */
+static void voidFreeRowBits(rowbits *Bits);
+
+/*this function finds every passable cell reachable from a start cell , rows are swept down and up
+ *until a whole down and up sweep reaches no new cell
+ *Arguments : pointer to row bits , start cell row and column in map coordinates (1 is first inner row/column)
+ *Return    : number of down and up sweeps , 0 if start cell is not passable */
+static u32 u32FloodRowBits(rowbits *Bits, u32 Row, u32 Col);
+
+/*this function spreads reached cells of one row from its neighbor row and along its runs of passable cells
+ *Arguments : pointer to row bits , reached and passable words of the row , reached words of neighbor row
+ *Return    : TRUE if row reached a new cell */
+static u8 u8FloodRow(const rowbits *Bits, u64 *Reached, const u64 *Passable, const u64 *Neighbor);
+
+/*this function spreads reached bits of a word along runs of passable bits in both directions
+ *Arguments : reached bits (all of them passable) , passable bits
+ *Return    : reached bits */
+static u64 u64FillWord(u64 Reached, u64 Passable);
+
+/*this function counts set bits of a row bits plane
+ *Arguments : pointer to row bits , plane (Passable or Reached)
+ *Return    : number of set bits */
+static u64 u64CountRowBits(const rowbits *Bits, const u64 *Plane);
+
+/*this function finds VISITED cells cut off from entry point by a new mine and makes them NOT_DISCOVERED
+ *a breadth first search starts on every VISITED surrounding cell of mine cell and searches take one cell
+ *in turn , searches that reach cells of each other are joined (union find of at most 4 searches)
+ *a finished search holds a whole part of VISITED cells so searching stops when only the part of entry
+ *point is unfinished , work is bounded by size of cut off parts instead of size of map
+ *discovered cells next to mine cell and cut off cells stay discovered only if a VISITED cell is still next to them
+ *search memory that can not be allocated is kept in explorer Error and no cell is cut off
+ *Arguments : pointer to explorer , index of mine cell that was VISITED
+ *Return    : number of cut off cells */
+static u32 u32CutOffCells(explorer *Explorer, u32 Mine);
+
+/*this function makes discovered surrounding cells of a cell that is not VISITED any more NOT_DISCOVERED
+ *again when no VISITED cell is next to them
+ *Arguments : pointer to explorer , cell index
+ *Return    : void */
+static void voidUndiscoverNeighbors(explorer *Explorer, u32 Index);
+
+/*this function checks if any surrounding cell of an output map cell is VISITED
+ *Arguments : pointer to explorer , cell index
+ *Return    : TRUE if a surrounding cell is VISITED , FALSE otherwise */
+static u8 u8HasVisitedNeighbor(explorer *Explorer, u32 Index);
+
+/*this function appends a cell index to a cell list , list grows by doubling its capacity
+ *Arguments : pointer to list entries , pointers to its number of entries and capacity , cell index
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY (cell is not appended) */
+static u8 u8AppendCell(u32 **Cells, u32 *Size, u32 *Capacity, u32 Index);
+
+/*this function lets input map cells be changed , a memory mapped map file is mapped read only
+ *so its pages are made writable , mapping is private and map file itself is never changed
+ *Arguments : pointer to input map
+ *Return    : ERROR_NONE or ERROR_READ_FILE if pages can not be made writable */
+static u8 u8UnlockInputMap(cellmap *map);
+
+/*this function stamps every band of a live monitor , it is used around writes that are not done by a search step
+ *Arguments : pointer to monitor , stamp (MONITOR_CHANGING while writes are done)
+ *Return    : void */
+static void voidStampAllBands(monitor *Monitor, u32 Step);
+
+/*this function starts copying a checkpoint image if one is due , copies next slice of image while one is
+ *copied and hands a complete image to writer thread , it is called by u8StepSearch(); at end of a step
+ *Arguments : pointer to explorer with checkpoints
+ *Return    : void */
+static void voidWriteCheckpoint(explorer *Explorer);
+
+/*this function copies bit planes of one output map band to checkpoint image
+ *Arguments : pointer to explorer with checkpoints , band number
+ *Return    : void */
+static void voidCopyCheckpointBand(explorer *Explorer, u32 Band);
+
+/*this function marks a band that was copied to checkpoint image to be copied again
+ *Arguments : pointer to checkpoint state , band number
+ *Return    : void */
+static void voidMarkCheckpointBand(checkpoint *Checkpoint, u32 Band);
+
+/*this function copies branch points pushed since they were copied to checkpoint image , a slice at most
+ *Arguments : pointer to explorer with checkpoints
+ *Return    : TRUE if branch points were copied , FALSE if there is no memory for them */
+static u8 u8CopyCheckpointBranches(explorer *Explorer);
+
+/*this function writes checkpoint header of an explorer to its checkpoint image
+ *Arguments : pointer to explorer with checkpoints
+ *Return    : void */
+static void voidCopyCheckpointHeader(explorer *Explorer);
+
+/*this function drops checkpoint image copied so far so next copy starts from first band
+ *Arguments : pointer to checkpoint state
+ *Return    : void */
+static void voidDropCheckpointCopy(checkpoint *Checkpoint);
+
+/*this function writes checkpoint image to temporary file and renames it to checkpoint file
+ *Arguments : pointer to checkpoint state with an image
+ *Return    : TRUE if checkpoint was written , FALSE otherwise */
+static u8 u8SaveCheckpoint(checkpoint *Checkpoint);
+
+#if !defined(_WIN32)
+/*this function is checkpoint writer thread , it writes every pending image until it is stopped
+ *Arguments : pointer to checkpoint state
+ *Return    : NULL */
+static void *pvCheckpointWriter(void *Argument);
+#endif
+
+/*this function starts sensor reads of cells , cells of one tile share a read and cells already probed are skipped
+ *Arguments : pointer to cell source of a sensor , array of cell indices and its number of entries
+ *Return    : void */
+static void voidProbeSensor(cellsource *Source, const u32 *Cells, u32 Count);
+
+/*this function waits until status of a probed cell is read by sensor , a cell that was not probed is probed first
+ *Arguments : pointer to cell source of a sensor , cell index
+ *Return    : input map status of cell */
+static u8 u8ReadSensor(cellsource *Source, u32 Cell);
+
+/*this function finds pending entry of a probed cell
+ *Arguments : pointer to sensor , cell index
+ *Return    : entry index or SENSOR_MAX_PENDING if cell is not pending */
+static u32 u32FindPendingCell(const sensor *Sensor, u32 Cell);
+
+/*this function moves one output map cell change into block summary , level 0 block holding the cell and
+ *whole map counts are only changed if cell class changes and block is marked to be folded into finished
+ *block counts and levels above
+ *Arguments : pointer to block summary , cell index , old and new cell status
+ *Return    : void */
+static void voidUpdateSummary(blocksummary *Summary, u32 Index, u8 OldStatus, u8 NewStatus);
+
+/*this function folds level 0 blocks changed since last fold into blocks of levels above them
+ *Arguments : pointer to block summary
+ *Return    : void */
+static void voidFoldSummary(blocksummary *Summary);
+
+/*this function searches one summary block and blocks below it for a frontier cell nearer than best one found
+ *Arguments : pointer to block summary , pointer to output map , level , block row and column ,
+ *            row and column of cell distance is measured from , pointers to best distance and best cell
+ *Return    : void */
+static void voidSearchFrontierBlock(const blocksummary *Summary, const cellmap *map, u8 Level, u32 BlockRow, u32 BlockCol,
+                                    u32 Row, u32 Col, u32 *BestDistance, u32 *BestCell);
+
+/*this function finds distance (rows plus columns) from a cell to nearest cell of a summary block
+ *Arguments : pointer to block summary , level , block row and column , row and column of cell
+ *Return    : distance , 0 if cell is in block */
+static u32 u32BlockDistance(const blocksummary *Summary, u8 Level, u32 BlockRow, u32 BlockCol, u32 Row, u32 Col);
+
+
+
+/*==================================================================================*/
+/*==================================================================================*/
+/*Global variable*/
+/*=========================================*/
+
+/*Maps*/
+/*=========================*/
+/*Cell status of each packed code , code 3 is not used*/
+static const u8 CodeToStatus[8] = {MINE, NOT_MINE, BORDER, MINE,
+                                   NOT_DISCOVERED, VISITED, DISCOVERED_NOT_MINE, CURRENT_LOCATION};
+/*Packed code of each cell status , statuses not listed get code 0 (CODE_MINE)*/
+static const u8 StatusToCode[256] = {[NOT_MINE]            = CODE_NOT_MINE,
+                                     [BORDER]              = CODE_BORDER,
+                                     [NOT_DISCOVERED]      = CODE_NOT_DISCOVERED,
+                                     [VISITED]             = CODE_VISITED,
+                                     [DISCOVERED_NOT_MINE] = CODE_DISCOVERED_NOT_MINE,
+                                     [CURRENT_LOCATION]    = CODE_CURRENT_LOCATION};
+/*=========================*/
+
+/*Search*/
+/*=========================*/
+/*Surrounding cells in the order voidUpdateOutputMap(); reads them , right , left , up , low*/
+static const u8 UpdateOrder[4] = {MOVE_RIGHT, MOVE_LEFT, MOVE_UP, MOVE_LOW};
+/*Next move for every mask of available surrounding cells (bit d set if cell of move d is available)
+ *first available cell in right , up , low , left order , MOVE_NONE if no cell is available*/
+static const u8 NextMove[16] = {MOVE_NONE, MOVE_RIGHT, MOVE_UP, MOVE_RIGHT, MOVE_LOW, MOVE_RIGHT, MOVE_UP, MOVE_RIGHT,
+                                MOVE_LEFT, MOVE_RIGHT, MOVE_UP, MOVE_RIGHT, MOVE_LOW, MOVE_RIGHT, MOVE_UP, MOVE_RIGHT};
+/*Number of available surrounding cells for every mask*/
+static const u8 AvailableCount[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+/*Block summary class of every cell status plus one , 0 for statuses that are not counted*/
+static const u8 SummaryClass[256] = {[NOT_DISCOVERED]      = SUMMARY_UNKNOWN + 1,
+                                     [DISCOVERED_NOT_MINE] = SUMMARY_FRONTIER + 1,
+                                     [VISITED]             = SUMMARY_VISITED + 1,
+                                     [CURRENT_LOCATION]    = SUMMARY_VISITED + 1};
+/*=========================*/
+
+/*==================================================================================*/
+/*==================================================================================*/
+/*Function Implementations*/
+
+/*this function allocates cells of a Height x Width map (plus borders) in one cache aligned block
+ *Arguments : pointer to map to be created , number of columns and number of rows without borders ,
+ *            arena map is taken from (MAP_ARENA , not used by other builds)
+ *Return    : ERROR_NONE , ERROR_MAP_SIZE if map size is not supported , ERROR_NO_MEMORY , ERROR_ARENA_FULL
+ *            or ERROR_OPEN_FILE (tile file of MAP_TILED) if map can not be allocated */
+u8 u8CreateMap(cellmap *map, u32 Width, u32 Height, arena *Arena)
+{
+    /*Number of cells including borders , every cell must be reachable by a u32 index*/
+    u64 NumberOfCells = ((u64)Width + 2) * ((u64)Height + 2);
+    /*Allocation size rounded up to a whole number of cache lines as aligned_alloc() requires*/
+    u64 Size;
+
+    if( FALSE == u8IsMapSizeSupported(Width, Height) )
+    {
+        return ERROR_MAP_SIZE;
+    }
+#if MAP_ARENA == TRUE
+    if( (Width > ARENA_MAX_WIDTH) || (Height > ARENA_MAX_HEIGHT) )
+    {
+        return ERROR_MAP_SIZE;
+    }
+#endif
+
+    Size = (NumberOfCells + CACHE_LINE_SIZE - 1) & ~(u64)(CACHE_LINE_SIZE - 1);
+
+    map->Width   = Width;
+    map->Height  = Height;
+    map->Stride  = Width + 2;
+    map->Status  = NULL;
+    map->Storage = MAP_STORAGE_HEAP;
+    map->Bits    = NULL;
+    map->Words   = 0;
+    map->Planes  = 0;
+    map->Tiles   = NULL;
+
+#if MAP_PACKED == TRUE
+    (void)Size;
+    return u8CreatePackedMap(map, OUTPUT_MAP_PLANES, Arena);
+#elif MAP_TILED == TRUE
+    (void)Size;
+    (void)Arena;
+    /*tiles are stored in a temporary file that is removed when it is closed*/
+    FILE *File = tmpfile();
+    if( NULL == File )
+    {
+        return ERROR_OPEN_FILE;
+    }
+    return u8OpenTiledMap(map, File, 0, TILE_LAYOUT_TILES);
+#elif MAP_ARENA == TRUE
+    map->Status  = (u8 *)pvArenaAllocate(Arena, Size);
+    if( NULL == map->Status )
+    {
+        return ERROR_ARENA_FULL;
+    }
+    map->Storage = MAP_STORAGE_ARENA;
+#else
+    (void)Arena;
+    map->Status  = (u8 *)aligned_alloc(CACHE_LINE_SIZE, (size_t)Size);
+    if( NULL == map->Status )
+    {
+        return ERROR_NO_MEMORY;
+    }
+#endif
+
+    return ERROR_NONE;
+
+}/*end of u8CreateMap()*/
+
+/*this function checks that a map size can be searched , both sides are not 0 , Stride (Width+2) fits in u32
+ *and every cell including borders is reachable by a u32 index
+ *Arguments : number of columns and number of rows without borders
+ *Return    : TRUE if map size is supported , FALSE otherwise */
+static u8 u8IsMapSizeSupported(u32 Width, u32 Height)
+{
+    /*sides are checked first so number of cells can not overflow u64*/
+    if( (0 == Width) || (0 == Height) || (Width > MAP_MAX_SIDE) || (Height > MAP_MAX_SIDE) )
+    {
+        return FALSE;
+    }
+    return ((((u64)Width + 2) * ((u64)Height + 2)) <= 0xFFFFFFFFULL) ? TRUE : FALSE;
+
+}/*end of u8IsMapSizeSupported()*/
+
+/*this function releases cells of a map whatever its storage is
+ *Arguments : pointer to map
+ *Return    : void */
+void voidFreeMap(cellmap *map)
+{
+    if( NULL != map->Status )
+    {
+        voidReleaseStatus(map->Status, (u64)map->Stride * (u64)(map->Height+2), map->Storage);
+    }
+    if( NULL != map->Tiles )
+    {
+        voidCloseTiledMap(map);
+    }
+#if MAP_ARENA == FALSE
+    free(map->Bits);
+#endif
+    map->Status = NULL;
+    map->Bits   = NULL;
+
+}/*end of voidFreeMap()*/
+
+/*this function releases a one byte per cell status array
+ *Arguments : status array , number of cells , storage of the array (MAP_STORAGE_xxx)
+ *Return    : void */
+static void voidReleaseStatus(u8 *Status, u64 NumberOfCells, u8 Storage)
+{
+    if( MAP_STORAGE_HEAP == Storage )
+    {
+        free(Status);
+    }
+    else if( MAP_STORAGE_MAPPED == Storage )
+    {
+        /*status array starts right after map file header*/
+#if defined(_WIN32)
+        (void)NumberOfCells;
+        free(Status - MAP_FILE_HEADER_SIZE);
+#else
+        munmap(Status - MAP_FILE_HEADER_SIZE, (size_t)(MAP_FILE_HEADER_SIZE + NumberOfCells));
+#endif
+    }
+
+}/*end of voidReleaseStatus()*/
+
+/*this function is responsible for initializing a map with its initial status value for each cell
+ *borders get BORDER status and all other cells get NOT_DISCOVERED status
+ *Arguments : pointer to map created by u8CreateMap();
+ *Return    : void */
+void voidInitializeMap(cellmap *map)
+{
+#if MAP_PACKED == TRUE
+    /*NOT_DISCOVERED code only has its bit in third plane , fill whole planes then set borders*/
+    memset(map->Bits, 0, (size_t)map->Words * 2 * sizeof(u64));
+    memset(&map->Bits[2*map->Words], 0xFF, (size_t)map->Words * sizeof(u64));
+    /*bits after last cell stay cleared*/
+    for(u64 Index = (u64)map->Stride * (u64)(map->Height+2); Index < ((u64)map->Words * 64); Index++)
+    {
+        map->Bits[(u64)2*map->Words + (Index >> 6)] &= ~((u64)1 << (Index & 63));
+    }
+    for(u32 j = 0; j < map->Stride; j++)
+    {
+        MAP_SET(map, j, BORDER);
+        MAP_SET(map, (map->Height+1)*map->Stride + j, BORDER);
+    }
+    for(u32 i = 1 ; i<(map->Height+1) ; i++)
+    {
+        MAP_SET(map, i*map->Stride, BORDER);
+        MAP_SET(map, i*map->Stride + map->Width+1, BORDER);
+    }
+#elif MAP_TILED == TRUE
+    /*drop all tiles , each tile is built with its initial status when it is first read*/
+    tilecache *Cache = map->Tiles;
+    memset(Cache->TileStored, FALSE, Cache->Tiles);
+    for(u32 Tile = 0; Tile < Cache->Tiles; Tile++)
+    {
+        Cache->TileSlot[Tile] = TILE_NONE;
+    }
+    for(u32 Slot = 0; Slot < TILE_CACHE_SLOTS; Slot++)
+    {
+        Cache->SlotTile[Slot]    = TILE_NONE;
+        Cache->SlotLastUse[Slot] = 0;
+        Cache->SlotDirty[Slot]   = FALSE;
+    }
+    Cache->LastTile = TILE_NONE;
+    Cache->LastSlot = TILE_NONE;
+#else
+    /*first and last rows are border cells*/
+    memset(&map->Status[0], BORDER, map->Stride);
+    memset(&map->Status[(map->Height+1)*map->Stride], BORDER, map->Stride);
+
+    /*loop rows in between*/
+    for(u32 i = 1 ; i<(map->Height+1) ; i++)
+    {
+        /*first and last cells of a row are border cells , others are NOT_DISCOVERED*/
+        map->Status[i*map->Stride] = BORDER;
+        memset(&map->Status[i*map->Stride + 1], NOT_DISCOVERED, map->Width);
+        map->Status[i*map->Stride + map->Width+1] = BORDER;
+
+    }/*end of i for*/
+#endif
+
+}/*end of voidInitializeMap()*/
+
+/*this function creates an Input map from a u8 array of cell status like cells[][]
+ *the array becomes the map status without any copy , with MAP_PACKED it is packed into
+ *bit planes and released , with MAP_TILED it is written to a temporary backing file and released
+ *if map can not be created array is not released and stays owned by caller
+ *Arguments : pointer to map , status array of (Height+2) x (Width+2) elements including borders ,
+ *            number of columns and rows without borders , storage of the array (MAP_STORAGE_xxx) ,
+ *            arena bit planes are taken from (MAP_ARENA with MAP_PACKED , not used by other builds)
+ *Return    : ERROR_NONE , ERROR_NO_MEMORY , ERROR_ARENA_FULL , ERROR_MAP_SIZE , ERROR_OPEN_FILE or ERROR_WRITE_FILE */
+u8 u8CreateInputMap(cellmap *map, u8 *Source, u32 Width, u32 Height, u8 Storage, arena *Arena)
+{
+    u8 Error = ERROR_NONE;
+
+    map->Width   = Width;
+    map->Height  = Height;
+    map->Stride  = Width + 2;
+    map->Status  = Source;
+    map->Storage = Storage;
+    map->Bits    = NULL;
+    map->Words   = 0;
+    map->Planes  = 0;
+    map->Tiles   = NULL;
+
+#if MAP_PACKED == TRUE
+    map->Status  = NULL;
+    Error = u8CreatePackedMap(map, INPUT_MAP_PLANES, Arena);
+    if( ERROR_NONE != Error )
+    {
+        return Error;
+    }
+    voidPackMap(map, Source);
+    voidReleaseStatus(Source, (u64)map->Stride * (u64)(Height+2), Storage);
+#elif MAP_TILED == TRUE
+    (void)Arena;
+    map->Status  = NULL;
+    FILE *File = tmpfile();
+    if( NULL == File )
+    {
+        return ERROR_OPEN_FILE;
+    }
+    if( 1 != fwrite(Source, (size_t)map->Stride * (size_t)(Height+2), 1, File) )
+    {
+        fclose(File);
+        return ERROR_WRITE_FILE;
+    }
+    Error = u8OpenTiledMap(map, File, 0, TILE_LAYOUT_ROWS);
+    if( ERROR_NONE != Error )
+    {
+        return Error;
+    }
+    voidReleaseStatus(Source, (u64)map->Stride * (u64)(Height+2), Storage);
+#else
+    (void)Arena;
+#endif
+
+    return Error;
+
+}/*end of u8CreateInputMap();*/
+
+/*this function checks if a file starts with map file magic "GPSM"
+ *Arguments : file name
+ *Return    : TRUE if file is a map file , FALSE otherwise (also if it can not be opened) */
+u8 u8IsMapFile(const char *FileName)
+{
+    FILE *File = fopen(FileName, "rb");
+    char Magic[4] = {0};
+
+    if( NULL == File )
+    {
+        return FALSE;
+    }
+    if( 4 != fread(Magic, 1, 4, File) )
+    {
+        Magic[0] = 0;
+    }
+    fclose(File);
+
+    return (0 == memcmp(Magic, MAP_FILE_MAGIC, 4)) ? TRUE : FALSE;
+
+}/*end of u8IsMapFile()*/
+
+/*this function reads a little endian u32 number
+ *Arguments : pointer to first byte
+ *Return    : number */
+u32 u32ReadLittleEndian(const u8 *Bytes)
+{
+    return (u32)Bytes[0] | ((u32)Bytes[1] << 8) | ((u32)Bytes[2] << 16) | ((u32)Bytes[3] << 24);
+
+}/*end of u32ReadLittleEndian()*/
+
+/*this function writes a u32 number as little endian bytes
+ *Arguments : pointer to first byte , number
+ *Return    : void */
+static void voidWriteLittleEndian(u8 *Bytes, u32 Value)
+{
+    for(u8 i = 0; i < 4; i++)
+    {
+        Bytes[i] = (u8)(Value >> (8*i));
+    }
+
+}/*end of voidWriteLittleEndian()*/
+
+/*this function creates an Input map by memory mapping a map file , map status is read
+ *straight from the mapping , with MAP_TILED map file becomes backing file of the map and its tiles
+ *are read when needed (borders are then checked as tiles are read , see u8TiledMapError();)
+ *Arguments : pointer to map , map file name , arena bit planes are taken from (MAP_ARENA with MAP_PACKED)
+ *Return    : ERROR_NONE , ERROR_OPEN_FILE , ERROR_READ_FILE , ERROR_BAD_FILE if file is not a valid map file
+ *            (bad header , size or borders) or an error of u8CreateInputMap(); */
+u8 u8LoadMapFile(cellmap *map, const char *FileName, arena *Arena)
+{
+#if MAP_TILED == TRUE
+    u8   Header[MAP_FILE_HEADER_SIZE];
+    u64  FileSize;
+    u32  Width, Height;
+    FILE *File = fopen(FileName, "rb");
+    int  Result;
+
+    (void)Arena;
+    if( NULL == File )
+    {
+        return ERROR_OPEN_FILE;
+    }
+    if( 1 != fread(Header, MAP_FILE_HEADER_SIZE, 1, File) )
+    {
+        fclose(File);
+        return ERROR_BAD_FILE;
+    }
+#if defined(_WIN32)
+    Result   = _fseeki64(File, 0, SEEK_END);
+    FileSize = (u64)_ftelli64(File);
+#else
+    Result   = fseeko(File, 0, SEEK_END);
+    FileSize = (u64)ftello(File);
+#endif
+    if( 0 != Result )
+    {
+        fclose(File);
+        return ERROR_READ_FILE;
+    }
+
+    /*Check header and file size , borders are checked as their tiles are read*/
+    /*=============================================*/
+    Width  = u32ReadLittleEndian(&Header[4]);
+    Height = u32ReadLittleEndian(&Header[8]);
+    if( (0 != memcmp(Header, MAP_FILE_MAGIC, 4)) || (FALSE == u8IsMapSizeSupported(Width, Height)) ||
+        (FileSize != (MAP_FILE_HEADER_SIZE + ((u64)Width + 2) * ((u64)Height + 2))) )
+    {
+        fclose(File);
+        return ERROR_BAD_FILE;
+    }
+
+    map->Width   = Width;
+    map->Height  = Height;
+    map->Stride  = Width + 2;
+    map->Status  = NULL;
+    map->Storage = MAP_STORAGE_HEAP;
+    map->Bits    = NULL;
+    map->Words   = 0;
+    map->Planes  = 0;
+    return u8OpenTiledMap(map, File, MAP_FILE_HEADER_SIZE, TILE_LAYOUT_ROWS);
+#else
+    u8  *Mapping;
+    u8  *Source;
+    u64 FileSize;
+    u32 Width, Height, Stride;
+    u64 NumberOfCells;
+    u8  Error = ERROR_NONE;
+
+#if defined(_WIN32)
+    /*no mmap() , read whole file instead*/
+    FILE *File = fopen(FileName, "rb");
+    if( NULL == File )
+    {
+        return ERROR_OPEN_FILE;
+    }
+    fseek(File, 0, SEEK_END);
+    FileSize = (u64)ftell(File);
+    rewind(File);
+    Mapping = (u8 *)malloc((size_t)FileSize + 1);
+    if( NULL == Mapping )
+    {
+        fclose(File);
+        return ERROR_NO_MEMORY;
+    }
+    if( FileSize != fread(Mapping, 1, (size_t)FileSize, File) )
+    {
+        fclose(File);
+        free(Mapping);
+        return ERROR_READ_FILE;
+    }
+    fclose(File);
+    if( FileSize < MAP_FILE_HEADER_SIZE )
+    {
+        free(Mapping);
+        return ERROR_BAD_FILE;
+    }
+#else
+    struct stat FileStatus;
+    int File = open(FileName, O_RDONLY);
+    if( File < 0 )
+    {
+        return ERROR_OPEN_FILE;
+    }
+    if( 0 != fstat(File, &FileStatus) )
+    {
+        close(File);
+        return ERROR_READ_FILE;
+    }
+    FileSize = (u64)FileStatus.st_size;
+    if( FileSize < MAP_FILE_HEADER_SIZE )
+    {
+        close(File);
+        return ERROR_BAD_FILE;
+    }
+    Mapping = (u8 *)mmap(NULL, (size_t)FileSize, PROT_READ, MAP_PRIVATE, File, 0);
+    /*mapping stays valid after file is closed*/
+    close(File);
+    if( MAP_FAILED == (void *)Mapping )
+    {
+        return ERROR_READ_FILE;
+    }
+#endif
+
+    /*Check header and file size*/
+    /*=============================================*/
+    Width  = u32ReadLittleEndian(&Mapping[4]);
+    Height = u32ReadLittleEndian(&Mapping[8]);
+    NumberOfCells = ((u64)Width + 2) * ((u64)Height + 2);
+    if( (0 != memcmp(Mapping, MAP_FILE_MAGIC, 4)) || (FALSE == u8IsMapSizeSupported(Width, Height)) ||
+        (FileSize != (MAP_FILE_HEADER_SIZE + NumberOfCells)) )
+    {
+        Error = ERROR_BAD_FILE;
+    }
+
+    /*Explorer relies on border cells around the map so only borders are checked ,
+     *inner cells are paged in on demand while searching*/
+    /*=============================================*/
+    Source = &Mapping[MAP_FILE_HEADER_SIZE];
+    Stride = Width + 2;
+    for(u32 j = 0; (ERROR_NONE == Error) && (j < Stride); j++)
+    {
+        if( (BORDER != Source[j]) || (BORDER != Source[(u64)(Height+1)*Stride + j]) )
+        {
+            Error = ERROR_BAD_FILE;
+        }
+    }
+    for(u32 i = 1; (ERROR_NONE == Error) && (i < (Height+1)); i++)
+    {
+        if( (BORDER != Source[(u64)i*Stride]) || (BORDER != Source[(u64)i*Stride + Width+1]) )
+        {
+            Error = ERROR_BAD_FILE;
+        }
+    }
+
+    if( ERROR_NONE == Error )
+    {
+        Error = u8CreateInputMap(map, Source, Width, Height, MAP_STORAGE_MAPPED, Arena);
+    }
+    if( ERROR_NONE != Error )
+    {
+        /*mapping is released as a whole , header included*/
+        voidReleaseStatus(Source, FileSize - MAP_FILE_HEADER_SIZE, MAP_STORAGE_MAPPED);
+    }
+    return Error;
+#endif
+
+}/*end of u8LoadMapFile()*/
+
+/*this function writes a map to a map file
+ *Arguments : pointer to map , map file name
+ *Return    : ERROR_NONE , ERROR_OPEN_FILE , ERROR_WRITE_FILE or ERROR_NO_MEMORY */
+u8 u8SaveMapFile(cellmap *map, const char *FileName)
+{
+    FILE *File = fopen(FileName, "wb");
+    u8   Header[MAP_FILE_HEADER_SIZE] = {0};
+    u8   Error = ERROR_NONE;
+
+    if( NULL == File )
+    {
+        return ERROR_OPEN_FILE;
+    }
+
+    memcpy(Header, MAP_FILE_MAGIC, 4);
+    for(u8 i = 0; i < 4; i++)
+    {
+        Header[4+i] = (u8)(map->Width  >> (8*i));
+        Header[8+i] = (u8)(map->Height >> (8*i));
+    }
+
+    if( 1 != fwrite(Header, MAP_FILE_HEADER_SIZE, 1, File) )
+    {
+        Error = ERROR_WRITE_FILE;
+    }
+
+#if (MAP_PACKED == TRUE) || (MAP_TILED == TRUE)
+    /*build one row at a time*/
+    u8 *Row = (u8 *)malloc(map->Stride);
+    if( (NULL == Row) && (ERROR_NONE == Error) )
+    {
+        Error = ERROR_NO_MEMORY;
+    }
+    for(u32 i = 0; (ERROR_NONE == Error) && (i < (map->Height+2)); i++)
+    {
+        for(u32 j = 0; j < map->Stride; j++)
+        {
+            Row[j] = MAP_CELL(map,i,j);
+        }
+        if( 1 != fwrite(Row, map->Stride, 1, File) )
+        {
+            Error = ERROR_WRITE_FILE;
+        }
+    }
+    free(Row);
+#if MAP_TILED == TRUE
+    if( ERROR_NONE == Error )
+    {
+        Error = u8TiledMapError(map);
+    }
+#endif
+#else
+    if( (ERROR_NONE == Error) &&
+        (1 != fwrite(map->Status, (size_t)map->Stride * (size_t)(map->Height+2), 1, File)) )
+    {
+        Error = ERROR_WRITE_FILE;
+    }
+#endif
+
+    if( (0 != fclose(File)) && (ERROR_NONE == Error) )
+    {
+        Error = ERROR_WRITE_FILE;
+    }
+    return Error;
+
+}/*end of u8SaveMapFile()*/
+
+/*this function checks if a file starts with map archive magic "GPSR"
+ *Arguments : file name
+ *Return    : TRUE if file is a map archive , FALSE otherwise (also if it can not be opened) */
+u8 u8IsMapArchive(const char *FileName)
+{
+    FILE *File = fopen(FileName, "rb");
+    char Magic[4] = {0};
+
+    if( NULL == File )
+    {
+        return FALSE;
+    }
+    if( 4 != fread(Magic, 1, 4, File) )
+    {
+        Magic[0] = 0;
+    }
+    fclose(File);
+
+    return (0 == memcmp(Magic, MAP_ARCHIVE_MAGIC, 4)) ? TRUE : FALSE;
+
+}/*end of u8IsMapArchive()*/
+
+/*this function writes a map (input or output map) to a map archive , cells are read one band at a time
+ *Arguments : pointer to map , map archive file name , pointer that receives archive size in bytes
+ *Return    : ERROR_NONE , ERROR_OPEN_FILE , ERROR_WRITE_FILE or ERROR_NO_MEMORY */
+u8 u8SaveMapArchive(cellmap *map, const char *FileName, u64 *Size)
+{
+    FILE *File;
+    u8   Header[MAP_FILE_HEADER_SIZE] = {0};
+    u32  Rows  = map->Height + 2;
+    u32  Bands = (Rows + ARCHIVE_BAND_ROWS - 1) / ARCHIVE_BAND_ROWS;
+    u64  IndexSize = (u64)(Bands + 1) * ARCHIVE_INDEX_ENTRY_SIZE;
+    u64  Offset = MAP_FILE_HEADER_SIZE + IndexSize;
+    u8   Error  = ERROR_NONE;
+    /*a run never takes more bytes than it has cells so one band never needs more bytes than its cells*/
+    u8   *Data  = (u8 *)malloc((size_t)ARCHIVE_BAND_ROWS * map->Stride);
+    u8   *Index = (u8 *)calloc((size_t)IndexSize, 1);
+#if (MAP_PACKED == TRUE) || (MAP_TILED == TRUE)
+    /*cells of one row are gathered before they are encoded*/
+    u8   *Row   = (u8 *)malloc(map->Stride);
+#else
+    u8   *Row   = Data;
+#endif
+
+    if( (NULL == Data) || (NULL == Index) || (NULL == Row) )
+    {
+        free(Data);
+        free(Index);
+#if (MAP_PACKED == TRUE) || (MAP_TILED == TRUE)
+        free(Row);
+#endif
+        return ERROR_NO_MEMORY;
+    }
+    File = fopen(FileName, "wb");
+    if( NULL == File )
+    {
+        Error = ERROR_OPEN_FILE;
+    }
+
+    /*header and index are written again once band offsets are known*/
+    else if( (1 != fwrite(Header, MAP_FILE_HEADER_SIZE, 1, File)) || (1 != fwrite(Index, (size_t)IndexSize, 1, File)) )
+    {
+        Error = ERROR_WRITE_FILE;
+    }
+
+    for(u32 Band = 0; (ERROR_NONE == Error) && (Band < Bands); Band++)
+    {
+        u32 LastRow    = ((Band + 1) * (u64)ARCHIVE_BAND_ROWS < Rows) ? ((Band + 1) * ARCHIVE_BAND_ROWS) : Rows;
+        u8  *Out       = Data;
+        u8  RunStatus  = 0;
+        u32 RunLength  = 0;
+
+        voidWriteLittleEndian(&Index[Band * ARCHIVE_INDEX_ENTRY_SIZE], (u32)Offset);
+        voidWriteLittleEndian(&Index[Band * ARCHIVE_INDEX_ENTRY_SIZE + 4], (u32)(Offset >> 32));
+
+        /*runs go on from one row to the next inside a band*/
+        for(u32 i = Band * ARCHIVE_BAND_ROWS; i < LastRow; i++)
+        {
+#if (MAP_PACKED == TRUE) || (MAP_TILED == TRUE)
+            const u8 *Cells = Row;
+            for(u32 j = 0; j < map->Stride; j++)
+            {
+                Row[j] = MAP_CELL(map,i,j);
+            }
+#else
+            const u8 *Cells = &map->Status[(u64)i * map->Stride];
+#endif
+            u32 j = 0;
+
+            while( j < map->Stride )
+            {
+                if( (0 != RunLength) && (Cells[j] == RunStatus) )
+                {
+                    /*cells of current run*/
+                    while( (j < map->Stride) && (Cells[j] == RunStatus) )
+                    {
+                        RunLength++;
+                        j++;
+                    }
+                }
+                else
+                {
+                    if( 0 != RunLength )
+                    {
+                        Out += u32EncodeRun(Out, RunStatus, RunLength);
+                    }
+                    RunStatus = Cells[j];
+                    RunLength = 1;
+                    j++;
+                }
+            }
+        }
+        Out += u32EncodeRun(Out, RunStatus, RunLength);
+
+        if( 1 != fwrite(Data, (size_t)(Out - Data), 1, File) )
+        {
+            Error = ERROR_WRITE_FILE;
+        }
+        Offset += (u64)(Out - Data);
+    }
+
+    if( NULL != File )
+    {
+        if( ERROR_NONE == Error )
+        {
+            voidWriteLittleEndian(&Index[Bands * ARCHIVE_INDEX_ENTRY_SIZE], (u32)Offset);
+            voidWriteLittleEndian(&Index[Bands * ARCHIVE_INDEX_ENTRY_SIZE + 4], (u32)(Offset >> 32));
+
+            memcpy(Header, MAP_ARCHIVE_MAGIC, 4);
+            voidWriteLittleEndian(&Header[4], map->Width);
+            voidWriteLittleEndian(&Header[8], map->Height);
+            voidWriteLittleEndian(&Header[12], ARCHIVE_BAND_ROWS);
+            voidWriteLittleEndian(&Header[16], Bands);
+            rewind(File);
+            if( (1 != fwrite(Header, MAP_FILE_HEADER_SIZE, 1, File)) || (1 != fwrite(Index, (size_t)IndexSize, 1, File)) )
+            {
+                Error = ERROR_WRITE_FILE;
+            }
+        }
+        if( (0 != fclose(File)) && (ERROR_NONE == Error) )
+        {
+            Error = ERROR_WRITE_FILE;
+        }
+    }
+#if MAP_TILED == TRUE
+    if( ERROR_NONE == Error )
+    {
+        Error = u8TiledMapError(map);
+    }
+#endif
+
+#if (MAP_PACKED == TRUE) || (MAP_TILED == TRUE)
+    free(Row);
+#endif
+    free(Data);
+    free(Index);
+    *Size = Offset;
+    return Error;
+
+}/*end of u8SaveMapArchive()*/
+
+/*this function writes one run of cells of a map archive band
+ *Arguments : pointer to encoded bytes , status of run cells , run length (1 or more)
+ *Return    : number of bytes written (1 to 6) */
+static u32 u32EncodeRun(u8 *Bytes, u8 Status, u32 Length)
+{
+    u8  Code  = (u8)(StatusToCode[Status] << 5);
+    u32 Count = 1;
+
+    if( Length <= ARCHIVE_LONG_RUN )
+    {
+        Bytes[0] = (u8)(Code | (Length - 1));
+        return 1;
+    }
+
+    Bytes[0] = (u8)(Code | ARCHIVE_LONG_RUN);
+    Length  -= ARCHIVE_LONG_RUN + 1;
+    while( Length >= 0x80 )
+    {
+        Bytes[Count] = (u8)(Length | 0x80);
+        Length >>= 7;
+        Count++;
+    }
+    Bytes[Count] = (u8)Length;
+
+    return Count + 1;
+
+}/*end of u32EncodeRun()*/
+
+/*this function opens a map archive and reads its band index , archive is closed again if it is not valid
+ *Arguments : pointer to map archive , map archive file name
+ *Return    : ERROR_NONE , ERROR_OPEN_FILE , ERROR_READ_FILE , ERROR_NO_MEMORY or ERROR_BAD_FILE if archive
+ *            is not a valid map archive (bad header , damaged index) */
+u8 u8OpenMapArchive(maparchive *Archive, const char *FileName)
+{
+    u8  Header[MAP_FILE_HEADER_SIZE];
+    u8  *Index;
+    u64 FileSize;
+    u64 BiggestBand = 1;
+    u64 IndexEnd;
+    u8  Error = ERROR_NONE;
+    int Result;
+
+    memset(Archive, 0, sizeof(maparchive));
+    Archive->File = fopen(FileName, "rb");
+    if( NULL == Archive->File )
+    {
+        return ERROR_OPEN_FILE;
+    }
+    if( 1 != fread(Header, MAP_FILE_HEADER_SIZE, 1, Archive->File) )
+    {
+        voidCloseMapArchive(Archive);
+        return ERROR_BAD_FILE;
+    }
+#if defined(_WIN32)
+    Result   = _fseeki64(Archive->File, 0, SEEK_END);
+    FileSize = (u64)_ftelli64(Archive->File);
+#else
+    Result   = fseeko(Archive->File, 0, SEEK_END);
+    FileSize = (u64)ftello(Archive->File);
+#endif
+    if( 0 != Result )
+    {
+        voidCloseMapArchive(Archive);
+        return ERROR_READ_FILE;
+    }
+
+    /*Check header*/
+    /*=============================================*/
+    Archive->Width    = u32ReadLittleEndian(&Header[4]);
+    Archive->Height   = u32ReadLittleEndian(&Header[8]);
+    Archive->Stride   = Archive->Width + 2;
+    Archive->BandRows = u32ReadLittleEndian(&Header[12]);
+    Archive->Bands    = u32ReadLittleEndian(&Header[16]);
+    IndexEnd          = MAP_FILE_HEADER_SIZE + ((u64)Archive->Bands + 1) * ARCHIVE_INDEX_ENTRY_SIZE;
+    /*size is checked before Stride is used , a band has no more rows than the map so band buffers
+     *are never bigger than the map*/
+    if( (0 != memcmp(Header, MAP_ARCHIVE_MAGIC, 4)) || (FALSE == u8IsMapSizeSupported(Archive->Width, Archive->Height)) ||
+        (0 == Archive->BandRows) || (Archive->BandRows > ((u64)Archive->Height + 2)) ||
+        (Archive->Bands != (u32)(((u64)Archive->Height + 2 + Archive->BandRows - 1) / Archive->BandRows)) ||
+        (IndexEnd > FileSize) )
+    {
+        voidCloseMapArchive(Archive);
+        return ERROR_BAD_FILE;
+    }
+
+    /*Read band index , bands must follow each other up to end of file*/
+    /*=============================================*/
+    Archive->Index = (u64 *)malloc(((size_t)Archive->Bands + 1) * sizeof(u64));
+    Index          = (u8 *)malloc(((size_t)Archive->Bands + 1) * ARCHIVE_INDEX_ENTRY_SIZE);
+    if( (NULL == Archive->Index) || (NULL == Index) )
+    {
+        Error = ERROR_NO_MEMORY;
+    }
+    else
+    {
+        Error = u8SeekArchive(Archive, MAP_FILE_HEADER_SIZE);
+    }
+    if( (ERROR_NONE == Error) && (1 != fread(Index, ((size_t)Archive->Bands + 1) * ARCHIVE_INDEX_ENTRY_SIZE, 1, Archive->File)) )
+    {
+        Error = ERROR_READ_FILE;
+    }
+    for(u32 Band = 0; (ERROR_NONE == Error) && (Band <= Archive->Bands); Band++)
+    {
+        Archive->Index[Band] = (u64)u32ReadLittleEndian(&Index[Band * ARCHIVE_INDEX_ENTRY_SIZE]) |
+                               ((u64)u32ReadLittleEndian(&Index[Band * ARCHIVE_INDEX_ENTRY_SIZE + 4]) << 32);
+        /*every offset is checked against file size before any band is seeked to*/
+        if( (Archive->Index[Band] > FileSize) || ((Band < Archive->Bands) && (Archive->Index[Band] >= FileSize)) )
+        {
+            Error = ERROR_BAD_FILE;
+        }
+        else if( (0 != Band) && ((Archive->Index[Band] <= Archive->Index[Band-1]) ||
+                                 ((Archive->Index[Band] - Archive->Index[Band-1]) > ((u64)Archive->BandRows * Archive->Stride))) )
+        {
+            Error = ERROR_BAD_FILE;
+        }
+        else if( (0 != Band) && ((Archive->Index[Band] - Archive->Index[Band-1]) > BiggestBand) )
+        {
+            BiggestBand = Archive->Index[Band] - Archive->Index[Band-1];
+        }
+    }
+    free(Index);
+    if( (ERROR_NONE == Error) && ((Archive->Index[0] != IndexEnd) || (Archive->Index[Archive->Bands] != FileSize)) )
+    {
+        Error = ERROR_BAD_FILE;
+    }
+
+    if( ERROR_NONE == Error )
+    {
+        Archive->Data = (u8 *)malloc((size_t)BiggestBand);
+        if( NULL == Archive->Data )
+        {
+            Error = ERROR_NO_MEMORY;
+        }
+    }
+    if( ERROR_NONE != Error )
+    {
+        voidCloseMapArchive(Archive);
+    }
+    return Error;
+
+}/*end of u8OpenMapArchive()*/
+
+/*this function reads one band of a map archive through its index and decodes it , bands can be read in
+ *any order , band b holds BandRows map rows from row b*BandRows on (border rows included , top border is row 0)
+ *Arguments : pointer to open map archive , band number , status array of BandRows x Stride cells that receives band rows ,
+ *            pointer that receives number of rows in band
+ *Return    : ERROR_NONE , ERROR_READ_FILE or ERROR_BAD_FILE if band is damaged or not in archive */
+u8 u8ReadArchiveBand(maparchive *Archive, u32 Band, u8 *Rows, u32 *BandRows)
+{
+    u32 FirstRow = Band * Archive->BandRows;
+    u64 Cells;
+    u64 Size;
+    u64 Cell     = 0;
+    u64 i        = 0;
+
+    if( Band >= Archive->Bands )
+    {
+        return ERROR_BAD_FILE;
+    }
+    Size      = Archive->Index[Band+1] - Archive->Index[Band];
+    *BandRows = ((Archive->Height + 2 - FirstRow) < Archive->BandRows) ? (Archive->Height + 2 - FirstRow) : Archive->BandRows;
+    Cells     = (u64)*BandRows * Archive->Stride;
+    if( (ERROR_NONE != u8SeekArchive(Archive, Archive->Index[Band])) ||
+        (1 != fread(Archive->Data, (size_t)Size, 1, Archive->File)) )
+    {
+        return ERROR_READ_FILE;
+    }
+
+    while( i < Size )
+    {
+        u8  Byte   = Archive->Data[i++];
+        u8  Code   = (u8)(Byte >> 5);
+        u64 Length = (u64)(Byte & ARCHIVE_LONG_RUN) + 1;
+
+        if( ARCHIVE_LONG_RUN == (Byte & ARCHIVE_LONG_RUN) )
+        {
+            u32 Shift = 0;
+
+            Length = 0;
+            do
+            {
+                if( (i >= Size) || (Shift > 28) )
+                {
+                    return ERROR_BAD_FILE;
+                }
+                Length |= (u64)(Archive->Data[i] & 0x7F) << Shift;
+                Shift  += 7;
+            } while( 0 != (Archive->Data[i++] & 0x80) );
+            Length += ARCHIVE_LONG_RUN + 1;
+        }
+        /*code 3 is not used*/
+        if( (3 == Code) || (Length > (Cells - Cell)) )
+        {
+            return ERROR_BAD_FILE;
+        }
+        if( (Length <= ARCHIVE_LONG_RUN) && ((Cells - Cell) >= (ARCHIVE_LONG_RUN + 1)) )
+        {
+            /*short runs are written as 32 cells of run status without a length dependent loop ,
+             *cells after the run are written again by next runs of band*/
+            u64 Pattern = 0x0101010101010101ULL * CodeToStatus[Code];
+            for(u8 k = 0; k < (ARCHIVE_LONG_RUN + 1); k += 8)
+            {
+                memcpy(&Rows[Cell + k], &Pattern, 8);
+            }
+        }
+        else
+        {
+            memset(&Rows[Cell], CodeToStatus[Code], (size_t)Length);
+        }
+        Cell += Length;
+    }
+
+    return (Cell == Cells) ? ERROR_NONE : ERROR_BAD_FILE;
+
+}/*end of u8ReadArchiveBand()*/
+
+/*this function moves file position of a map archive
+ *Arguments : pointer to open map archive , file offset
+ *Return    : ERROR_NONE or ERROR_READ_FILE */
+static u8 u8SeekArchive(maparchive *Archive, u64 Offset)
+{
+#if defined(_WIN32)
+    int Result = _fseeki64(Archive->File, (long long)Offset, SEEK_SET);
+#else
+    int Result = fseeko(Archive->File, (off_t)Offset, SEEK_SET);
+#endif
+
+    return (0 == Result) ? ERROR_NONE : ERROR_READ_FILE;
+
+}/*end of u8SeekArchive()*/
+
+/*this function closes a map archive opened by u8OpenMapArchive();
+ *Arguments : pointer to open map archive
+ *Return    : void */
+void voidCloseMapArchive(maparchive *Archive)
+{
+    if( NULL != Archive->File )
+    {
+        fclose(Archive->File);
+    }
+    free(Archive->Index);
+    free(Archive->Data);
+    Archive->File  = NULL;
+    Archive->Index = NULL;
+    Archive->Data  = NULL;
+
+}/*end of voidCloseMapArchive()*/
+
+/*this function creates an Input map from a map archive , bands are decoded one after the other straight
+ *into input map (into its bit planes or tile file with MAP_PACKED or MAP_TILED) so whole archive is never
+ *expanded first
+ *Arguments : pointer to map , map archive file name , arena bit planes are taken from (MAP_ARENA with MAP_PACKED)
+ *Return    : ERROR_NONE , an error of u8OpenMapArchive(); or u8ReadArchiveBand(); , ERROR_BAD_FILE if a border
+ *            cell is missing , ERROR_NO_MEMORY , ERROR_ARENA_FULL , ERROR_OPEN_FILE or ERROR_WRITE_FILE (tile file) */
+u8 u8LoadMapArchive(cellmap *map, const char *FileName, arena *Arena)
+{
+    maparchive Archive;
+    u8         *Band = NULL;
+    u64        NumberOfCells;
+    u8         Error;
+
+    Error = u8OpenMapArchive(&Archive, FileName);
+    if( ERROR_NONE != Error )
+    {
+        return Error;
+    }
+    NumberOfCells = (u64)Archive.Stride * ((u64)Archive.Height + 2);
+
+    map->Width   = Archive.Width;
+    map->Height  = Archive.Height;
+    map->Stride  = Archive.Stride;
+    map->Status  = NULL;
+    map->Storage = MAP_STORAGE_HEAP;
+    map->Bits    = NULL;
+    map->Words   = 0;
+    map->Planes  = 0;
+    map->Tiles   = NULL;
+
+#if (MAP_PACKED == TRUE) || (MAP_TILED == TRUE)
+    /*bands are decoded into one band buffer and moved to bit planes or tile file*/
+    Band = (u8 *)malloc((size_t)Archive.BandRows * Archive.Stride);
+    if( NULL == Band )
+    {
+        Error = ERROR_NO_MEMORY;
+    }
+#if MAP_PACKED == TRUE
+    if( ERROR_NONE == Error )
+    {
+        Error = u8CreatePackedMap(map, INPUT_MAP_PLANES, Arena);
+    }
+#else
+    (void)Arena;
+    FILE *File = NULL;
+    if( ERROR_NONE == Error )
+    {
+        File = tmpfile();
+        if( NULL == File )
+        {
+            Error = ERROR_OPEN_FILE;
+        }
+    }
+#endif
+#else
+    /*bands are decoded straight into status array , like other one byte per cell input maps it is
+     *not taken from map arena (MAP_ARENA)*/
+    (void)Arena;
+    map->Status = (u8 *)aligned_alloc(CACHE_LINE_SIZE, (size_t)((NumberOfCells + CACHE_LINE_SIZE - 1) & ~(u64)(CACHE_LINE_SIZE - 1)));
+    if( NULL == map->Status )
+    {
+        Error = ERROR_NO_MEMORY;
+    }
+#endif
+
+    for(u32 b = 0; (ERROR_NONE == Error) && (b < Archive.Bands); b++)
+    {
+        u32 FirstRow = b * Archive.BandRows;
+        u32 Rows;
+
+#if (MAP_PACKED == FALSE) && (MAP_TILED == FALSE)
+        Band = &map->Status[(u64)FirstRow * Archive.Stride];
+#endif
+        Error = u8ReadArchiveBand(&Archive, b, Band, &Rows);
+
+        /*Explorer relies on border cells around the map so they are checked as bands are read*/
+        for(u32 r = 0; (ERROR_NONE == Error) && (r < Rows); r++)
+        {
+            const u8 *Row = &Band[(u64)r * Archive.Stride];
+
+            if( (0 == (FirstRow + r)) || ((Archive.Height + 1) == (FirstRow + r)) )
+            {
+                for(u32 j = 0; j < Archive.Stride; j++)
+                {
+                    if( BORDER != Row[j] )
+                    {
+                        Error = ERROR_BAD_FILE;
+                    }
+                }
+            }
+            else if( (BORDER != Row[0]) || (BORDER != Row[Archive.Width+1]) )
+            {
+                Error = ERROR_BAD_FILE;
+            }
+        }
+
+#if MAP_PACKED == TRUE
+        for(u64 k = 0; (ERROR_NONE == Error) && (k < ((u64)Rows * Archive.Stride)); k++)
+        {
+            voidSetPackedStatus(map, (u32)((u64)FirstRow * Archive.Stride + k), Band[k]);
+        }
+#elif MAP_TILED == TRUE
+        if( (ERROR_NONE == Error) && (1 != fwrite(Band, (size_t)Rows * Archive.Stride, 1, File)) )
+        {
+            Error = ERROR_WRITE_FILE;
+        }
+#endif
+    }
+    voidCloseMapArchive(&Archive);
+
+#if (MAP_PACKED == TRUE) || (MAP_TILED == TRUE)
+    free(Band);
+    (void)NumberOfCells;
+#endif
+#if MAP_TILED == TRUE
+    if( ERROR_NONE == Error )
+    {
+        return u8OpenTiledMap(map, File, 0, TILE_LAYOUT_ROWS);
+    }
+    if( NULL != File )
+    {
+        fclose(File);
+    }
+#endif
+    if( ERROR_NONE != Error )
+    {
+        voidFreeMap(map);
+    }
+    return Error;
+
+}/*end of u8LoadMapArchive()*/
+
+#if MAP_PACKED == TRUE
+/*this function allocates cleared bit planes of a packed map
+ *Arguments : pointer to map with Width and Height set , number of bit planes , arena they are taken from (MAP_ARENA)
+ *Return    : ERROR_NONE , ERROR_NO_MEMORY , ERROR_ARENA_FULL or ERROR_MAP_SIZE (map bigger than arena map size) */
+static u8 u8CreatePackedMap(cellmap *map, u8 Planes, arena *Arena)
+{
+    /*Plane size rounded up to a whole number of cache lines (8 words)*/
+    u64 NumberOfCells = (u64)map->Stride * (u64)(map->Height+2);
+    u64 Words         = ((NumberOfCells + 511) / 512) * 8;
+
+    map->Words  = (u32)Words;
+    map->Planes = Planes;
+#if MAP_ARENA == TRUE
+    if( (map->Width > ARENA_MAX_WIDTH) || (map->Height > ARENA_MAX_HEIGHT) )
+    {
+        return ERROR_MAP_SIZE;
+    }
+    map->Bits   = (u64 *)pvArenaAllocate(Arena, Words * Planes * sizeof(u64));
+    if( NULL == map->Bits )
+    {
+        return ERROR_ARENA_FULL;
+    }
+#else
+    (void)Arena;
+    map->Bits   = (u64 *)aligned_alloc(CACHE_LINE_SIZE, (size_t)(Words * Planes * sizeof(u64)));
+    if( NULL == map->Bits )
+    {
+        return ERROR_NO_MEMORY;
+    }
+#endif
+    memset(map->Bits, 0, (size_t)(Words * Planes * sizeof(u64)));
+
+    return ERROR_NONE;
+
+}/*end of u8CreatePackedMap()*/
+#endif
+
+/*this function gives a memory block to a caller owned map arena (MAP_ARENA) , maps , branch stack and route
+ *search memory of explorers created with the arena are taken from it , memory should be ARENA_SIZE bytes
+ *on a cache line boundary
+ *Arguments : pointer to arena , memory block , its size in bytes
+ *Return    : void */
+void voidSetArena(arena *Arena, u8 *Memory, u64 Size)
+{
+    Arena->Memory = Memory;
+    Arena->Size   = Size;
+    Arena->Used   = 0;
+
+}/*end of voidSetArena()*/
+
+/*this function takes a block from a map arena , a block that does not fit is never given so a map
+ *bigger than arena never writes past it , blocks of caller (trace buffer) are taken the same way
+ *Arguments : pointer to arena , block size in bytes
+ *Return    : pointer to block on a cache line boundary , NULL if arena is full */
+void *pvArenaAllocate(arena *Arena, u64 Size)
+{
+    /*first free byte on a cache line boundary , caller memory may not start on one*/
+    u64 Misalign = (u64)(((size_t)Arena->Memory + Arena->Used) & (CACHE_LINE_SIZE - 1));
+    u64 Start    = Arena->Used + ((0 == Misalign) ? 0 : (CACHE_LINE_SIZE - Misalign));
+
+    if( (Start > Arena->Size) || (Size > (Arena->Size - Start)) )
+    {
+        return NULL;
+    }
+    Arena->Used = Start + Size;
+
+    return &Arena->Memory[Start];
+
+}/*end of pvArenaAllocate()*/
+
+/*this function releases every block of a map arena , maps and explorers using them must not be used anymore
+ *Arguments : pointer to arena
+ *Return    : void */
+void voidResetArena(arena *Arena)
+{
+    Arena->Used = 0;
+
+}/*end of voidResetArena()*/
+
+/*this function converts a cell status to its packed code
+ *Arguments : cell status
+ *Return    : packed code */
+static u8 u8StatusToCode(u8 Status)
+{
+    return StatusToCode[Status];
+
+}/*end of u8StatusToCode()*/
+
+#if MAP_PACKED == TRUE
+/*this function packs a one byte per cell status array into bit planes of a packed map
+ *Arguments : pointer to map created by u8CreatePackedMap(); , status array including borders
+ *Return    : void */
+static void voidPackMap(cellmap *map, const u8 *Source)
+{
+    u64 NumberOfCells = (u64)map->Stride * (u64)(map->Height+2);
+
+    /*build one word of every plane from 64 cells at a time*/
+    for(u64 Word = 0; (Word * 64) < NumberOfCells; Word++)
+    {
+        u64 PlaneWord[OUTPUT_MAP_PLANES] = {0};
+        u64 Cells = ((NumberOfCells - Word*64) < 64) ? (NumberOfCells - Word*64) : 64;
+
+        for(u64 Bit = 0; Bit < Cells; Bit++)
+        {
+            u8 Code = u8StatusToCode(Source[Word*64 + Bit]);
+            for(u8 p = 0; p < map->Planes; p++)
+            {
+                PlaneWord[p] |= (u64)((Code >> p) & 1) << Bit;
+            }
+        }
+        for(u8 p = 0; p < map->Planes; p++)
+        {
+            map->Bits[(u64)p*map->Words + Word] = PlaneWord[p];
+        }
+    }
+
+}/*end of voidPackMap()*/
+#endif
+
+/*this function reads status of a cell from bit planes of a packed map
+ *Arguments : pointer to map , cell index
+ *Return    : cell status */
+u8 u8GetPackedStatus(const cellmap *map, u32 Index)
+{
+    const u64 *Word = &map->Bits[Index >> 6];
+    u32 Bit  = Index & 63;
+    u8  Code = (u8)( ((Word[0] >> Bit) & 1) | (((Word[map->Words] >> Bit) & 1) << 1) );
+
+    if( OUTPUT_MAP_PLANES == map->Planes )
+    {
+        Code |= (u8)(((Word[2*map->Words] >> Bit) & 1) << 2);
+    }
+    return CodeToStatus[Code];
+
+}/*end of u8GetPackedStatus()*/
+
+/*this function writes status of a cell into bit planes of a packed map
+ *Arguments : pointer to map , cell index , cell status
+ *Return    : void */
+void voidSetPackedStatus(cellmap *map, u32 Index, u8 Status)
+{
+    u64 *Word = &map->Bits[Index >> 6];
+    u64 Mask  = (u64)1 << (Index & 63);
+    u8  Code  = u8StatusToCode(Status);
+
+    for(u8 p = 0; p < map->Planes; p++)
+    {
+        /*clear then set plane bit without a branch*/
+        Word[(u64)p*map->Words] = (Word[(u64)p*map->Words] & ~Mask) | (Mask & (0 - (u64)((Code >> p) & 1)));
+    }
+
+}/*end of voidSetPackedStatus()*/
+
+#if MAP_TILED == TRUE
+/*this function sets up tile cache of a tiled map over its backing file , backing file is closed if
+ *tile cache can not be allocated
+ *Arguments : pointer to map with Width and Height set , backing file , file offset of first status byte ,
+ *            backing file layout (TILE_LAYOUT_xxx)
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY */
+static u8 u8OpenTiledMap(cellmap *map, FILE *File, u64 DataOffset, u8 Layout)
+{
+    tilecache *Cache = (tilecache *)malloc(sizeof(tilecache));
+    u32 TileRows;
+
+    if( NULL == Cache )
+    {
+        fclose(File);
+        return ERROR_NO_MEMORY;
+    }
+
+    TileRows          = ((map->Height+2) + TILE_SIZE - 1) >> TILE_SIZE_SHIFT;
+    Cache->TileCols   = (map->Stride + TILE_SIZE - 1) >> TILE_SIZE_SHIFT;
+    Cache->Tiles      = TileRows * Cache->TileCols;
+    Cache->File       = File;
+    Cache->DataOffset = DataOffset;
+    Cache->Layout     = Layout;
+    Cache->TileSlot   = (u32 *)malloc((size_t)Cache->Tiles * sizeof(u32));
+    Cache->TileStored = (u8 *)calloc(Cache->Tiles, 1);
+    Cache->Data       = (u8 *)aligned_alloc(CACHE_LINE_SIZE, (size_t)TILE_CACHE_SLOTS * TILE_CELLS);
+    Cache->SlotTile   = (u32 *)malloc(TILE_CACHE_SLOTS * sizeof(u32));
+    Cache->SlotLastUse= (u64 *)calloc(TILE_CACHE_SLOTS, sizeof(u64));
+    Cache->SlotDirty  = (u8 *)calloc(TILE_CACHE_SLOTS, 1);
+    map->Tiles = Cache;
+    if( (NULL == Cache->TileSlot) || (NULL == Cache->TileStored) || (NULL == Cache->Data) ||
+        (NULL == Cache->SlotTile) || (NULL == Cache->SlotLastUse) || (NULL == Cache->SlotDirty) )
+    {
+        voidCloseTiledMap(map);
+        return ERROR_NO_MEMORY;
+    }
+
+    /*no tile is in cache yet*/
+    for(u32 Tile = 0; Tile < Cache->Tiles; Tile++)
+    {
+        Cache->TileSlot[Tile] = TILE_NONE;
+    }
+    for(u32 Slot = 0; Slot < TILE_CACHE_SLOTS; Slot++)
+    {
+        Cache->SlotTile[Slot] = TILE_NONE;
+    }
+    Cache->Clock      = 0;
+    Cache->LastTile   = TILE_NONE;
+    Cache->LastSlot   = TILE_NONE;
+    Cache->Hits       = 0;
+    Cache->Misses     = 0;
+    Cache->WriteBacks = 0;
+    Cache->Error      = ERROR_NONE;
+
+    return ERROR_NONE;
+
+}/*end of u8OpenTiledMap()*/
+#endif
+
+/*this function closes backing file of a tiled map and releases its tile cache
+ *changed tiles are not written back as backing file of a changeable map is temporary
+ *Arguments : pointer to map
+ *Return    : void */
+static void voidCloseTiledMap(cellmap *map)
+{
+    tilecache *Cache = map->Tiles;
+
+    fclose(Cache->File);
+    free(Cache->TileSlot);
+    free(Cache->TileStored);
+    free(Cache->Data);
+    free(Cache->SlotTile);
+    free(Cache->SlotLastUse);
+    free(Cache->SlotDirty);
+    free(Cache);
+    map->Tiles = NULL;
+
+}/*end of voidCloseTiledMap()*/
+
+/*this function finds a cell of a tiled map in tile cache , its tile is read first if it is not in cache
+ *Arguments : pointer to map , cell index , TRUE if cell is going to be changed
+ *Return    : pointer to cell status in tile cache , valid until another tile is read */
+u8 *pu8GetTiledCell(const cellmap *map, u32 Index, u8 Write)
+{
+    tilecache *Cache = map->Tiles;
+    u32 Row  = Index / map->Stride;
+    u32 Col  = Index - Row * map->Stride;
+    u32 Tile = (Row >> TILE_SIZE_SHIFT) * Cache->TileCols + (Col >> TILE_SIZE_SHIFT);
+    u32 Slot;
+
+    /*explorer moves one cell at a time so nearly every access is in last used tile*/
+    if( Tile == Cache->LastTile )
+    {
+        Slot = Cache->LastSlot;
+        Cache->Hits++;
+    }
+    else
+    {
+        Slot = Cache->TileSlot[Tile];
+        if( TILE_NONE == Slot )
+        {
+            Slot = u32PageInTile(map, Tile);
+            Cache->Misses++;
+        }
+        else
+        {
+            Cache->Hits++;
+        }
+        Cache->Clock++;
+        Cache->SlotLastUse[Slot] = Cache->Clock;
+        Cache->LastTile = Tile;
+        Cache->LastSlot = Slot;
+    }
+
+    if( TRUE == Write )
+    {
+        Cache->SlotDirty[Slot] = TRUE;
+    }
+
+    return &Cache->Data[(u64)Slot * TILE_CELLS +
+                        ((Row & (TILE_SIZE-1)) << TILE_SIZE_SHIFT) + (Col & (TILE_SIZE-1))];
+
+}/*end of pu8GetTiledCell()*/
+
+/*this function reads a tile into least recently used cache slot , tile in that slot is written back
+ *first if it was changed , a tile that can not be read is filled with BORDER cells so explorer never
+ *enters it and first failure is kept in tile cache Error (see u8TiledMapError();)
+ *Arguments : pointer to map , tile number
+ *Return    : cache slot */
+static u32 u32PageInTile(const cellmap *map, u32 Tile)
+{
+    tilecache *Cache = map->Tiles;
+    u32 Slot = 0;
+    u8  *Data;
+    /*first cell of tile and number of its rows and columns inside map*/
+    u32 Row0 = (Tile / Cache->TileCols) << TILE_SIZE_SHIFT;
+    u32 Col0 = (Tile % Cache->TileCols) << TILE_SIZE_SHIFT;
+    u32 Rows = ((map->Height+2 - Row0) < TILE_SIZE) ? (map->Height+2 - Row0) : TILE_SIZE;
+    u32 Cols = ((map->Stride - Col0) < TILE_SIZE) ? (map->Stride - Col0) : TILE_SIZE;
+
+    /*pick least recently used slot , never used slots have the oldest clock value 0*/
+    for(u32 i = 1; i < TILE_CACHE_SLOTS; i++)
+    {
+        if( Cache->SlotLastUse[i] < Cache->SlotLastUse[Slot] )
+        {
+            Slot = i;
+        }
+    }
+    Data = &Cache->Data[(u64)Slot * TILE_CELLS];
+
+    /*write back replaced tile if it was changed*/
+    /*=============================================*/
+    if( TILE_NONE != Cache->SlotTile[Slot] )
+    {
+        if( TRUE == Cache->SlotDirty[Slot] )
+        {
+            if( (ERROR_NONE != u8SeekTileFile(Cache, (u64)Cache->SlotTile[Slot] * TILE_CELLS)) ||
+                (1 != fwrite(Data, TILE_CELLS, 1, Cache->File)) )
+            {
+                voidSetTileError(Cache, ERROR_WRITE_FILE);
+            }
+            Cache->TileStored[Cache->SlotTile[Slot]] = TRUE;
+            Cache->WriteBacks++;
+        }
+        Cache->TileSlot[Cache->SlotTile[Slot]] = TILE_NONE;
+    }
+    Cache->SlotTile[Slot]  = Tile;
+    Cache->SlotDirty[Slot] = FALSE;
+    Cache->TileSlot[Tile]  = Slot;
+
+    /*read new tile*/
+    /*=============================================*/
+    if( TILE_LAYOUT_ROWS == Cache->Layout )
+    {
+        /*one read for each tile row , map borders must be BORDER cells*/
+        for(u32 i = 0; i < Rows; i++)
+        {
+            u32 Row = Row0 + i;
+            u8  *Line = &Data[i << TILE_SIZE_SHIFT];
+
+            if( (ERROR_NONE != u8SeekTileFile(Cache, Cache->DataOffset + (u64)Row * map->Stride + Col0)) ||
+                (1 != fread(Line, Cols, 1, Cache->File)) )
+            {
+                voidSetTileError(Cache, ERROR_READ_FILE);
+                memset(Line, BORDER, Cols);
+            }
+            for(u32 j = 0; j < Cols; j++)
+            {
+                u32 Col = Col0 + j;
+                if( ((0 == Row) || ((map->Height+1) == Row) || (0 == Col) || ((map->Width+1) == Col)) &&
+                    (BORDER != Line[j]) )
+                {
+                    voidSetTileError(Cache, ERROR_BAD_FILE);
+                    Line[j] = BORDER;
+                }
+            }
+        }
+    }
+    else if( TRUE == Cache->TileStored[Tile] )
+    {
+        if( (ERROR_NONE != u8SeekTileFile(Cache, (u64)Tile * TILE_CELLS)) ||
+            (1 != fread(Data, TILE_CELLS, 1, Cache->File)) )
+        {
+            voidSetTileError(Cache, ERROR_READ_FILE);
+            memset(Data, BORDER, TILE_CELLS);
+        }
+    }
+    else
+    {
+        /*tile has never been written , build it with initial status like voidInitializeMap();*/
+        memset(Data, NOT_DISCOVERED, TILE_CELLS);
+        for(u32 i = 0; i < Rows; i++)
+        {
+            u32 Row = Row0 + i;
+            if( (0 == Row) || ((map->Height+1) == Row) )
+            {
+                memset(&Data[i << TILE_SIZE_SHIFT], BORDER, Cols);
+            }
+            if( 0 == Col0 )
+            {
+                Data[i << TILE_SIZE_SHIFT] = BORDER;
+            }
+            if( (Col0 + Cols) == map->Stride )
+            {
+                Data[(i << TILE_SIZE_SHIFT) + Cols - 1] = BORDER;
+            }
+        }
+    }
+
+    return Slot;
+
+}/*end of u32PageInTile()*/
+
+/*this function moves backing file position of a tiled map
+ *Arguments : pointer to tile cache , file offset
+ *Return    : ERROR_NONE or ERROR_READ_FILE */
+static u8 u8SeekTileFile(tilecache *Cache, u64 Offset)
+{
+#if defined(_WIN32)
+    int Result = _fseeki64(Cache->File, (long long)Offset, SEEK_SET);
+#else
+    int Result = fseeko(Cache->File, (off_t)Offset, SEEK_SET);
+#endif
+
+    return (0 == Result) ? ERROR_NONE : ERROR_READ_FILE;
+
+}/*end of u8SeekTileFile()*/
+
+/*this function keeps first tile read or write failure of a tiled map
+ *Arguments : pointer to tile cache , error code
+ *Return    : void */
+static void voidSetTileError(tilecache *Cache, u8 Error)
+{
+    if( ERROR_NONE == Cache->Error )
+    {
+        Cache->Error = Error;
+    }
+
+}/*end of voidSetTileError()*/
+
+/*this function gives first tile read or write failure of a tiled map , cells of tiles that could not be
+ *read are BORDER cells so a search or a copy of the map that used them is not valid
+ *Arguments : pointer to map
+ *Return    : ERROR_NONE , ERROR_READ_FILE , ERROR_WRITE_FILE or ERROR_BAD_FILE (border cell missing in map file) */
+u8 u8TiledMapError(const cellmap *map)
+{
+    return (NULL == map->Tiles) ? ERROR_NONE : map->Tiles->Error;
+
+}/*end of u8TiledMapError()*/
+
+/*this function counts cells of a map (borders included) that have a status
+ *packed maps are counted 64 cells at a time
+ *Arguments : pointer to map , cell status
+ *Return    : number of cells */
+u32 u32CountStatus(const cellmap *map, u8 Status)
+{
+    u64 NumberOfCells = (u64)map->Stride * (u64)(map->Height+2);
+    u32 Count = 0;
+
+#if MAP_PACKED == TRUE
+    u8  Code = u8StatusToCode(Status);
+    /*code does not fit in map planes (an output status in an input map)*/
+    if( (Code >> map->Planes) != 0 )
+    {
+        return 0;
+    }
+    /*plane p is inverted when code bit p is 0 so matching cells have all plane words bits set*/
+    u64 Invert[OUTPUT_MAP_PLANES];
+    for(u8 p = 0; p < map->Planes; p++)
+    {
+        Invert[p] = ((Code >> p) & 1) ? 0 : ~(u64)0;
+    }
+    for(u64 Word = 0; (Word * 64) < NumberOfCells; Word++)
+    {
+        u64 Match = ~(u64)0;
+        for(u8 p = 0; p < map->Planes; p++)
+        {
+            Match &= map->Bits[(u64)p*map->Words + Word] ^ Invert[p];
+        }
+        /*ignore bits after last cell*/
+        if( (NumberOfCells - Word*64) < 64 )
+        {
+            Match &= ((u64)1 << (NumberOfCells - Word*64)) - 1;
+        }
+        Count += (u32)__builtin_popcountll(Match);
+    }
+#else
+    for(u64 Index = 0; Index < NumberOfCells; Index++)
+    {
+        Count += (Status == MAP_GET(map,(u32)Index)) ? 1 : 0;
+    }
+#endif
+
+    return Count;
+
+}/*end of u32CountStatus()*/
+
+/*this function compares status of all cells of two maps , packed maps are compared 64 cells at a time
+ *Arguments : pointers to two maps
+ *Return    : TRUE if both maps have the same size and the same status in every cell */
+u8 u8CompareMaps(const cellmap *map1, const cellmap *map2)
+{
+    if( (map1->Width != map2->Width) || (map1->Height != map2->Height) )
+    {
+        return FALSE;
+    }
+
+#if MAP_PACKED == TRUE
+    /*a plane missing in one map is all zeros*/
+    u8 Planes = (map1->Planes > map2->Planes) ? map1->Planes : map2->Planes;
+    for(u8 p = 0; p < Planes; p++)
+    {
+        for(u32 Word = 0; Word < map1->Words; Word++)
+        {
+            u64 Word1 = (p < map1->Planes) ? map1->Bits[(u64)p*map1->Words + Word] : 0;
+            u64 Word2 = (p < map2->Planes) ? map2->Bits[(u64)p*map2->Words + Word] : 0;
+            if( Word1 != Word2 )
+            {
+                return FALSE;
+            }
+        }
+    }
+    return TRUE;
+#elif MAP_TILED == TRUE
+    for(u64 Index = 0; Index < ((u64)map1->Stride * (u64)(map1->Height+2)); Index++)
+    {
+        if( MAP_GET(map1,(u32)Index) != MAP_GET(map2,(u32)Index) )
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+#else
+    return (0 == memcmp(map1->Status, map2->Status, (size_t)map1->Stride * (size_t)(map1->Height+2))) ? TRUE : FALSE;
+#endif
+
+}/*end of u8CompareMaps()*/
+
+/*this function loads a map from a text file , each line is a map row of '*' (MINE) and '-' (NOT_MINE)
+ *characters , any other character is ignored and lines without map characters are skipped
+ *so a map printed by voidPrintMap(); can be loaded again
+ *Arguments : file name , pointer that receives allocated status array of (Height+2) x (Width+2) elements
+ *            including borders , pointers to Width and Height that receive map dimensions
+ *Return    : ERROR_NONE , ERROR_OPEN_FILE , ERROR_BAD_FILE if rows do not have the same width or there is no row ,
+ *            ERROR_MAP_SIZE or ERROR_NO_MEMORY */
+u8 u8LoadTextMap(const char *FileName, u8 **Map, u32 *Width, u32 *Height)
+{
+    FILE *File = fopen(FileName, "rb");
+    u8   *Source;
+    u32  RowWidth = 0;
+    u32  Row      = 0;
+    u32  Col      = 0;
+    int  Char;
+
+    if( NULL == File )
+    {
+        return ERROR_OPEN_FILE;
+    }
+
+    /*First pass : find map dimensions and check that all rows have the same width*/
+    /*=============================================*/
+    *Width  = 0;
+    *Height = 0;
+    do
+    {
+        Char = fgetc(File);
+        if( (MINE == Char) || (NOT_MINE == Char) )
+        {
+            RowWidth++;
+        }
+        else if( (('\n' == Char) || (EOF == Char)) && (RowWidth > 0) )
+        {
+            /*end of a map row*/
+            if( (*Height > 0) && (RowWidth != *Width) )
+            {
+                fclose(File);
+                return ERROR_BAD_FILE;
+            }
+            *Width = RowWidth;
+            (*Height)++;
+            RowWidth = 0;
+        }
+    }while( EOF != Char );
+
+    if( 0 == *Height )
+    {
+        fclose(File);
+        return ERROR_BAD_FILE;
+    }
+    if( FALSE == u8IsMapSizeSupported(*Width, *Height) )
+    {
+        fclose(File);
+        return ERROR_MAP_SIZE;
+    }
+
+    Source = (u8 *)malloc((size_t)(*Width+2) * (size_t)(*Height+2));
+    if( NULL == Source )
+    {
+        fclose(File);
+        return ERROR_NO_MEMORY;
+    }
+    /*Fill whole array with borders then overwrite inner cells*/
+    memset(Source, BORDER, (size_t)(*Width+2) * (size_t)(*Height+2));
+
+    /*Second pass : fill inner cells row by row*/
+    /*=============================================*/
+    rewind(File);
+    Row = 1;
+    Col = 1;
+    while( EOF != (Char = fgetc(File)) )
+    {
+        if( (MINE == Char) || (NOT_MINE == Char) )
+        {
+            Source[(size_t)Row*(*Width+2) + Col] = (u8)Char;
+            Col++;
+        }
+        else if( ('\n' == Char) && (Col > 1) )
+        {
+            Row++;
+            Col = 1;
+        }
+    }
+
+    fclose(File);
+    *Map = Source;
+    return ERROR_NONE;
+
+}/*end of u8LoadTextMap()*/
+
+/*this function returns next number of a seeded random sequence (xorshift64*) so a seed always
+ *generates the same map on every platform
+ *Arguments : pointer to random state , never 0
+ *Return    : random number */
+static u32 u32NextRandom(u64 *State)
+{
+    *State ^= *State >> 12;
+    *State ^= *State << 25;
+    *State ^= *State >> 27;
+    return (u32)((*State * 0x2545F4914F6CDD1DULL) >> 32);
+
+}/*end of u32NextRandom()*/
+
+/*this function generates a map of a family (MAP_FAMILY_xxx)
+ *Arguments : family , number of columns and rows without borders , seed , mine density (%) of uniform maps ,
+ *            pointer that receives allocated status array of (Height+2) x (Width+2) elements including borders
+ *Return    : ERROR_NONE , ERROR_MAP_SIZE or ERROR_NO_MEMORY */
+u8 u8GenerateMap(u8 Family, u32 Width, u32 Height, u32 Seed, u32 Density, u8 **Map)
+{
+    u64 Stride = (u64)Width + 2;
+    u64 State  = ((u64)Seed * 0x9E3779B97F4A7C15ULL) | 1;
+    u8  *Source;
+
+    if( FALSE == u8IsMapSizeSupported(Width, Height) )
+    {
+        return ERROR_MAP_SIZE;
+    }
+    Source = (u8 *)malloc((size_t)Stride * (size_t)(Height+2));
+    if( NULL == Source )
+    {
+        return ERROR_NO_MEMORY;
+    }
+    /*Fill whole array with borders then overwrite inner cells*/
+    memset(Source, BORDER, (size_t)Stride * (size_t)(Height+2));
+
+    /*inner cell (r,c) is Source[(r+1)*Stride + c+1] , r = 0 is first row*/
+    for(u32 r = 0; r < Height; r++)
+    {
+        u8 *Row = &Source[(r+1)*Stride + 1];
+
+        for(u32 c = 0; c < Width; c++)
+        {
+            u8 Mine = FALSE;
+
+            switch( Family )
+            {
+                case MAP_FAMILY_UNIFORM:
+                    Mine = ((u32NextRandom(&State) % 100) < Density) ? TRUE : FALSE;
+                    break;
+                case MAP_FAMILY_MAZE:
+                    /*rooms at even (r,c) , walls in between are carved below*/
+                    Mine = ((r | c) & 1) ? TRUE : FALSE;
+                    break;
+                case MAP_FAMILY_CORRIDOR:
+                    /*odd rows are walls with one opening at alternating ends*/
+                    Mine = ((r & 1) && (c != (((r >> 1) & 1) ? 0 : (Width-1)))) ? TRUE : FALSE;
+                    break;
+                case MAP_FAMILY_WORST:
+                    /*first row is comb spine , odd columns below it are mines*/
+                    Mine = ((r > 0) && (c & 1)) ? TRUE : FALSE;
+                    break;
+                default:
+                    break;
+            }
+            Row[c] = (TRUE == Mine) ? MINE : NOT_MINE;
+        }
+    }
+
+    if( MAP_FAMILY_MAZE == Family )
+    {
+        /*binary tree maze , every room opens the wall to its right or the wall above it ,
+         *first row rooms always open to the right and last column rooms always open above*/
+        for(u32 r = 0; r < Height; r += 2)
+        {
+            for(u32 c = 0; c < Width; c += 2)
+            {
+                u8 Right = ((c+1) < Width) ? TRUE : FALSE;
+                u8 Above = (r > 0) ? TRUE : FALSE;
+
+                if( (TRUE == Right) && (TRUE == Above) )
+                {
+                    Right = (u32NextRandom(&State) & 1) ? TRUE : FALSE;
+                    Above = !Right;
+                }
+                if( TRUE == Right )
+                {
+                    Source[(r+1)*Stride + c+2] = NOT_MINE;
+                }
+                else if( TRUE == Above )
+                {
+                    Source[r*Stride + c+1] = NOT_MINE;
+                }
+            }
+        }
+    }
+
+    /*entry point*/
+    Source[Stride + 1] = NOT_MINE;
+    *Map = Source;
+    return ERROR_NONE;
+
+}/*end of u8GenerateMap()*/
+
+/*this function prints a map passed to it
+ *Arguments : output stream and pointer to map
+ *Return    : void */
+void voidPrintMap(FILE *Stream, cellmap *map)
+{
+    /*2 loops to go through all map cells from (0,0) cell to (Height+2,Width+2)
+     *to print all cells including Borders */
+    for(u32 i=0;i<(map->Height+2);i++)
+    {
+        for(u32 j=0;j<(map->Width+2);j++)
+        {
+            /*Print cell*/
+            putc(MAP_CELL(map,i,j), Stream);
+            putc(' ', Stream);
+        }/*end of j for*/
+
+        /*Print new line after each row*/
+        putc('\n', Stream);
+
+    }/*end of i for*/
+}
+
+/*this function records an output map cell change so it is written with the step it belongs to
+ *Arguments : pointer to explorer , cell index and cell status before the change
+ *Return    : void */
+static void voidTraceCellChange(explorer *Explorer, u32 Index, u8 OldStatus)
+{
+    /*keep only first status of a cell changed more than once in the same step*/
+    for(u8 i = 0; i < Explorer->TraceDeltas; i++)
+    {
+        if( Index == Explorer->TraceDeltaIndex[i] )
+        {
+            return;
+        }
+    }
+
+    /*write pending changes early if this step changed too many cells*/
+    if( TRACE_MAX_DELTAS == Explorer->TraceDeltas )
+    {
+        voidTraceFlushDeltas(Explorer);
+    }
+
+    Explorer->TraceDeltaIndex[Explorer->TraceDeltas] = Index;
+    Explorer->TraceDeltaOld[Explorer->TraceDeltas]   = OldStatus;
+    Explorer->TraceDeltas++;
+
+}/*end of voidTraceCellChange()*/
+
+/*this function writes pending cell changes recorded by voidTraceCellChange(); that really changed
+ *Arguments : pointer to explorer
+ *Return    : void */
+static void voidTraceFlushDeltas(explorer *Explorer)
+{
+    for(u8 i = 0; i < Explorer->TraceDeltas; i++)
+    {
+        u32 Index     = Explorer->TraceDeltaIndex[i];
+        u8  NewStatus = MAP_GET(&Explorer->Outputmap,Index);
+
+        /*skip cells that got back their status within the same step*/
+        if( NewStatus != Explorer->TraceDeltaOld[i] )
+        {
+            fprintf(Explorer->TraceFile, "%u %u %02X %02X\n", Index / Explorer->Outputmap.Stride, Index % Explorer->Outputmap.Stride,
+                    Explorer->TraceDeltaOld[i], NewStatus);
+        }
+    }
+    Explorer->TraceDeltas = 0;
+
+}/*end of voidTraceFlushDeltas()*/
+
+/*this function writes changed cells of current step or whole output map depending on trace level
+ *Arguments : pointer to explorer
+ *Return    : void */
+static void voidTraceStep(explorer *Explorer)
+{
+    STATS_START(Explorer, StatsStart);
+
+    if( TRACE_DELTAS == Explorer->TraceLevel )
+    {
+        /*Print step number and changed cells only*/
+        fprintf(Explorer->TraceFile, "Step %u\n", Explorer->VisitedCells);
+        voidTraceFlushDeltas(Explorer);
+    }
+    else if( (TRACE_FULL == Explorer->TraceLevel) && (0 == (Explorer->VisitedCells % Explorer->TraceSnapshotPeriod)) )
+    {
+        /*Print Current output map status*/
+        fprintf(Explorer->TraceFile, "Step Number : %u\n"
+                           "==============================\n",Explorer->VisitedCells);
+        voidPrintMap(Explorer->TraceFile, &Explorer->Outputmap);
+    }
+
+    STATS_PHASE(Explorer, PHASE_PRINT, StatsStart);
+
+}/*end of voidTraceStep()*/
+
+/*this function makes an explorer ready to search an input map , explorer takes the input map and
+ *creates its own output map , trace and counters are off until caller sets them
+ *if explorer can not be created input map is not taken and stays owned by caller
+ *Arguments : pointer to explorer , pointer to input map (explorer releases it with voidFreeExplorer();) ,
+ *            arena output map and search memory are taken from (MAP_ARENA , not used by other builds)
+ *Return    : ERROR_NONE or an error of u8CreateMap(); , ERROR_ARENA_FULL if branch stack does not fit in arena */
+u8 u8CreateExplorer(explorer *Explorer, const cellmap *Inputmap, arena *Arena)
+{
+    u8 Error;
+
+    memset(Explorer, 0, sizeof(explorer));
+
+    Explorer->Inputmap = *Inputmap;
+    Explorer->Arena    = Arena;
+
+    /*Create and Initialize Output map with input map dimensions*/
+    Error = u8CreateMap(&Explorer->Outputmap, Inputmap->Width, Inputmap->Height, Arena);
+    if( ERROR_NONE != Error )
+    {
+        voidFreeMap(&Explorer->Outputmap);
+        return Error;
+    }
+    voidInitializeMap(&Explorer->Outputmap);
+#if MAP_ARENA == TRUE
+    /*arena branch stack is taken at its full size so it never grows during search ,
+     *it needs no more entries than map cells as every branch point on it is a different cell*/
+    Explorer->BranchStack.Capacity = ((u64)Inputmap->Width * Inputmap->Height < ARENA_BRANCH_POINTS) ?
+                                     (Inputmap->Width * Inputmap->Height) : ARENA_BRANCH_POINTS;
+    Explorer->BranchStack.Entries  = (u32 *)pvArenaAllocate(Arena, (u64)Explorer->BranchStack.Capacity * sizeof(u32));
+    if( NULL == Explorer->BranchStack.Entries )
+    {
+        return ERROR_ARENA_FULL;
+    }
+#endif
+
+    Explorer->Planner             = PLANNER_OFF;
+    Explorer->TraceFile           = stdout;
+    Explorer->TraceLevel          = TRACE_OFF;
+    Explorer->TraceSnapshotPeriod = 1;
+    Explorer->StatsFormat         = STATS_FORMAT_OFF;
+    Explorer->Error               = ERROR_NONE;
+#if SEARCH_STATS == TRUE
+    /*measure clock read time before search*/
+    {
+        u64 Start = u64ReadClock();
+        for(u32 i = 0; i < 1000; i++)
+        {
+            u64ReadClock();
+        }
+        Explorer->StatsClockCost = (u64ReadClock() - Start) / 1001;
+    }
+#endif
+
+    return ERROR_NONE;
+
+}/*end of u8CreateExplorer()*/
+
+/*this function releases maps and search memory of an explorer
+ *Arguments : pointer to explorer created by u8CreateExplorer();
+ *Return    : void */
+void voidFreeExplorer(explorer *Explorer)
+{
+    voidFreeMap(&Explorer->Inputmap);
+    voidFreeMap(&Explorer->Outputmap);
+    voidFreeBranchStack(Explorer);
+    voidFreeRoutes(Explorer);
+
+}/*end of voidFreeExplorer()*/
+
+/*this function uses u8StartSearch(); and u8StepSearch(); functions to search map until the whole map is discovered
+ *Arguments : pointer to explorer created by u8CreateExplorer();
+ *Return    : ERROR_NONE if map was searched , ERROR_NO_ENTRY if first row is full of mines (no entry point)
+ *            or error that stopped the search (see u8StepSearch();) */
+u8 u8SearchMap(explorer *Explorer)
+{
+    u8 Error = u8StartSearch(Explorer);
+
+    if( ERROR_NONE != Error )
+    {
+        return Error;
+    }
+
+    return u8WalkMap(Explorer);
+
+}/*end of u8SearchMap();*/
+
+/*this function places explorer at entry point of the search , searching is then done one step at a time
+ *by u8StepSearch();
+ *Arguments : pointer to explorer created by u8CreateExplorer();
+ *Return    : ERROR_NONE if search can start , ERROR_NO_ENTRY if first row is full of mines (no entry point) */
+u8 u8StartSearch(explorer *Explorer)
+{
+
+    /*Make the first available cell in first row the entry point for the search*/
+    /*visit that cell and update it's status by initializing searching input and output pointers*/
+    /*=============================================*/
+    Explorer->CurrentCell = u32FindEntryCell(Explorer);
+    /*=============================================*/
+
+    /*Check CurrentCell value , 0 means that the first row in input map is full of mines*/
+    if( 0 == Explorer->CurrentCell )
+    {
+        return ERROR_NO_ENTRY;
+
+    }/*end of CurrentCell value Check*/
+
+    /*Increment number of visited cells and keep entry point for later map changes*/
+    Explorer->VisitedCells++;
+    Explorer->EntryCell = Explorer->CurrentCell;
+
+    /*print map before start searching*/
+    /*=============================================*/
+    if( Explorer->TraceLevel >= TRACE_SUMMARY )
+    {
+        fprintf(Explorer->TraceFile, "Output Map before search :\n"
+                           "==============================\n");
+        voidPrintMap(Explorer->TraceFile, &Explorer->Outputmap);
+    }
+    /*=============================================*/
+
+    return ERROR_NONE;
+
+}/*end of u8StartSearch();*/
+
+/*this function does one searching step , explorer updates output map around its current cell then moves
+ *to next cell , it only touches the explorer it is given so different explorers may be stepped from
+ *different threads at the same time
+ *a step that fails (branch stack or route search memory , tile file , FRONTIER_CHECK) stops the search ,
+ *explorer keeps the error and every later step returns it
+ *Arguments : pointer to explorer started by u8StartSearch();
+ *Return    : ERROR_NONE if search goes on , STEP_DONE once dead end is reached or error that stopped the search */
+u8 u8StepSearch(explorer *Explorer)
+{
+    /*step number , steps that move increment number of visited cells*/
+    u32 Step = Explorer->VisitedCells;
+
+    if( ERROR_NONE != Explorer->Error )
+    {
+        return Explorer->Error;
+    }
+    if( TRUE == Explorer->DeadendCondition )
+    {
+        return STEP_DONE;
+    }
+
+    /*time phases of this step or not*/
+    STATS_SAMPLE(Explorer);
+
+    /*live monitor reader does not copy bands around current cell until step is done*/
+    if( NULL != Explorer->Monitor )
+    {
+        MONITOR_BEGIN(Explorer->Monitor, Explorer->CurrentCell, Explorer->Outputmap.Stride, Step);
+    }
+
+    /*update output map status*/
+    voidUpdateOutputMap(Explorer);
+
+    /*Trace Current output map status*/
+    voidTraceStep(Explorer);
+
+    /*position to next cell based on searching algorithm */
+    voidTakeAction(Explorer);
+
+    if( NULL != Explorer->Monitor )
+    {
+        MONITOR_END(Explorer->Monitor, Explorer->CurrentCell, Step);
+    }
+
+#if MAP_TILED == TRUE
+    /*a tile that could not be read or written back stops the search*/
+    if( ERROR_NONE == Explorer->Error )
+    {
+        Explorer->Error = u8TiledMapError(&Explorer->Inputmap);
+    }
+    if( ERROR_NONE == Explorer->Error )
+    {
+        Explorer->Error = u8TiledMapError(&Explorer->Outputmap);
+    }
+#endif
+    if( ERROR_NONE != Explorer->Error )
+    {
+        return Explorer->Error;
+    }
+
+    /*write checkpoint when it is due*/
+    if( (NULL != Explorer->Checkpoint) && (Explorer->VisitedCells >= Explorer->Checkpoint->NextCheck) )
+    {
+        voidWriteCheckpoint(Explorer);
+    }
+
+#if SEARCH_STATS == TRUE
+    /*dump counters asked for by caller (SIGUSR1)*/
+    if( (NULL != Explorer->StatsDumpRequest) && (0 != *Explorer->StatsDumpRequest) )
+    {
+        *Explorer->StatsDumpRequest = 0;
+        /*a counters file that can not be written does not stop the search , next request writes it again*/
+        u8DumpStats(Explorer);
+    }
+#endif
+
+    return (TRUE == Explorer->DeadendCondition) ? STEP_DONE : ERROR_NONE;
+
+}/*end of u8StepSearch();*/
+
+/*this function moves explorer from its current cell until dead end is reached , it is the searching loop
+ *of u8SearchMap(); and walks newly reachable cells after map changes
+ *Arguments : pointer to explorer with current cell set
+ *Return    : ERROR_NONE once dead end is reached or error that stopped the search (see u8StepSearch();) */
+u8 u8WalkMap(explorer *Explorer)
+{
+    u8 Result;
+
+#if (MAP_FIXED_WIDTH != 0) && (SEARCH_STATS == FALSE)
+    /*maps of fixed size take the searching loop with constant offsets unless a step has more to do*/
+    if( (MAP_FIXED_WIDTH == Explorer->Outputmap.Width) && (MAP_FIXED_HEIGHT == Explorer->Outputmap.Height) &&
+        (Explorer->TraceLevel < TRACE_DELTAS) && (NULL == Explorer->Source) &&
+        (NULL == Explorer->Monitor) && (NULL == Explorer->Checkpoint) && (NULL == Explorer->Summary) )
+    {
+        return u8WalkFixedMap(Explorer);
+    }
+#endif
+
+    /*loop searching steps until dead end is reached*/
+    while( ERROR_NONE == (Result = u8StepSearch(Explorer)) )
+    {
+    }
+
+    return (STEP_DONE == Result) ? ERROR_NONE : Result;
+
+}/*end of u8WalkMap();*/
+
+#if MAP_FIXED_WIDTH != 0
+/*this function is the searching loop of u8WalkMap(); for MAP_FIXED_WIDTH x MAP_FIXED_HEIGHT maps searched
+ *without step trace , cell source , monitor , checkpoints or search counters , surrounding cell offsets are
+ *constants and a step does the work of voidUpdateOutputMap(); and voidTakeAction(); without calls except
+ *at dead ends so it takes the same moves
+ *Arguments : pointer to explorer with current cell set
+ *Return    : ERROR_NONE once dead end is reached or error that stopped the search */
+static u8 u8WalkFixedMap(explorer *Explorer)
+{
+    cellmap *map = &Explorer->Outputmap;
+    /*Surrounding cells offsets in move order right , up , low , left (unsigned wrap gives negative offsets)*/
+    const u32 Offsets[4] = {1, MAP_FIXED_STRIDE, 0u - MAP_FIXED_STRIDE, 0u - 1};
+
+    while( FALSE == Explorer->DeadendCondition )
+    {
+        u32 Cell = Explorer->CurrentCell;
+        u8  AvailableMask = 0;
+
+        /*update current cell status to CURRENT_POSITION , explorer may have moved to a frontier cell*/
+        Explorer->FrontierCells -= (u32)(DISCOVERED_NOT_MINE == MAP_GET(map, Cell));
+        MAP_SET(map, Cell, CURRENT_LOCATION);
+
+        /*Update Surrounding Cells status the way voidUpdateOutputMap(); does*/
+        for(u8 i = 0; i < 4; i++)
+        {
+            u8  Move      = UpdateOrder[i];
+            u32 Index     = Cell + Offsets[Move];
+            u8  OldStatus = MAP_GET(map, Index);
+            u8  Input     = MAP_GET(&Explorer->Inputmap, Index);
+            u8  Visited   = (VISITED == OldStatus);
+            u8  Available = (u8)((Visited ^ 1) & (NOT_MINE == Input));
+            u8  Status    = (u8)((Input & (u8)(Visited - 1)) | (VISITED & (u8)(0u - Visited)));
+            Status        = (u8)((Status & (u8)(Available - 1)) | (DISCOVERED_NOT_MINE & (u8)(0u - Available)));
+
+            Explorer->FrontierCells += (u32)Available - (u32)(DISCOVERED_NOT_MINE == OldStatus);
+#if MAP_TILED == TRUE
+            if( Status != OldStatus )
+            {
+                MAP_SET(map, Index, Status);
+            }
+#else
+            MAP_SET(map, Index, Status);
+#endif
+            AvailableMask |= (u8)(Available << Move);
+        }
+        Explorer->AvailableMask = AvailableMask;
+        if( (AvailableCount[AvailableMask] > 1) && (PLANNER_NEAREST != Explorer->Planner) &&
+            (ERROR_NONE != u8PushBranch(Explorer, Cell)) )
+        {
+            return Explorer->Error;
+        }
+
+        /*Goto first available cell in move order , dead ends are left by voidTakeAction();*/
+        if( 0 != AvailableMask )
+        {
+            MAP_SET(map, Cell, VISITED);
+            Explorer->CurrentCell = Cell + Offsets[NextMove[AvailableMask]];
+            Explorer->VisitedCells++;
+        }
+        else
+        {
+            voidTakeAction(Explorer);
+            if( ERROR_NONE != Explorer->Error )
+            {
+                return Explorer->Error;
+            }
+        }
+    }
+
+    return ERROR_NONE;
+
+}/*end of u8WalkFixedMap();*/
+#endif
+
+/*this function prints final result of a search done by u8SearchMap();
+ *Arguments : pointer to explorer
+ *Return    : ERROR_NONE , ERROR_CHECK if visited cells are not the reachable cells found before search (FRONTIER_CHECK) */
+u8 u8PrintSearchResults(explorer *Explorer)
+{
+    u8 Error = ERROR_NONE;
+
+    /*=============================================*/
+    /*Print final result of search*/
+    /*=============================================*/
+
+    /*print number of steps taken to search map*/
+    /*=============================================*/
+    fprintf(Explorer->TraceFile, "Map Searched in %u Steps\n"
+                       "==============================\n",Explorer->VisitedCells);
+
+    /*print number of cells driven , back propagation jumps are only measured by a planner*/
+    /*=============================================*/
+    if( PLANNER_OFF != Explorer->Planner )
+    {
+        fprintf(Explorer->TraceFile, "Travel distance : %llu cells , back propagations %u , route cells %llu\n"
+                           "==============================\n",
+                u64TravelCells(Explorer), Explorer->Backtracks, Explorer->RouteCells);
+    }
+
+    /*print maximum number of branch points saved at the same time*/
+    /*=============================================*/
+    fprintf(Explorer->TraceFile, "Branch stack high water mark : %u\n"
+                       "==============================\n",Explorer->BranchStack.HighWater);
+
+#if MAP_TILED == TRUE
+    /*print tile cache counters of both maps*/
+    /*=============================================*/
+    fprintf(Explorer->TraceFile, "Input map tiles : hits %llu , misses %llu\n"
+                       "Output map tiles : hits %llu , misses %llu , write backs %llu\n"
+                       "==============================\n",
+            Explorer->Inputmap.Tiles->Hits, Explorer->Inputmap.Tiles->Misses,
+            Explorer->Outputmap.Tiles->Hits, Explorer->Outputmap.Tiles->Misses, Explorer->Outputmap.Tiles->WriteBacks);
+#endif
+
+    /*print number of cells reachable from entry point when it was analysed before search ,
+     *search visits all of them and ends at last one since frontier counter reaches 0 there*/
+    /*=============================================*/
+    if( 0 != Explorer->ReachableCells )
+    {
+        fprintf(Explorer->TraceFile, "Entry cell : %u %u , reachable cells : %u\n"
+                           "==============================\n",
+                Explorer->EntryCell / Explorer->Inputmap.Stride, Explorer->EntryCell % Explorer->Inputmap.Stride,
+                Explorer->ReachableCells);
+#if FRONTIER_CHECK == TRUE
+        if( u32CountStatus(&Explorer->Outputmap, VISITED) != Explorer->ReachableCells )
+        {
+            Error = ERROR_CHECK;
+        }
+#endif
+    }
+
+    /*print number of visited cells and discovered mines*/
+    /*=============================================*/
+    fprintf(Explorer->TraceFile, "Visited cells : %u , Discovered mines : %u\n"
+                       "==============================\n",
+            u32CountStatus(&Explorer->Outputmap, VISITED), u32CountStatus(&Explorer->Outputmap, MINE));
+
+
+    if( Explorer->TraceLevel >= TRACE_SUMMARY )
+    {
+        /*Print original input map*/
+        /*=============================================*/
+        fprintf(Explorer->TraceFile, "Original Input Map\n"
+                           "==============================\n");
+        voidPrintMap(Explorer->TraceFile, &Explorer->Inputmap);
+
+        /*Print final output map*/
+        /*=============================================*/
+        fprintf(Explorer->TraceFile, "Final Output Map\n"
+                           "==============================\n");
+        voidPrintMap(Explorer->TraceFile, &Explorer->Outputmap);
+    }
+
+    return Error;
+
+}/*end of u8PrintSearchResults();*/
+
+/*this function finds number of cells driven by a search , every move to a neighbor cell and every
+ *cell of back propagation routes , it is only known when a planner measures routes
+ *Arguments : pointer to explorer
+ *Return    : number of cells driven */
+u64 u64TravelCells(explorer *Explorer)
+{
+    /*first step is entry cell and every back propagation step is replaced by its route*/
+    if( 0 == Explorer->VisitedCells )
+    {
+        return 0;
+    }
+    return (u64)(Explorer->VisitedCells - 1 - Explorer->Backtracks) + Explorer->RouteCells;
+
+}/*end of u64TravelCells();*/
+
+/*this function writes search counters of an explorer as JSON or Prometheus text to counters file
+ *(rewritten every dump) or to stderr
+ *Arguments : pointer to explorer
+ *Return    : ERROR_NONE , ERROR_OPEN_FILE or ERROR_WRITE_FILE */
+u8 u8DumpStats(explorer *Explorer)
+{
+    const searchstats *Stats = &Explorer->Stats;
+    const char *Directions[4]        = {"right", "up", "low", "left"};
+    const char *Phases[STATS_PHASES] = {"update_output_map", "take_action", "back_propagate", "frontier_scan", "print"};
+    u64  Times[STATS_PHASES];
+    FILE *File = (NULL == Explorer->StatsFileName) ? stderr : fopen(Explorer->StatsFileName, "w");
+
+    if( NULL == File )
+    {
+        return ERROR_OPEN_FILE;
+    }
+
+    /*estimate phase times from timed steps , without time of clock reads*/
+    for(u8 p = 0; p < STATS_PHASES; p++)
+    {
+        u64 Sampled = Stats->SampledTime[p];
+        u64 Clock   = Stats->SampledCalls[p] * Explorer->StatsClockCost;
+
+        Sampled  = (Sampled > Clock) ? (Sampled - Clock) : 0;
+        Times[p] = (0 == Stats->SampledCalls[p]) ? 0 :
+                   (u64)((double)Sampled * (double)Stats->Calls[p] / (double)Stats->SampledCalls[p]);
+    }
+
+    if( STATS_FORMAT_JSON == Explorer->StatsFormat )
+    {
+        fprintf(File, "{\"steps\" : %u, \"moves\" : {", Explorer->VisitedCells);
+        for(u8 d = 0; d < 4; d++)
+        {
+            fprintf(File, "%s\"%s\" : %llu", (0 == d) ? "" : ", ", Directions[d], Stats->Moves[d]);
+        }
+        fprintf(File, "}, \"backtracks\" : %u, \"branch_stack_high_water\" : %u, \"frontier_scan_cells\" : %llu, "
+                      "\"sample_period\" : %u,\n \"phases\" : {",
+                Explorer->Backtracks, Explorer->BranchStack.HighWater, Stats->ScanCells, STATS_SAMPLE_PERIOD);
+        for(u8 p = 0; p < STATS_PHASES; p++)
+        {
+            fprintf(File, "%s\"%s\" : {\"calls\" : %llu, \"ns\" : %llu}", (0 == p) ? "" : ", ", Phases[p], Stats->Calls[p], Times[p]);
+        }
+        fprintf(File, "}}\n");
+    }
+    else
+    {
+        fprintf(File, "# TYPE gps_search_steps_total counter\ngps_search_steps_total %u\n", Explorer->VisitedCells);
+        fprintf(File, "# TYPE gps_moves_total counter\n");
+        for(u8 d = 0; d < 4; d++)
+        {
+            fprintf(File, "gps_moves_total{direction=\"%s\"} %llu\n", Directions[d], Stats->Moves[d]);
+        }
+        fprintf(File, "# TYPE gps_backtracks_total counter\ngps_backtracks_total %u\n", Explorer->Backtracks);
+        fprintf(File, "# TYPE gps_branch_stack_high_water gauge\ngps_branch_stack_high_water %u\n", Explorer->BranchStack.HighWater);
+        fprintf(File, "# TYPE gps_frontier_scan_cells_total counter\ngps_frontier_scan_cells_total %llu\n", Stats->ScanCells);
+        fprintf(File, "# TYPE gps_phase_calls_total counter\n");
+        for(u8 p = 0; p < STATS_PHASES; p++)
+        {
+            fprintf(File, "gps_phase_calls_total{phase=\"%s\"} %llu\n", Phases[p], Stats->Calls[p]);
+        }
+        fprintf(File, "# TYPE gps_phase_seconds_total counter\n");
+        for(u8 p = 0; p < STATS_PHASES; p++)
+        {
+            fprintf(File, "gps_phase_seconds_total{phase=\"%s\"} %.9f\n", Phases[p], (double)Times[p] / 1e9);
+        }
+    }
+
+    if( stderr == File )
+    {
+        return (0 == fflush(File)) ? ERROR_NONE : ERROR_WRITE_FILE;
+    }
+    return (0 == fclose(File)) ? ERROR_NONE : ERROR_WRITE_FILE;
+
+}/*end of u8DumpStats();*/
+
+/*this function responsible for changing output map cell's status based on discovered input map cells
+ *it also saves last available cell coordinates in case the algorithm got stuck in a dead end rout
+ *it could reposition itself to a cell that has available routs
+ *ie cells that is surrounded by more than one NOT_MINE Cells
+ *
+ *Arguments : pointer to explorer
+ *Return    : void */
+static void voidUpdateOutputMap(explorer *Explorer)
+{
+    cellmap *map = &Explorer->Outputmap;
+    /*Surrounding cells offsets in move order right , up , low , left (unsigned wrap gives negative offsets)*/
+    const u32 Offsets[4] = {1, map->Stride, 0u - map->Stride, 0u - 1};
+    /*available surrounding cells , bit d is set if cell of move d is DISCOVERED_NOT_MINE*/
+    u8 AvailableMask = 0;
+    STATS_START(Explorer, StatsStart);
+
+    /*=====================================================================================*/
+    /*update current cell status to CURRENT_POSITION*/
+    voidSetOutputStatus(Explorer, Explorer->CurrentCell, CURRENT_LOCATION);
+
+    /*start sensor reads of unknown cells around current cell , cells probed ahead at earlier steps are
+     *already being read so explorer only waits for the rest*/
+    if( NULL != Explorer->Source )
+    {
+        voidProbeCells(Explorer, 1 + Explorer->ProbeAhead);
+    }
+
+    /*=====================================================================================*/
+    /*Update Surrounding Cells status in right , left , up , low order (order cells are read from cell source)
+     *VISTED cells keep their status , other cells take their input map status and NOT_MINE cells become
+     *DISCOVERED_NOT_MINE , new status and frontier counter are worked out without branches on cell status*/
+    for(u8 i = 0; i < 4; i++)
+    {
+        u8  Move      = UpdateOrder[i];
+        u32 Index     = Explorer->CurrentCell + Offsets[Move];
+        u8  OldStatus = MAP_GET(map, Index);
+        /*a VISITED cell reads VISITED from cell source without a sensor read*/
+        u8  Input     = INPUT_CELL(Explorer, Index);
+        u8  Visited   = (VISITED == OldStatus);
+        u8  Available = (u8)((Visited ^ 1) & (NOT_MINE == Input));
+        /*statuses are selected with masks (0x00 or 0xFF) as compilers turn selects on them into branches*/
+        u8  Status    = (u8)((Input & (u8)(Visited - 1)) | (VISITED & (u8)(0u - Visited)));
+        Status        = (u8)((Status & (u8)(Available - 1)) | (DISCOVERED_NOT_MINE & (u8)(0u - Available)));
+
+        if( (TRACE_DELTAS == Explorer->TraceLevel) && (Status != OldStatus) )
+        {
+            voidTraceCellChange(Explorer, Index, OldStatus);
+        }
+        Explorer->FrontierCells += (u32)Available - (u32)(DISCOVERED_NOT_MINE == OldStatus);
+        if( NULL != Explorer->Summary )
+        {
+            voidUpdateSummary(Explorer->Summary, Index, OldStatus, Status);
+        }
+#if MAP_TILED == TRUE
+        /*a tile is only made dirty by a real change*/
+        if( Status != OldStatus )
+        {
+            MAP_SET(map, Index, Status);
+        }
+#else
+        MAP_SET(map, Index, Status);
+#endif
+        AvailableMask |= (u8)(Available << Move);
+    }
+    Explorer->AvailableMask = AvailableMask;
+
+    /*=====================================================================================*/
+    /* Save Current Coordinates of both maps if this input cell has more than one cell that is
+     * not a mine surrounding it , nearest frontier planner finds its way back without them*/
+    if( (AvailableCount[AvailableMask] > 1) && (PLANNER_NEAREST != Explorer->Planner) )
+    {
+        /*Save current cell position (same index in both maps) in branch stack , a failure
+         *stops the search once this step is done*/
+        u8PushBranch(Explorer, Explorer->CurrentCell);
+    }
+
+    STATS_PHASE(Explorer, PHASE_UPDATE, StatsStart);
+
+}/*end of voidUpdateOutputMap()*/
+
+/*this function reads input map status of a surrounding cell of current cell from cell source of explorer ,
+ *cells already known from output map are not read again (INPUT_CELL() reads input map without cell source)
+ *Arguments : pointer to explorer with cell source , cell index
+ *Return    : input map status of cell */
+static u8 u8ReadInputCell(explorer *Explorer, u32 Index)
+{
+    u8 Status = MAP_GET(&Explorer->Outputmap, Index);
+
+    if( NOT_DISCOVERED == Status )
+    {
+        return Explorer->Source->Read(Explorer->Source, Index);
+    }
+    /*borders and mines are copied as they are , discovered cells are NOT_MINE cells*/
+    return (DISCOVERED_NOT_MINE == Status) ? NOT_MINE : Status;
+
+}/*end of u8ReadInputCell()*/
+
+/*this function probes NOT_DISCOVERED cells up to a number of moves from current cell in one cell source probe
+ *Arguments : pointer to explorer with cell source , number of moves (1 for surrounding cells)
+ *Return    : void */
+static void voidProbeCells(explorer *Explorer, u32 Moves)
+{
+    cellmap *map = &Explorer->Outputmap;
+    u32 Row = Explorer->CurrentCell / map->Stride;
+    u32 Col = Explorer->CurrentCell % map->Stride;
+    /*rows and columns of cells up to Moves away , clipped to map borders*/
+    u32 FirstRow = (Row > Moves) ? (Row - Moves) : 0;
+    u32 LastRow  = ((Row + Moves) > (map->Height+1)) ? (map->Height+1) : (Row + Moves);
+    u32 Cells[PROBE_CELLS];
+    u32 Count = 0;
+
+    for(u32 i = FirstRow; i <= LastRow; i++)
+    {
+        u32 Span     = Moves - ((i > Row) ? (i - Row) : (Row - i));
+        u32 FirstCol = (Col > Span) ? (Col - Span) : 0;
+        u32 LastCol  = ((Col + Span) > (map->Width+1)) ? (map->Width+1) : (Col + Span);
+
+        for(u32 j = FirstCol; j <= LastCol; j++)
+        {
+            if( NOT_DISCOVERED == MAP_CELL(map, i, j) )
+            {
+                Cells[Count++] = i*map->Stride + j;
+            }
+        }
+    }
+
+    if( 0 != Count )
+    {
+        Explorer->Source->Probe(Explorer->Source, Cells, Count);
+    }
+
+}/*end of voidProbeCells()*/
+
+/*this function contain the algorithm used for decision making based on surrounding cell status
+ *it decide which cell should be visited next from available cells found by voidUpdateOutputMap();
+ *Arguments : pointer to explorer
+ *Return    : void */
+static void voidTakeAction(explorer *Explorer)
+{
+    STATS_START(Explorer, StatsStart);
+
+    /*Algorithm sequence is
+    * Go to right cell if available if not
+    * Go to upper cell if available if not
+    * Go to Lower cell if available if not
+    * Go to Left cell if available if not
+    * if all surrounding cells are not available (ie mine or border or already visited)
+    * Go to last available cell (last cell that had more than one cell that were not a mine)
+    * that is done by voidBackPropagate(); function
+    * available cells were found by voidUpdateOutputMap(); so next move is looked up from their mask*/
+
+    /*======================================================================================*/
+    /*======================================================================================*/
+    /*Check surrounding cells availability (DISCOVERED_NOT_MINE)*/
+    if( 0 != Explorer->AvailableMask )
+    {
+        /*Goto first available cell in move order*/
+        voidGotoCell(Explorer, NextMove[Explorer->AvailableMask]);
+    }
+    /*in that case you are surrounded by mines and discovered cells */
+    else
+    {
+        /*Terminate condition is true if there is no available cell left in output map
+         *frontier counter is kept up to date by voidSetOutputStatus(); so no map scan is needed*/
+        u8 TerminateCondition = (0 == Explorer->FrontierCells) ? TRUE : FALSE;
+
+#if FRONTIER_CHECK == TRUE
+        /*Validate frontier counter against a full output map scan*/
+        /*===================================================================*/
+        u32 ScannedFrontierCells = u32ScanFrontierCells(Explorer);
+        if( (ScannedFrontierCells != Explorer->FrontierCells) ||
+            ((NULL != Explorer->Summary) && (SUMMARY_TOTAL(Explorer->Summary, SUMMARY_FRONTIER) != ScannedFrontierCells)) )
+        {
+            /*search stops where counters went wrong*/
+            Explorer->Error = ERROR_CHECK;
+            return;
+        }
+#endif
+
+        /*Termination condition check*/
+        if ( (TRUE == TerminateCondition) ||
+             ((PLANNER_NEAREST != Explorer->Planner) && (0 == Explorer->BranchStack.Size)) )
+        {
+            /*if there are no available moves or there are no cells that has not
+             *a mine in it (all map is either visited or a mine)
+             *then terminate Search and Mark Current cell VISITED*/
+            voidSetOutputStatus(Explorer, Explorer->CurrentCell, VISITED);
+            /*make dead end condition true*/
+            Explorer->DeadendCondition = TRUE;
+
+        }
+        else
+        {
+            /*Notify Back propagation event*/
+            if( Explorer->TraceLevel >= TRACE_DELTAS )
+            {
+                fprintf(Explorer->TraceFile, "Back propagation happened\n");
+            }
+            /*go to last available cell*/
+            voidBackPropagate(Explorer);
+        }/*end of termination condition check*/
+
+    }/*end of surrounding cells availability check */
+
+    STATS_PHASE(Explorer, PHASE_ACTION, StatsStart);
+    /*======================================================================================*/
+    /*======================================================================================*/
+}/*end of voidTakeAction();*/
+
+/*this function reposition current cell position to last available cell so that search algorithm can take new rout
+ *nearest frontier planner repositions it to nearest DISCOVERED_NOT_MINE cell instead
+ *Arguments : pointer to explorer
+ *Return    : void */
+static void voidBackPropagate(explorer *Explorer)
+{
+    /*length of route driven to new position*/
+    u32 Length = 0;
+    STATS_START(Explorer, StatsStart);
+
+    /*Mark current cell visited then reposition to last available cell*/
+    /*========================================================*/
+    /*Mark Current cell VISITED*/
+    voidSetOutputStatus(Explorer, Explorer->CurrentCell, VISITED);
+    if( PLANNER_NEAREST == Explorer->Planner )
+    {
+        /*reposition current position for both maps to nearest frontier cell , there is always
+         *one because every frontier cell was discovered next to a visited cell so no route
+         *means route search memory could not be allocated (explorer Error)*/
+        u32 Next = u32FindRoute(Explorer, 0, &Length);
+        if( 0 == Next )
+        {
+            return;
+        }
+        Explorer->CurrentCell = Next;
+    }
+    else
+    {
+        /*measure route back to last available position before it is taken*/
+        if( PLANNER_MEASURE == Explorer->Planner )
+        {
+            u32FindRoute(Explorer, Explorer->BranchStack.Entries[Explorer->BranchStack.Size-1], &Length);
+        }
+        /*reposition current position for both maps to last available position
+         *and remove it from branch stack*/
+        /*======================================================================================*/
+        Explorer->CurrentCell = u32PopBranch(Explorer);
+    }
+    Explorer->Backtracks++;
+    Explorer->RouteCells += Length;
+    STATS_PHASE(Explorer, PHASE_BACK_PROPAGATE, StatsStart);
+    /*======================================================================================*/
+
+    /*increment number of visited cells*/
+    /*========================================================*/
+    Explorer->VisitedCells++;
+
+}/*end of voidBackPropagate();*/
+
+/*this function finds shortest route over VISITED cells from current cell to a target cell or to the nearest
+ *DISCOVERED_NOT_MINE cell (breadth first search , every move costs one cell)
+ *cell marks are kept between searches and a new search only starts a new mark generation
+ *so every search touches only cells it reaches instead of clearing a whole map
+ *search memory that can not be allocated is kept in explorer Error and no route is found
+ *Arguments : pointer to explorer , target cell index or 0 for nearest DISCOVERED_NOT_MINE cell , pointer that receives route length
+ *Return    : cell index route ends at or 0 if there is no route */
+static u32 u32FindRoute(explorer *Explorer, u32 Target, u32 *Length)
+{
+    cellmap *map = &Explorer->Outputmap;
+    /*neighbor offsets in move order right , up , low , left (unsigned wrap gives negative offsets)*/
+    const u32 Offsets[4] = {1, map->Stride, 0u - map->Stride, 0u - 1};
+    u32 Head = 0;
+    u32 Tail = 0;
+    u32 Distance = 0;
+    u32 Generation;
+
+    *Length = 0;
+    if( Target == Explorer->CurrentCell )
+    {
+        return Target;
+    }
+
+    Generation = u32NewRouteGenerations(Explorer, 1);
+    if( 0 == Generation )
+    {
+        return 0;
+    }
+    Explorer->RouteMarks[Explorer->CurrentCell] = Generation;
+    if( 0 == Explorer->RouteQueueCapacity )
+    {
+#if MAP_ARENA == TRUE
+        /*a cell is queued once at most , arena queue is taken at its full size so it never grows*/
+        Explorer->RouteQueue = (u32 *)pvArenaAllocate(Explorer->Arena, (u64)map->Stride * (map->Height+2) * sizeof(u32));
+        if( NULL == Explorer->RouteQueue )
+        {
+            Explorer->Error = ERROR_ARENA_FULL;
+            return 0;
+        }
+        Explorer->RouteQueueCapacity = map->Stride * (map->Height+2);
+#else
+        Explorer->RouteQueue = (u32 *)malloc(BRANCH_STACK_INITIAL_SIZE * sizeof(u32));
+        if( NULL == Explorer->RouteQueue )
+        {
+            Explorer->Error = ERROR_NO_MEMORY;
+            return 0;
+        }
+        Explorer->RouteQueueCapacity = BRANCH_STACK_INITIAL_SIZE;
+#endif
+    }
+    Explorer->RouteQueue[Tail++] = Explorer->CurrentCell;
+
+    /*search one distance layer at a time*/
+    while( Head < Tail )
+    {
+        u32 LayerEnd = Tail;
+        Distance++;
+
+        while( Head < LayerEnd )
+        {
+            u32 Index = Explorer->RouteQueue[Head++];
+
+            for(u8 d = 0; d < 4; d++)
+            {
+                u32 Next = Index + Offsets[d];
+                u8  Status;
+
+                if( Explorer->RouteMarks[Next] == Generation )
+                {
+                    continue;
+                }
+                Explorer->RouteMarks[Next] = Generation;
+                Status = MAP_GET(map, Next);
+
+                if( (Next == Target) || ((0 == Target) && (DISCOVERED_NOT_MINE == Status)) )
+                {
+                    *Length = Distance;
+                    return Next;
+                }
+                if( VISITED == Status )
+                {
+#if MAP_ARENA == FALSE
+                    /*Grow queue by doubling its capacity*/
+                    if( Tail == Explorer->RouteQueueCapacity )
+                    {
+                        u32 NewCapacity = Explorer->RouteQueueCapacity * 2;
+                        u32 *NewQueue   = (u32 *)realloc(Explorer->RouteQueue, (size_t)NewCapacity * sizeof(u32));
+
+                        if( NULL == NewQueue )
+                        {
+                            Explorer->Error = ERROR_NO_MEMORY;
+                            return 0;
+                        }
+                        Explorer->RouteQueue         = NewQueue;
+                        Explorer->RouteQueueCapacity = NewCapacity;
+                    }
+#endif
+                    Explorer->RouteQueue[Tail++] = Next;
+                }
+            }
+        }
+    }
+
+    return 0;
+
+}/*end of u32FindRoute();*/
+
+/*this function starts new route search mark generations , marks are allocated by first call
+ *marks that can not be allocated are kept in explorer Error (ERROR_NO_MEMORY or ERROR_ARENA_FULL)
+ *Arguments : pointer to explorer , number of generations needed
+ *Return    : first new generation , generations up to first+number-1 are new , 0 if marks can not be allocated */
+static u32 u32NewRouteGenerations(explorer *Explorer, u32 Count)
+{
+    cellmap *map = &Explorer->Outputmap;
+
+    /*marks are allocated by first search of explorer*/
+    if( NULL == Explorer->RouteMarks )
+    {
+#if MAP_ARENA == TRUE
+        Explorer->RouteMarks = (u32 *)pvArenaAllocate(Explorer->Arena, (u64)map->Stride * (map->Height+2) * sizeof(u32));
+        if( NULL == Explorer->RouteMarks )
+        {
+            Explorer->Error = ERROR_ARENA_FULL;
+            return 0;
+        }
+        memset(Explorer->RouteMarks, 0, (size_t)map->Stride * (map->Height+2) * sizeof(u32));
+#else
+        Explorer->RouteMarks = (u32 *)calloc((size_t)map->Stride * (map->Height+2), sizeof(u32));
+        if( NULL == Explorer->RouteMarks )
+        {
+            Explorer->Error = ERROR_NO_MEMORY;
+            return 0;
+        }
+#endif
+        Explorer->RouteGeneration = 0;
+    }
+    if( Explorer->RouteGeneration > (0xFFFFFFFF - Count) )
+    {
+        /*generations wrap around , old marks could look like new ones*/
+        memset(Explorer->RouteMarks, 0, (size_t)map->Stride * (map->Height+2) * sizeof(u32));
+        Explorer->RouteGeneration = 0;
+    }
+    Explorer->RouteGeneration += Count;
+
+    return Explorer->RouteGeneration - Count + 1;
+
+}/*end of u32NewRouteGenerations();*/
+
+/*this function releases route search marks and queue
+ *Arguments : pointer to explorer
+ *Return    : void */
+static void voidFreeRoutes(explorer *Explorer)
+{
+#if MAP_ARENA == FALSE
+    free(Explorer->RouteMarks);
+    free(Explorer->RouteQueue);
+#endif
+    Explorer->RouteMarks         = NULL;
+    Explorer->RouteQueue         = NULL;
+    Explorer->RouteQueueCapacity = 0;
+
+}/*end of voidFreeRoutes();*/
+
+/*this function saves a branch point on top of branch stack , stack grows when it is full
+ *a branch point that can not be saved is also kept in explorer Error so the search stops
+ *Arguments : pointer to explorer , cell index of branch point
+ *Return    : ERROR_NONE , ERROR_NO_MEMORY or ERROR_ARENA_FULL (ARENA_BRANCH_POINTS branch points saved) */
+static u8 u8PushBranch(explorer *Explorer, u32 Index)
+{
+    /*Grow stack by doubling its capacity so that push is amortized O(1)*/
+    if( Explorer->BranchStack.Size == Explorer->BranchStack.Capacity )
+    {
+#if MAP_ARENA == TRUE
+        /*arena stack never grows*/
+        Explorer->Error = ERROR_ARENA_FULL;
+        return ERROR_ARENA_FULL;
+#else
+        u32 NewCapacity = (0 == Explorer->BranchStack.Capacity) ? BRANCH_STACK_INITIAL_SIZE : (Explorer->BranchStack.Capacity * 2);
+        u32 *NewEntries = (u32 *)realloc(Explorer->BranchStack.Entries, (size_t)NewCapacity * sizeof(u32));
+
+        if( NULL == NewEntries )
+        {
+            Explorer->Error = ERROR_NO_MEMORY;
+            return ERROR_NO_MEMORY;
+        }
+        Explorer->BranchStack.Entries  = NewEntries;
+        Explorer->BranchStack.Capacity = NewCapacity;
+#endif
+    }
+
+    Explorer->BranchStack.Entries[Explorer->BranchStack.Size] = Index;
+    Explorer->BranchStack.Size++;
+
+    /*Track high water mark*/
+    if( Explorer->BranchStack.Size > Explorer->BranchStack.HighWater )
+    {
+        Explorer->BranchStack.HighWater = Explorer->BranchStack.Size;
+    }
+
+    return ERROR_NONE;
+
+}/*end of u8PushBranch();*/
+
+/*this function removes last saved branch point from branch stack
+ *Arguments : pointer to explorer
+ *Return    : cell index of branch point */
+static u32 u32PopBranch(explorer *Explorer)
+{
+    Explorer->BranchStack.Size--;
+    return Explorer->BranchStack.Entries[Explorer->BranchStack.Size];
+
+}/*end of u32PopBranch();*/
+
+/*this function releases branch stack entries
+ *Arguments : pointer to explorer
+ *Return    : void */
+void voidFreeBranchStack(explorer *Explorer)
+{
+#if MAP_ARENA == FALSE
+    free(Explorer->BranchStack.Entries);
+#endif
+    Explorer->BranchStack.Entries  = NULL;
+    Explorer->BranchStack.Size     = 0;
+    Explorer->BranchStack.Capacity = 0;
+
+}/*end of voidFreeBranchStack();*/
+
+/*this function changes status of an output map cell and keeps number of frontier
+ *(DISCOVERED_NOT_MINE) cells up to date , every output map status change goes through it
+ *Arguments : pointer to explorer , cell index , new status
+ *Return    : void */
+static void voidSetOutputStatus(explorer *Explorer, u32 Index, u8 Status)
+{
+    /*current status of the cell*/
+    u8 OldStatus = MAP_GET(&Explorer->Outputmap,Index);
+
+    /*record change for delta trace*/
+    if( (TRACE_DELTAS == Explorer->TraceLevel) && (Status != OldStatus) )
+    {
+        voidTraceCellChange(Explorer, Index, OldStatus);
+    }
+
+    /*cell leaves frontier*/
+    if( (DISCOVERED_NOT_MINE == OldStatus) && (DISCOVERED_NOT_MINE != Status) )
+    {
+        Explorer->FrontierCells--;
+    }
+    /*cell joins frontier*/
+    else if( (DISCOVERED_NOT_MINE != OldStatus) && (DISCOVERED_NOT_MINE == Status) )
+    {
+        Explorer->FrontierCells++;
+    }
+    if( NULL != Explorer->Summary )
+    {
+        voidUpdateSummary(Explorer->Summary, Index, OldStatus, Status);
+    }
+
+    MAP_SET(&Explorer->Outputmap,Index,Status);
+
+}/*end of voidSetOutputStatus();*/
+
+#if FRONTIER_CHECK == TRUE
+/*this function counts DISCOVERED_NOT_MINE cells by scanning whole output map
+ *it is only used to validate frontier counter in FRONTIER_CHECK mode
+ *Arguments : pointer to explorer
+ *Return    : number of DISCOVERED_NOT_MINE cells */
+static u32 u32ScanFrontierCells(explorer *Explorer)
+{
+    u32 FrontierCells;
+    STATS_START(Explorer, StatsStart);
+
+    Explorer->FrontierRescans++;
+    /*scan entire output map (borders are never DISCOVERED_NOT_MINE)*/
+    FrontierCells = u32CountStatus(&Explorer->Outputmap, DISCOVERED_NOT_MINE);
+
+    STATS_ADD(Explorer, ScanCells, (u64)Explorer->Outputmap.Stride * (Explorer->Outputmap.Height+2));
+    STATS_PHASE(Explorer, PHASE_FRONTIER_SCAN, StatsStart);
+    return FrontierCells;
+
+}/*end of u32ScanFrontierCells();*/
+#endif
+
+/*this function reposition current cell position to a surrounding cell
+ *Arguments : pointer to explorer , move (MOVE_RIGHT , MOVE_UP , MOVE_LOW or MOVE_LEFT)
+ *Return    : void */
+static void voidGotoCell(explorer *Explorer, u8 Move)
+{
+    /*Surrounding cells offsets in move order (unsigned wrap gives negative offsets)*/
+    const u32 Offsets[4] = {1, Explorer->Outputmap.Stride, 0u - Explorer->Outputmap.Stride, 0u - 1};
+
+    /*Mark current cell visited then reposition to surrounding cell*/
+    /*========================================================*/
+    /*Mark Current cell VISITED*/
+    voidSetOutputStatus(Explorer, Explorer->CurrentCell, VISITED);
+    /*Reposition Current Cell index in both maps to surrounding cell*/
+    /*========================================================*/
+    STATS_ADD(Explorer, Moves[Move], 1);
+    Explorer->CurrentCell = Explorer->CurrentCell + Offsets[Move];
+    /*increment number of visited cells*/
+    /*========================================================*/
+    Explorer->VisitedCells++;
+
+}/*end of voidGotoCell()*/
+
+/*this function finds entry point of search , entry point chosen before search if any
+ *otherwise first NOT_MINE cell of first input map row
+ *Arguments : pointer to explorer
+ *Return    : cell index of entry point or 0 if there is none */
+u32 u32FindEntryCell(explorer *Explorer)
+{
+    if( 0 != Explorer->EntryCell )
+    {
+        return Explorer->EntryCell;
+    }
+
+    /*loop first row in input map , last column included*/
+    for(u32 i = 1; i <= (Explorer->Inputmap.Width) ; i++)
+    {
+        /*first row check*/
+        if( NOT_MINE == MAP_CELL(&Explorer->Inputmap,1,i) )
+        {
+            return 1*Explorer->Inputmap.Stride + i;
+
+        }/*end of first row check*/
+
+    }/*end of for loop*/
+
+    return 0;
+
+}/*end of u32FindEntryCell()*/
+
+/*this function analyses reachability of input map before search , NOT_MINE cells are joined into
+ *connected components (union find) and the first row cell whose component is largest is chosen
+ *as entry point , number of cells reachable from it is kept in explorer
+ *Arguments : pointer to explorer , pointer that receives cell index of chosen entry point or 0 if first row is full of mines
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY */
+u8 u8FindBestEntryCell(explorer *Explorer, u32 *Entry)
+{
+    cellmap *map = &Explorer->Inputmap;
+    u64 Cells = (u64)map->Stride * (map->Height+2);
+    u32 *Parent = (u32 *)malloc((size_t)Cells * sizeof(u32));
+    u32 *Size   = (u32 *)malloc((size_t)Cells * sizeof(u32));
+    u32 Best = 0;
+
+    if( (NULL == Parent) || (NULL == Size) )
+    {
+        free(Parent);
+        free(Size);
+        return ERROR_NO_MEMORY;
+    }
+
+    /*every cell starts as its own set*/
+    for(u32 i = 0; i < Cells; i++)
+    {
+        Parent[i] = i;
+        Size[i]   = 1;
+    }
+
+    /*join every NOT_MINE cell with its right and lower NOT_MINE neighbors , smaller set goes under larger*/
+    for(u32 Row = 1; Row <= map->Height; Row++)
+    {
+        for(u32 Col = 1; Col <= map->Width; Col++)
+        {
+            u32 Index = Row*map->Stride + Col;
+            const u32 Neighbors[2] = {Index + 1, Index + map->Stride};
+
+            if( NOT_MINE != MAP_GET(map, Index) )
+            {
+                continue;
+            }
+            for(u8 n = 0; n < 2; n++)
+            {
+                if( NOT_MINE == MAP_GET(map, Neighbors[n]) )
+                {
+                    u32 Root1 = u32FindRoot(Parent, Index);
+                    u32 Root2 = u32FindRoot(Parent, Neighbors[n]);
+
+                    if( Root1 != Root2 )
+                    {
+                        if( Size[Root1] < Size[Root2] )
+                        {
+                            u32 Swap = Root1;
+                            Root1 = Root2;
+                            Root2 = Swap;
+                        }
+                        Parent[Root2] = Root1;
+                        Size[Root1]  += Size[Root2];
+                    }
+                }
+            }
+        }
+    }
+
+    /*entry candidates are NOT_MINE cells of first row , first of equal candidates wins*/
+    Explorer->ReachableCells = 0;
+    for(u32 Col = 1; Col <= map->Width; Col++)
+    {
+        u32 Index = 1*map->Stride + Col;
+
+        if( (NOT_MINE == MAP_GET(map, Index)) && (Size[u32FindRoot(Parent, Index)] > Explorer->ReachableCells) )
+        {
+            Best = Index;
+            Explorer->ReachableCells = Size[u32FindRoot(Parent, Index)];
+        }
+    }
+
+    free(Parent);
+    free(Size);
+    *Entry = Best;
+    return ERROR_NONE;
+
+}/*end of u8FindBestEntryCell()*/
+
+/*this function finds root of a union find set and halves path to it on the way
+ *Arguments : union find parent array , cell index
+ *Return    : cell index of root */
+static u32 u32FindRoot(u32 *Parent, u32 Index)
+{
+    while( Parent[Index] != Index )
+    {
+        Parent[Index] = Parent[Parent[Index]];
+        Index = Parent[Index];
+    }
+    return Index;
+
+}/*end of u32FindRoot()*/
+
+/*this function reads a monotonic clock
+ *Arguments : void
+ *Return    : time in nanoseconds */
+u64 u64ReadClock(void)
+{
+    struct timespec Time;
+
+#if defined(_WIN32)
+    timespec_get(&Time, TIME_UTC);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &Time);
+#endif
+    return (u64)Time.tv_sec * 1000000000ULL + (u64)Time.tv_nsec;
+
+}/*end of u64ReadClock()*/
+
+/*this function searches input map with parallel explorers that share one output map
+ *every reachable NOT_MINE cell is claimed by exactly one explorer which explores it , it is a flood fill
+ *and not u8WalkMap(); walker , cells are explored in another order and there are no backtracking steps
+ *explorers that can not be started leave their cells to the others so output map is still filled
+ *Arguments : pointer to explorer whose input map is searched ,
+ *            pointer to output map initialized by voidInitializeMap(); , number of explorers ,
+ *            entry cell index , pointer that receives total number of stolen cells
+ *Return    : ERROR_NONE , ERROR_NO_MEMORY (output map is then not complete) , ERROR_THREAD (or number of
+ *            explorers is 0) or ERROR_MAP_SIZE (MAP_PACKED and MAP_TILED maps have no byte per cell) */
+u8 u8ParallelSearch(explorer *Explorer, cellmap *map, u32 Threads, u32 EntryCell, u64 *Steals)
+{
+    *Steals = 0;
+    if( 0 == Threads )
+    {
+        return ERROR_THREAD;
+    }
+    if( 0 == EntryCell )
+    {
+        return ERROR_NONE;
+    }
+
+#if (MAP_PACKED == TRUE) || (MAP_TILED == TRUE)
+    /*explorers claim cells of maps with one byte per cell*/
+    (void)Explorer;
+    (void)map;
+    return ERROR_MAP_SIZE;
+#elif defined(_WIN32)
+    (void)Explorer;
+    (void)map;
+    return ERROR_THREAD;
+#else
+    /*state shared by explorers of this search only , other searches may run at the same time*/
+    parallelsearch Search;
+    worker    *Workers;
+    pthread_t *Thread = (pthread_t *)malloc((size_t)Threads * sizeof(pthread_t));
+    u32       Started = 1;
+    u8        Error   = ERROR_NONE;
+
+    Workers = (worker *)aligned_alloc(CACHE_LINE_SIZE, (((size_t)Threads * sizeof(worker) + CACHE_LINE_SIZE - 1) & ~(size_t)(CACHE_LINE_SIZE - 1)));
+    if( (NULL == Thread) || (NULL == Workers) )
+    {
+        free(Thread);
+        free(Workers);
+        return ERROR_NO_MEMORY;
+    }
+    Search.Workers         = Workers;
+    Search.NumberOfWorkers = Threads;
+    Search.Inputmap        = &Explorer->Inputmap;
+    Search.Map             = map;
+    atomic_init(&Search.Error, ERROR_NONE);
+
+    for(u32 i = 0; i < Threads; i++)
+    {
+        workarray *Array = (workarray *)malloc(sizeof(workarray) + WORK_DEQUE_INITIAL_SIZE * sizeof(atomic_uint));
+        if( NULL == Array )
+        {
+            while( i > 0 )
+            {
+                i--;
+                free(atomic_load(&Workers[i].Array));
+            }
+            free(Workers);
+            free(Thread);
+            return ERROR_NO_MEMORY;
+        }
+        Array->Capacity = WORK_DEQUE_INITIAL_SIZE;
+        Array->Previous = NULL;
+        atomic_init(&Workers[i].Top, 0);
+        atomic_init(&Workers[i].Bottom, 0);
+        atomic_init(&Workers[i].Array, Array);
+        Workers[i].Search       = &Search;
+        Workers[i].Number       = i;
+        Workers[i].Seed         = 2654435761u * (i + 1);
+        Workers[i].VisitedCells = 0;
+        Workers[i].Steals       = 0;
+    }
+
+    /*first explorer starts from entry cell , others start by stealing*/
+    map->Status[EntryCell] = DISCOVERED_NOT_MINE;
+    atomic_init(&Search.PendingCells, 1);
+    /*first deque array has room for entry cell*/
+    u8PushWork(&Workers[0], EntryCell);
+
+    /*calling thread is explorer 0 , explorers that are not started have empty deques*/
+    while( Started < Threads )
+    {
+        if( 0 != pthread_create(&Thread[Started], NULL, pvExploreWorker, &Workers[Started]) )
+        {
+            Error = ERROR_THREAD;
+            break;
+        }
+        Started++;
+    }
+    pvExploreWorker(&Workers[0]);
+    for(u32 i = 1; i < Started; i++)
+    {
+        pthread_join(Thread[i], NULL);
+    }
+
+    /*release deques including arrays replaced while growing*/
+    for(u32 i = 0; i < Threads; i++)
+    {
+        workarray *Array = atomic_load(&Workers[i].Array);
+        while( NULL != Array )
+        {
+            workarray *Previous = Array->Previous;
+            free(Array);
+            Array = Previous;
+        }
+        *Steals += Workers[i].Steals;
+    }
+    free(Workers);
+    free(Thread);
+    if( ERROR_NONE != atomic_load(&Search.Error) )
+    {
+        Error = atomic_load(&Search.Error);
+    }
+    return Error;
+#endif
+
+}/*end of u8ParallelSearch()*/
+
+/*this function fills output map like u8ParallelSearch(); does with one explorer and no deque , it is the
+ *serial baseline parallel search is timed against , like parallel search it explores every reachable cell
+ *once depth first and does not take walker moves (no backtracking steps) , so cells are explored in
+ *another order than u8WalkMap(); and their number is not its step count
+ *Arguments : pointer to explorer whose input map is searched ,
+ *            pointer to output map initialized by voidInitializeMap(); , entry cell index ,
+ *            pointer that receives number of explored cells
+ *Return    : ERROR_NONE , ERROR_NO_MEMORY (output map is then not complete) or ERROR_MAP_SIZE (MAP_PACKED and
+ *            MAP_TILED maps have no byte per cell) */
+u8 u8SerialFill(explorer *Explorer, cellmap *map, u32 EntryCell, u32 *Explored)
+{
+    *Explored = 0;
+    if( 0 == EntryCell )
+    {
+        return ERROR_NONE;
+    }
+
+#if (MAP_PACKED == TRUE) || (MAP_TILED == TRUE)
+    /*fill reads and writes maps with one byte per cell*/
+    (void)Explorer;
+    (void)map;
+    return ERROR_MAP_SIZE;
+#else
+    const u8 *Input = Explorer->Inputmap.Status;
+    u32 *Stack;
+    u32 Capacity = WORK_DEQUE_INITIAL_SIZE;
+    u32 Size     = 0;
+
+    Stack = (u32 *)malloc((size_t)Capacity * sizeof(u32));
+    if( NULL == Stack )
+    {
+        return ERROR_NO_MEMORY;
+    }
+
+    map->Status[EntryCell] = DISCOVERED_NOT_MINE;
+    Stack[Size++] = EntryCell;
+    while( 0 != Size )
+    {
+        u32 Index = Stack[--Size];
+        /*same neighbor order as voidExploreCell();*/
+        u32 Neighbors[4] = {Index - 1, Index - map->Stride, Index + map->Stride, Index + 1};
+
+        for(u8 i = 0; i < 4; i++)
+        {
+            u32 Cell = Neighbors[i];
+
+            if( NOT_MINE != Input[Cell] )
+            {
+                map->Status[Cell] = Input[Cell];
+            }
+            else if( NOT_DISCOVERED == map->Status[Cell] )
+            {
+                /*grow stack by doubling its capacity*/
+                if( Size == Capacity )
+                {
+                    u32 *NewStack = (u32 *)realloc(Stack, (size_t)Capacity * 2 * sizeof(u32));
+                    if( NULL == NewStack )
+                    {
+                        free(Stack);
+                        return ERROR_NO_MEMORY;
+                    }
+                    Stack     = NewStack;
+                    Capacity *= 2;
+                }
+                map->Status[Cell] = DISCOVERED_NOT_MINE;
+                Stack[Size++] = Cell;
+            }
+        }
+        map->Status[Index] = VISITED;
+        (*Explored)++;
+    }
+
+    free(Stack);
+    return ERROR_NONE;
+#endif
+
+}/*end of u8SerialFill()*/
+
+#if (MAP_PACKED == FALSE) && (MAP_TILED == FALSE) && !defined(_WIN32)
+/*this function is run by every parallel explorer , it explores cells of its own deque and
+ *steals cells from other explorers when its deque is empty until no claimed cell is left
+ *Arguments : pointer to worker
+ *Return    : NULL */
+static void *pvExploreWorker(void *Argument)
+{
+    worker *Worker = (worker *)Argument;
+    u32    Index;
+
+    while( TRUE )
+    {
+        Index = u32TakeWork(Worker);
+        if( 0 == Index )
+        {
+            Index = u32StealWork(Worker);
+        }
+
+        if( 0 != Index )
+        {
+            voidExploreCell(Worker, Index);
+        }
+        else if( 0 == atomic_load_explicit(&Worker->Search->PendingCells, memory_order_acquire) )
+        {
+            /*every claimed cell is explored , no new cell can be claimed*/
+            break;
+        }
+        else
+        {
+            /*other explorers still have cells that may lead to new ones*/
+            sched_yield();
+        }
+    }
+
+    return NULL;
+
+}/*end of pvExploreWorker()*/
+
+/*this function explores a claimed cell , its mine neighbors are copied to shared output map
+ *and its NOT_MINE neighbors that are still NOT_DISCOVERED are claimed and pushed to worker deque
+ *Arguments : pointer to worker , cell index
+ *Return    : void */
+static void voidExploreCell(worker *Worker, u32 Index)
+{
+    parallelsearch *Search = Worker->Search;
+    u8  *Status = Search->Map->Status;
+    /*left cell is pushed first so right , upper , lower and left cells are taken back in
+     *voidTakeAction(); order*/
+    u32 Neighbors[4] = {Index - 1, Index - Search->Map->Stride, Index + Search->Map->Stride, Index + 1};
+
+    for(u8 i = 0; i < 4; i++)
+    {
+        u32 Cell  = Neighbors[i];
+        u8  Input = Search->Inputmap->Status[Cell];
+
+        if( NOT_MINE == Input )
+        {
+            /*first explorer that finds the cell claims it*/
+            u8 Expected = NOT_DISCOVERED;
+            if( __atomic_compare_exchange_n(&Status[Cell], &Expected, DISCOVERED_NOT_MINE, FALSE,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED) )
+            {
+                atomic_fetch_add_explicit(&Search->PendingCells, 1, memory_order_relaxed);
+                if( ERROR_NONE != u8PushWork(Worker, Cell) )
+                {
+                    /*cell is lost , it is not pending anymore so search still ends*/
+                    u8 None = ERROR_NONE;
+                    atomic_compare_exchange_strong(&Search->Error, &None, ERROR_NO_MEMORY);
+                    atomic_fetch_sub_explicit(&Search->PendingCells, 1, memory_order_relaxed);
+                }
+            }
+        }
+        else
+        {
+            /*mines (and borders) are copied like voidUpdateOutputMap(); does , every explorer writes the same value*/
+            __atomic_store_n(&Status[Cell], Input, __ATOMIC_RELAXED);
+        }
+    }
+
+    __atomic_store_n(&Status[Index], VISITED, __ATOMIC_RELAXED);
+    Worker->VisitedCells++;
+
+    /*cell is done after its new cells are counted so pending count never drops to 0 early*/
+    atomic_fetch_sub_explicit(&Search->PendingCells, 1, memory_order_release);
+
+}/*end of voidExploreCell()*/
+
+/*this function pushes a cell on bottom of worker own deque , deque grows when it is full
+ *Arguments : pointer to worker , cell index
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY if deque can not grow (cell is not pushed) */
+static u8 u8PushWork(worker *Worker, u32 Index)
+{
+    long long Bottom = atomic_load_explicit(&Worker->Bottom, memory_order_relaxed);
+    long long Top    = atomic_load_explicit(&Worker->Top, memory_order_acquire);
+    workarray *Array = atomic_load_explicit(&Worker->Array, memory_order_relaxed);
+
+    /*grow deque by doubling its array , replaced array is kept as thieves may still read it*/
+    if( (Bottom - Top) > (Array->Capacity - 1) )
+    {
+        workarray *NewArray = (workarray *)malloc(sizeof(workarray) + (size_t)(2 * Array->Capacity) * sizeof(atomic_uint));
+        if( NULL == NewArray )
+        {
+            return ERROR_NO_MEMORY;
+        }
+        NewArray->Capacity = 2 * Array->Capacity;
+        NewArray->Previous = Array;
+        for(long long i = Top; i < Bottom; i++)
+        {
+            atomic_store_explicit(&NewArray->Entries[i & (NewArray->Capacity - 1)],
+                                  atomic_load_explicit(&Array->Entries[i & (Array->Capacity - 1)], memory_order_relaxed),
+                                  memory_order_relaxed);
+        }
+        atomic_store_explicit(&Worker->Array, NewArray, memory_order_release);
+        Array = NewArray;
+    }
+
+    atomic_store_explicit(&Array->Entries[Bottom & (Array->Capacity - 1)], Index, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&Worker->Bottom, Bottom + 1, memory_order_relaxed);
+
+    return ERROR_NONE;
+
+}/*end of u8PushWork()*/
+
+/*this function takes last pushed cell from bottom of worker own deque
+ *Arguments : pointer to worker
+ *Return    : cell index or 0 if deque is empty */
+static u32 u32TakeWork(worker *Worker)
+{
+    long long Bottom = atomic_load_explicit(&Worker->Bottom, memory_order_relaxed) - 1;
+    workarray *Array = atomic_load_explicit(&Worker->Array, memory_order_relaxed);
+    long long Top;
+    u32       Index = 0;
+
+    atomic_store_explicit(&Worker->Bottom, Bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    Top = atomic_load_explicit(&Worker->Top, memory_order_relaxed);
+
+    if( Top <= Bottom )
+    {
+        Index = atomic_load_explicit(&Array->Entries[Bottom & (Array->Capacity - 1)], memory_order_relaxed);
+        if( Top == Bottom )
+        {
+            /*last entry , race with thieves for it*/
+            if( !atomic_compare_exchange_strong_explicit(&Worker->Top, &Top, Top + 1,
+                                                         memory_order_seq_cst, memory_order_relaxed) )
+            {
+                Index = 0;
+            }
+            atomic_store_explicit(&Worker->Bottom, Bottom + 1, memory_order_relaxed);
+        }
+    }
+    else
+    {
+        /*deque was empty*/
+        atomic_store_explicit(&Worker->Bottom, Bottom + 1, memory_order_relaxed);
+    }
+
+    return Index;
+
+}/*end of u32TakeWork()*/
+
+/*this function steals oldest cell from top of another worker deque
+ *Arguments : pointer to stealing worker
+ *Return    : cell index or 0 if no cell could be stolen */
+static u32 u32StealWork(worker *Thief)
+{
+    parallelsearch *Search = Thief->Search;
+    u32 Start;
+
+    /*start from a random victim so thieves spread over busy workers (xorshift)*/
+    Thief->Seed ^= Thief->Seed << 13;
+    Thief->Seed ^= Thief->Seed >> 17;
+    Thief->Seed ^= Thief->Seed << 5;
+    Start = Thief->Seed % Search->NumberOfWorkers;
+
+    for(u32 i = 0; i < Search->NumberOfWorkers; i++)
+    {
+        worker    *Victim = &Search->Workers[(Start + i) % Search->NumberOfWorkers];
+        long long Top;
+        long long Bottom;
+
+        if( Victim == Thief )
+        {
+            continue;
+        }
+
+        Top = atomic_load_explicit(&Victim->Top, memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        Bottom = atomic_load_explicit(&Victim->Bottom, memory_order_acquire);
+
+        if( Top < Bottom )
+        {
+            workarray *Array = atomic_load_explicit(&Victim->Array, memory_order_acquire);
+            u32       Index  = atomic_load_explicit(&Array->Entries[Top & (Array->Capacity - 1)], memory_order_relaxed);
+
+            /*another thief or the owner may take the same entry first*/
+            if( atomic_compare_exchange_strong_explicit(&Victim->Top, &Top, Top + 1,
+                                                        memory_order_seq_cst, memory_order_relaxed) )
+            {
+                Thief->Steals++;
+                return Index;
+            }
+        }
+    }
+
+    return 0;
+
+}/*end of u32StealWork()*/
+#endif
+
+/*this function clears search state of an explorer so it can search its maps again
+ *branch stack entries are kept so a reused explorer does not allocate them again
+ *Arguments : pointer to explorer
+ *Return    : void */
+void voidResetExplorer(explorer *Explorer)
+{
+    Explorer->CurrentCell           = 0;
+    Explorer->EntryCell             = 0;
+    Explorer->ReachableCells        = 0;
+    Explorer->BranchStack.Size      = 0;
+    Explorer->BranchStack.HighWater = 0;
+    Explorer->FrontierCells         = 0;
+    Explorer->DeadendCondition      = FALSE;
+    Explorer->Error                 = ERROR_NONE;
+    Explorer->VisitedCells          = 0;
+    Explorer->Backtracks            = 0;
+    Explorer->FrontierRescans       = 0;
+    Explorer->RouteCells            = 0;
+    memset(&Explorer->Stats, 0, sizeof(Explorer->Stats));
+    Explorer->TraceDeltas           = 0;
+
+}/*end of voidResetExplorer()*/
+
+/*this function builds a path index of a searched output map , safe cells are labelled with their
+ *connected component so queries between components are answered without a search
+ *Arguments : pointer to path index , pointer to output map
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY */
+u8 u8BuildPathIndex(pathindex *Index, cellmap *map)
+{
+    u64 Cells = (u64)map->Stride * (map->Height+2);
+    /*neighbor offsets right , up , low , left (unsigned wrap gives negative offsets)*/
+    const u32 Offsets[4] = {1, map->Stride, 0u - map->Stride, 0u - 1};
+
+    memset(Index, 0, sizeof(*Index));
+    Index->Width  = map->Width;
+    Index->Height = map->Height;
+    Index->Stride = map->Stride;
+    Index->Component = (u32 *)calloc((size_t)Cells, sizeof(u32));
+    Index->Queue     = (u32 *)malloc((size_t)Cells * sizeof(u32));
+    if( (NULL == Index->Component) || (NULL == Index->Queue) )
+    {
+        voidFreePathIndex(Index);
+        return ERROR_NO_MEMORY;
+    }
+
+    /*mark safe cells , borders are never safe so searches never leave the map*/
+    for(u32 i = 0; i < Cells; i++)
+    {
+        u8 Status = MAP_GET(map, i);
+        if( (VISITED == Status) || (DISCOVERED_NOT_MINE == Status) || (CURRENT_LOCATION == Status) )
+        {
+            Index->Component[i] = PATH_NONE;
+        }
+    }
+
+    /*label every unlabelled safe cell and all cells connected to it*/
+    for(u32 i = 0; i < Cells; i++)
+    {
+        u32 Head = 0;
+        u32 Tail = 0;
+
+        if( PATH_NONE != Index->Component[i] )
+        {
+            continue;
+        }
+        Index->Components++;
+        Index->Component[i]   = Index->Components;
+        Index->Queue[Tail++]  = i;
+        while( Head < Tail )
+        {
+            u32 Cell = Index->Queue[Head++];
+            for(u8 d = 0; d < 4; d++)
+            {
+                u32 Next = Cell + Offsets[d];
+                if( PATH_NONE == Index->Component[Next] )
+                {
+                    Index->Component[Next] = Index->Components;
+                    Index->Queue[Tail++]   = Next;
+                }
+            }
+        }
+    }
+
+    return ERROR_NONE;
+
+}/*end of u8BuildPathIndex()*/
+
+/*this function finds distance field of a destination in field cache or builds it by a breadth first
+ *search over destination component , least recently used field is replaced
+ *Arguments : pointer to path index , destination cell index (a safe cell)
+ *Return    : distance of every cell to destination , NULL if there is no memory for it */
+static u32 *pu32GetDistanceField(pathindex *Index, u32 Target)
+{
+    u64 Cells = (u64)Index->Stride * (Index->Height+2);
+    const u32 Offsets[4] = {1, Index->Stride, 0u - Index->Stride, 0u - 1};
+    u32 Component = Index->Component[Target];
+    u32 *Field;
+    u32 Head = 0;
+    u32 Tail = 0;
+    u8  Slot = 0;
+
+    Index->Clock++;
+
+    /*cached field*/
+    for(u8 i = 0; i < PATH_CACHE_FIELDS; i++)
+    {
+        if( Index->FieldTarget[i] == Target )
+        {
+            Index->FieldLastUse[i] = Index->Clock;
+            Index->Hits++;
+            return Index->Field[i];
+        }
+        if( Index->FieldLastUse[i] < Index->FieldLastUse[Slot] )
+        {
+            Slot = i;
+        }
+    }
+
+    /*build field in least recently used slot , its memory is reused*/
+    Index->Misses++;
+    if( NULL == Index->Field[Slot] )
+    {
+        Index->Field[Slot] = (u32 *)malloc((size_t)Cells * sizeof(u32));
+        if( NULL == Index->Field[Slot] )
+        {
+            return NULL;
+        }
+    }
+    Field = Index->Field[Slot];
+    memset(Field, 0xFF, (size_t)Cells * sizeof(u32));
+
+    Field[Target] = 0;
+    Index->Queue[Tail++] = Target;
+    while( Head < Tail )
+    {
+        u32 Cell = Index->Queue[Head++];
+        for(u8 d = 0; d < 4; d++)
+        {
+            u32 Next = Cell + Offsets[d];
+            if( (Component == Index->Component[Next]) && (PATH_NONE == Field[Next]) )
+            {
+                Field[Next] = Field[Cell] + 1;
+                Index->Queue[Tail++] = Next;
+            }
+        }
+    }
+
+    Index->FieldTarget[Slot]  = Target;
+    Index->FieldLastUse[Slot] = Index->Clock;
+    return Field;
+
+}/*end of pu32GetDistanceField()*/
+
+/*this function answers a shortest safe path query , path follows distance field of destination downhill
+ *Arguments : pointer to path index , start and destination cell indices ,
+ *            array that receives path cells from start to destination (or NULL) and its number of entries ,
+ *            pointer that receives path length in moves or PATH_NONE if there is no safe path
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY (no distance field for destination) */
+u8 u8QueryPath(pathindex *Index, u32 From, u32 To, u32 *Path, u32 PathCapacity, u32 *Length)
+{
+    const u32 Offsets[4] = {1, Index->Stride, 0u - Index->Stride, 0u - 1};
+    u32 *Field;
+    u32 Cell = From;
+
+    /*both ends must be safe cells of the same component*/
+    *Length = PATH_NONE;
+    if( (0 == Index->Component[From]) || (Index->Component[From] != Index->Component[To]) )
+    {
+        return ERROR_NONE;
+    }
+
+    Field = pu32GetDistanceField(Index, To);
+    if( NULL == Field )
+    {
+        return ERROR_NO_MEMORY;
+    }
+    *Length = Field[From];
+
+    /*walk downhill from start , every step lowers distance by one*/
+    for(u32 i = 0; (NULL != Path) && (i < PathCapacity) && (i <= *Length); i++)
+    {
+        Path[i] = Cell;
+        for(u8 d = 0; (d < 4) && (Cell != To); d++)
+        {
+            if( Field[Cell + Offsets[d]] == (Field[Cell] - 1) )
+            {
+                Cell = Cell + Offsets[d];
+                break;
+            }
+        }
+    }
+
+    return ERROR_NONE;
+
+}/*end of u8QueryPath()*/
+
+/*this function releases path index
+ *Arguments : pointer to path index
+ *Return    : void */
+void voidFreePathIndex(pathindex *Index)
+{
+    for(u8 i = 0; i < PATH_CACHE_FIELDS; i++)
+    {
+        free(Index->Field[i]);
+        Index->Field[i] = NULL;
+    }
+    free(Index->Component);
+    free(Index->Queue);
+    Index->Component = NULL;
+    Index->Queue     = NULL;
+
+}/*end of voidFreePathIndex()*/
+
+/*this function builds row bits of a map , passable cells are the ones an explorer can enter
+ *(NOT_MINE of input maps , VISITED DISCOVERED_NOT_MINE and CURRENT_LOCATION of output maps)
+ *Arguments : pointer to row bits , pointer to map
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY */
+static u8 u8CreateRowBits(rowbits *Bits, cellmap *map)
+{
+    u64 Words;
+    /*Allocation sizes rounded up to a whole number of cache lines as aligned_alloc() requires*/
+    u64 PlaneSize;
+    u64 EmptySize;
+
+    Bits->Width    = map->Width;
+    Bits->Height   = map->Height;
+    Bits->RowWords = (((map->Width + 63) / 64) + ROW_BITS_ALIGN - 1) & ~(u32)(ROW_BITS_ALIGN - 1);
+    Words = (u64)Bits->RowWords * map->Height;
+    PlaneSize = (Words * sizeof(u64) + CACHE_LINE_SIZE - 1) & ~(u64)(CACHE_LINE_SIZE - 1);
+    EmptySize = ((u64)Bits->RowWords * sizeof(u64) + CACHE_LINE_SIZE - 1) & ~(u64)(CACHE_LINE_SIZE - 1);
+
+    Bits->Passable = (u64 *)aligned_alloc(CACHE_LINE_SIZE, (size_t)PlaneSize);
+    Bits->Reached  = (u64 *)aligned_alloc(CACHE_LINE_SIZE, (size_t)PlaneSize);
+    Bits->Empty    = (u64 *)aligned_alloc(CACHE_LINE_SIZE, (size_t)EmptySize);
+    if( (NULL == Bits->Passable) || (NULL == Bits->Reached) || (NULL == Bits->Empty) )
+    {
+        voidFreeRowBits(Bits);
+        return ERROR_NO_MEMORY;
+    }
+    memset(Bits->Passable, 0, (size_t)(Words * sizeof(u64)));
+    memset(Bits->Reached,  0, (size_t)(Words * sizeof(u64)));
+    memset(Bits->Empty,    0, (size_t)(Bits->RowWords * sizeof(u64)));
+
+    for(u32 r = 0; r < map->Height; r++)
+    {
+        u64 *Row = &Bits->Passable[(u64)r * Bits->RowWords];
+
+        for(u32 c = 0; c < map->Width; c++)
+        {
+            u8 Status = MAP_CELL(map, r+1, c+1);
+
+            if( (NOT_MINE == Status) || (VISITED == Status) || (DISCOVERED_NOT_MINE == Status) || (CURRENT_LOCATION == Status) )
+            {
+                Row[c >> 6] |= (u64)1 << (c & 63);
+            }
+        }
+    }
+
+    return ERROR_NONE;
+
+}/*end of u8CreateRowBits()*/
+
+/*this function releases row bits
+ *Arguments : pointer to row bits
+ *Return    : void */
+static void voidFreeRowBits(rowbits *Bits)
+{
+    free(Bits->Passable);
+    free(Bits->Reached);
+    free(Bits->Empty);
+    Bits->Passable = NULL;
+    Bits->Reached  = NULL;
+    Bits->Empty    = NULL;
+
+}/*end of voidFreeRowBits()*/
+
+/*this function finds every passable cell reachable from a start cell , rows are swept down and up
+ *until a whole down and up sweep reaches no new cell
+ *Arguments : pointer to row bits , start cell row and column in map coordinates (1 is first inner row/column)
+ *Return    : number of down and up sweeps , 0 if start cell is not passable */
+static u32 u32FloodRowBits(rowbits *Bits, u32 Row, u32 Col)
+{
+    u64 StartWord = (u64)(Row-1) * Bits->RowWords + ((Col-1) >> 6);
+    u64 StartBit  = (u64)1 << ((Col-1) & 63);
+    u32 Sweeps    = 0;
+    u8  Changed   = TRUE;
+
+    memset(Bits->Reached, 0, (size_t)((u64)Bits->RowWords * Bits->Height * sizeof(u64)));
+    if( (0 == Row) || (Row > Bits->Height) || (0 == Col) || (Col > Bits->Width) ||
+        (0 == (Bits->Passable[StartWord] & StartBit)) )
+    {
+        return 0;
+    }
+    Bits->Reached[StartWord] = StartBit;
+
+    while( TRUE == Changed )
+    {
+        Changed = FALSE;
+        /*down sweep , every row takes reached cells of row above it*/
+        for(u32 r = 0; r < Bits->Height; r++)
+        {
+            u64 *Reached = &Bits->Reached[(u64)r * Bits->RowWords];
+            Changed |= u8FloodRow(Bits, Reached, &Bits->Passable[(u64)r * Bits->RowWords],
+                                  (r > 0) ? (Reached - Bits->RowWords) : Bits->Empty);
+        }
+        /*up sweep , every row takes reached cells of row below it*/
+        for(u32 r = Bits->Height; r-- > 0; )
+        {
+            u64 *Reached = &Bits->Reached[(u64)r * Bits->RowWords];
+            Changed |= u8FloodRow(Bits, Reached, &Bits->Passable[(u64)r * Bits->RowWords],
+                                  ((r+1) < Bits->Height) ? (Reached + Bits->RowWords) : Bits->Empty);
+        }
+        Sweeps++;
+    }
+
+    return Sweeps;
+
+}/*end of u32FloodRowBits()*/
+
+/*this function spreads reached cells of one row from its neighbor row and along its runs of passable cells
+ *Arguments : pointer to row bits , reached and passable words of the row , reached words of neighbor row
+ *Return    : TRUE if row reached a new cell */
+static u8 u8FloodRow(const rowbits *Bits, u64 *Reached, const u64 *Passable, const u64 *Neighbor)
+{
+    u64 Changed = 0;
+
+#if defined(__AVX2__)
+    /*4 words at a time , same steps as u64FillWord(); in every 64 bit lane*/
+    for(u32 w = 0; w < Bits->RowWords; w += 4)
+    {
+        __m256i Old   = _mm256_load_si256((const __m256i *)&Reached[w]);
+        __m256i Pass  = _mm256_load_si256((const __m256i *)&Passable[w]);
+        __m256i Fill  = _mm256_and_si256(_mm256_or_si256(Old, _mm256_load_si256((const __m256i *)&Neighbor[w])), Pass);
+        __m256i Up    = Fill;
+        __m256i Down  = Fill;
+        __m256i PUp   = Pass;
+        __m256i PDown = Pass;
+
+        for(int Shift = 1; Shift < 64; Shift <<= 1)
+        {
+            __m128i Count = _mm_cvtsi32_si128(Shift);
+            Up    = _mm256_or_si256(Up, _mm256_and_si256(PUp, _mm256_sll_epi64(Up, Count)));
+            PUp   = _mm256_and_si256(PUp, _mm256_sll_epi64(PUp, Count));
+            Down  = _mm256_or_si256(Down, _mm256_and_si256(PDown, _mm256_srl_epi64(Down, Count)));
+            PDown = _mm256_and_si256(PDown, _mm256_srl_epi64(PDown, Count));
+        }
+        Fill = _mm256_or_si256(Up, Down);
+        _mm256_store_si256((__m256i *)&Reached[w], Fill);
+        /*new bits are the ones that are not in old bits*/
+        Changed |= (u64)!_mm256_testc_si256(Old, Fill);
+    }
+#else
+    for(u32 w = 0; w < Bits->RowWords; w++)
+    {
+        u64 Old = Reached[w];
+        Reached[w] = u64FillWord((Old | Neighbor[w]) & Passable[w], Passable[w]);
+        Changed |= Old ^ Reached[w];
+    }
+#endif
+
+    /*runs that cross word boundaries , carry last bit of a word into first bit of next word and back*/
+    for(u32 w = 1; w < Bits->RowWords; w++)
+    {
+        if( (Reached[w-1] >> 63) & Passable[w] & ~Reached[w] & 1 )
+        {
+            Reached[w] = u64FillWord(Reached[w] | 1, Passable[w]);
+            Changed = 1;
+        }
+    }
+    for(u32 w = Bits->RowWords - 1; w > 0; w--)
+    {
+        if( Reached[w] & ((Passable[w-1] & ~Reached[w-1]) >> 63) & 1 )
+        {
+            Reached[w-1] = u64FillWord(Reached[w-1] | ((u64)1 << 63), Passable[w-1]);
+            Changed = 1;
+        }
+    }
+
+    return (0 != Changed) ? TRUE : FALSE;
+
+}/*end of u8FloodRow()*/
+
+/*this function spreads reached bits of a word along runs of passable bits in both directions
+ *Arguments : reached bits (all of them passable) , passable bits
+ *Return    : reached bits */
+static u64 u64FillWord(u64 Reached, u64 Passable)
+{
+    u64 Up    = Reached;
+    u64 Down  = Reached;
+    u64 PUp   = Passable;
+    u64 PDown = Passable;
+
+    /*every step doubles distance a reached bit spreads , passable masks keep only unbroken runs*/
+    for(u32 Shift = 1; Shift < 64; Shift <<= 1)
+    {
+        Up    |= PUp & (Up << Shift);
+        PUp   &= PUp << Shift;
+        Down  |= PDown & (Down >> Shift);
+        PDown &= PDown >> Shift;
+    }
+    return Up | Down;
+
+}/*end of u64FillWord()*/
+
+/*this function counts set bits of a row bits plane
+ *Arguments : pointer to row bits , plane (Passable or Reached)
+ *Return    : number of set bits */
+static u64 u64CountRowBits(const rowbits *Bits, const u64 *Plane)
+{
+    u64 Count = 0;
+
+    for(u64 w = 0; w < ((u64)Bits->RowWords * Bits->Height); w++)
+    {
+        Count += (u64)__builtin_popcountll(Plane[w]);
+    }
+    return Count;
+
+}/*end of u64CountRowBits()*/
+
+/*this function checks explorer output against a flood fill of input map from entry point ,
+ *every reachable cell must be VISITED and every VISITED cell must be reachable
+ *Arguments : pointer to explorer after search , pointers that receive number of cells that are reachable
+ *            but not visited or visited but not reachable , number of reachable cells ,
+ *            flood fill time in nanoseconds and number of sweeps
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY */
+u8 u8CheckCoverage(explorer *Explorer, u64 *Mismatches, u64 *Reachable, u64 *FloodTime, u32 *Sweeps)
+{
+    rowbits Input;
+    rowbits Output;
+    u32 Entry = u32FindEntryCell(Explorer);
+
+    if( ERROR_NONE != u8CreateRowBits(&Input, &Explorer->Inputmap) )
+    {
+        return ERROR_NO_MEMORY;
+    }
+    if( ERROR_NONE != u8CreateRowBits(&Output, &Explorer->Outputmap) )
+    {
+        voidFreeRowBits(&Input);
+        return ERROR_NO_MEMORY;
+    }
+
+    *FloodTime = u64ReadClock();
+    *Sweeps    = (0 == Entry) ? 0 : u32FloodRowBits(&Input, Entry / Explorer->Inputmap.Stride, Entry % Explorer->Inputmap.Stride);
+    *FloodTime = u64ReadClock() - *FloodTime;
+    *Reachable = u64CountRowBits(&Input, Input.Reached);
+
+    /*after search passable output cells are the VISITED ones*/
+    *Mismatches = 0;
+    for(u64 w = 0; w < ((u64)Input.RowWords * Input.Height); w++)
+    {
+        *Mismatches += (u64)__builtin_popcountll(Input.Reached[w] ^ Output.Passable[w]);
+    }
+
+    voidFreeRowBits(&Input);
+    voidFreeRowBits(&Output);
+    return ERROR_NONE;
+
+}/*end of u8CheckCoverage()*/
+
+/*this function applies input map cell changes to a searched map and updates output map around them
+ *without a new search , newly reachable cells are walked and VISITED cells cut off from entry point
+ *become NOT_DISCOVERED again
+ *a cleared mine next to a VISITED cell becomes a frontier cell and search walks on from it , a new mine
+ *on a VISITED cell may cut VISITED cells off from entry point and a new mine on entry point cuts off all
+ *of them so search enters again at first NOT_MINE cell of first row , work done depends on changed cells ,
+ *cut off cells and newly reachable cells instead of map size
+ *a failure (memory of cut off and walk searches , input map file pages) stops the changes , explorer keeps it
+ *like a failed search step and maps are not valid anymore
+ *Arguments : pointer to explorer after search , array of changes and its number of entries ,
+ *            pointer that receives number of VISITED cells cut off
+ *Return    : ERROR_NONE , ERROR_NO_MEMORY , ERROR_ARENA_FULL , ERROR_READ_FILE (input map file pages can not
+ *            be made writable) or error that stopped a walk (see u8StepSearch();) */
+u8 u8ApplyMapChanges(explorer *Explorer, const mapchange *Changes, u32 Count, u32 *CutCells)
+{
+    cellmap *map = &Explorer->Outputmap;
+    /*cleared cells search walks on from*/
+    u32 *Cleared = NULL;
+    u32 ClearedCells = 0;
+    u32 ClearedCapacity = 0;
+    /*changes are written outside search steps , live monitor reader copies no band until changes and walks
+     *after them are done*/
+    monitor *Monitor = Explorer->Monitor;
+    /*walks after changes begin away from cell last step ended on , no checkpoint is copied until they are done*/
+    checkpoint *Checkpoint = Explorer->Checkpoint;
+
+    *CutCells = 0;
+    if( ERROR_NONE == Explorer->Error )
+    {
+        Explorer->Error = u8UnlockInputMap(&Explorer->Inputmap);
+    }
+    if( ERROR_NONE != Explorer->Error )
+    {
+        return Explorer->Error;
+    }
+    if( NULL != Monitor )
+    {
+        voidStampAllBands(Monitor, MONITOR_CHANGING);
+    }
+    Explorer->Monitor    = NULL;
+    Explorer->Checkpoint = NULL;
+
+    /*Update both maps around every changed cell*/
+    /*=============================================*/
+    for(u32 c = 0; (c < Count) && (ERROR_NONE == Explorer->Error); c++)
+    {
+        u32 Index  = Changes[c].Index;
+        u8  Status = MAP_GET(map, Index);
+
+        if( Changes[c].Status == MAP_GET(&Explorer->Inputmap, Index) )
+        {
+            continue;
+        }
+        MAP_SET(&Explorer->Inputmap, Index, Changes[c].Status);
+
+        if( NOT_MINE == Changes[c].Status )
+        {
+            /*a discovered mine is next to a VISITED cell , cells not discovered yet are found when walked to*/
+            if( MINE == Status )
+            {
+                voidSetOutputStatus(Explorer, Index, DISCOVERED_NOT_MINE);
+                Explorer->Error = u8AppendCell(&Cleared, &ClearedCells, &ClearedCapacity, Index);
+            }
+        }
+        else if( (VISITED == Status) || (DISCOVERED_NOT_MINE == Status) )
+        {
+            voidSetOutputStatus(Explorer, Index, MINE);
+            if( VISITED == Status )
+            {
+                *CutCells += u32CutOffCells(Explorer, Index);
+            }
+
+            /*mine is only discovered while a VISITED cell is next to it*/
+            if( FALSE == u8HasVisitedNeighbor(Explorer, Index) )
+            {
+                voidSetOutputStatus(Explorer, Index, NOT_DISCOVERED);
+            }
+        }
+
+        /*search enters again at first NOT_MINE cell of first row when entry point becomes a mine*/
+        if( (MINE == Changes[c].Status) && (Index == Explorer->EntryCell) )
+        {
+            Explorer->EntryCell = 0;
+            Explorer->EntryCell = u32FindEntryCell(Explorer);
+            if( (0 != Explorer->EntryCell) && (ERROR_NONE == Explorer->Error) )
+            {
+                voidSetOutputStatus(Explorer, Explorer->EntryCell, DISCOVERED_NOT_MINE);
+                Explorer->Error = u8AppendCell(&Cleared, &ClearedCells, &ClearedCapacity, Explorer->EntryCell);
+            }
+        }
+
+    }/*end of changes loop*/
+
+    /*write changed cells before steps of new walks*/
+    if( TRACE_DELTAS == Explorer->TraceLevel )
+    {
+        fprintf(Explorer->TraceFile, "Map changes\n");
+        voidTraceFlushDeltas(Explorer);
+    }
+
+    /*Walk newly reachable cells from cleared cells that are still frontier cells*/
+    /*=============================================*/
+    for(u32 i = 0; (i < ClearedCells) && (ERROR_NONE == Explorer->Error); i++)
+    {
+        if( DISCOVERED_NOT_MINE == MAP_GET(map, Cleared[i]) )
+        {
+            Explorer->CurrentCell      = Cleared[i];
+            Explorer->BranchStack.Size = 0;
+            Explorer->DeadendCondition = FALSE;
+            Explorer->VisitedCells++;
+            u8WalkMap(Explorer);
+        }
+    }
+    free(Cleared);
+
+    /*cells reachable from entry point were analysed for map before changes*/
+    Explorer->ReachableCells = 0;
+
+    /*reader copies every band again once it sees new generation*/
+    Explorer->Monitor = Monitor;
+    if( NULL != Monitor )
+    {
+        voidStampAllBands(Monitor, Explorer->VisitedCells);
+        atomic_fetch_add_explicit(&Monitor->Generation, 1, memory_order_release);
+        MONITOR_END(Monitor, Explorer->CurrentCell, Explorer->VisitedCells);
+    }
+
+    /*image copied before changes is copied again from first band*/
+    Explorer->Checkpoint = Checkpoint;
+    if( (NULL != Checkpoint) && (TRUE == Checkpoint->Copying) )
+    {
+        voidDropCheckpointCopy(Checkpoint);
+        Checkpoint->LastCell  = Explorer->CurrentCell;
+        Checkpoint->NextCheck = Explorer->VisitedCells;
+    }
+
+    return Explorer->Error;
+
+}/*end of u8ApplyMapChanges()*/
+
+/*this function finds VISITED cells cut off from entry point by a new mine and makes them NOT_DISCOVERED
+ *a breadth first search starts on every VISITED surrounding cell of mine cell and searches take one cell
+ *in turn , searches that reach cells of each other are joined (union find of at most 4 searches)
+ *a finished search holds a whole part of VISITED cells so searching stops when only the part of entry
+ *point is unfinished , work is bounded by size of cut off parts instead of size of map
+ *discovered cells next to mine cell and cut off cells stay discovered only if a VISITED cell is still next to them
+ *search memory that can not be allocated is kept in explorer Error and no cell is cut off
+ *Arguments : pointer to explorer , index of mine cell that was VISITED
+ *Return    : number of cut off cells */
+static u32 u32CutOffCells(explorer *Explorer, u32 Mine)
+{
+    cellmap *map = &Explorer->Outputmap;
+    /*neighbor offsets in move order right , up , low , left (unsigned wrap gives negative offsets)*/
+    const u32 Offsets[4] = {1, map->Stride, 0u - map->Stride, 0u - 1};
+    u32 *Queue[4]   = {NULL, NULL, NULL, NULL};
+    u32 Head[4]     = {0, 0, 0, 0};
+    u32 Tail[4]     = {0, 0, 0, 0};
+    u32 Capacity[4] = {0, 0, 0, 0};
+    u32 Group[4];                                //joined searches , search s belongs to group of u32FindRoot(Group,s)
+    u8  Safe[4]     = {FALSE, FALSE, FALSE, FALSE}; //search reached entry point
+    u32 Searches    = 0;
+    u8  Kept        = 0;                         //bit mask of groups whose cells stay VISITED
+    u32 CutCells    = 0;
+    u32 Generation  = u32NewRouteGenerations(Explorer, 4);
+    u8  Error       = ERROR_NONE;
+
+    if( 0 == Generation )
+    {
+        return 0;
+    }
+
+    /*start one search on every VISITED surrounding cell , search s marks cells with Generation+s*/
+    /*=============================================*/
+    for(u8 d = 0; d < 4; d++)
+    {
+        u32 Next = Mine + Offsets[d];
+        if( VISITED == MAP_GET(map, Next) )
+        {
+            Explorer->RouteMarks[Next] = Generation + Searches;
+            if( ERROR_NONE != u8AppendCell(&Queue[Searches], &Tail[Searches], &Capacity[Searches], Next) )
+            {
+                Error = ERROR_NO_MEMORY;
+            }
+            Group[Searches] = Searches;
+            Safe[Searches]  = (Next == Explorer->EntryCell) ? TRUE : FALSE;
+            Searches++;
+        }
+    }
+
+    /*take one cell of every unfinished search in turn , output map is not changed until searches are done*/
+    /*=============================================*/
+    while( ERROR_NONE == Error )
+    {
+        u8 Active    = 0;   //groups with an unfinished search
+        u8 SafeGroup = 0;   //groups that reached entry point
+
+        for(u32 s = 0; s < Searches; s++)
+        {
+            u32 Root = u32FindRoot(Group, s);
+            if( Head[s] < Tail[s] )
+            {
+                Active |= (u8)(1 << Root);
+            }
+            if( TRUE == Safe[s] )
+            {
+                SafeGroup |= (u8)(1 << Root);
+            }
+        }
+
+        if( 0 == Active )
+        {
+            /*every part is finished , only the part of entry point is kept*/
+            Kept = SafeGroup;
+            break;
+        }
+        if( (0 == (Active & (Active - 1))) && (0 == (SafeGroup & ~Active)) && (Mine != Explorer->EntryCell) )
+        {
+            /*one part is unfinished and no finished part has entry point , so it has entry point*/
+            Kept = Active;
+            break;
+        }
+
+        for(u32 s = 0; s < Searches; s++)
+        {
+            if( Head[s] < Tail[s] )
+            {
+                u32 Index = Queue[s][Head[s]++];
+
+                for(u8 d = 0; d < 4; d++)
+                {
+                    u32 Next = Index + Offsets[d];
+                    u32 Mark = Explorer->RouteMarks[Next] - Generation;
+
+                    if( Mark < Searches )
+                    {
+                        /*cell of another search , both searches are in the same part*/
+                        u32 Root1 = u32FindRoot(Group, s);
+                        u32 Root2 = u32FindRoot(Group, Mark);
+                        Group[Root2] = Root1;
+                    }
+                    else if( VISITED == MAP_GET(map, Next) )
+                    {
+                        Explorer->RouteMarks[Next] = Generation + s;
+                        if( ERROR_NONE != u8AppendCell(&Queue[s], &Tail[s], &Capacity[s], Next) )
+                        {
+                            Error = ERROR_NO_MEMORY;
+                        }
+                        if( Next == Explorer->EntryCell )
+                        {
+                            Safe[s] = TRUE;
+                        }
+                    }
+                }
+            }
+        }
+    }/*end of searching loop*/
+
+    if( ERROR_NONE != Error )
+    {
+        for(u32 s = 0; s < Searches; s++)
+        {
+            free(Queue[s]);
+        }
+        Explorer->Error = Error;
+        return 0;
+    }
+
+    /*Cut off cells of finished parts without entry point*/
+    /*=============================================*/
+    for(u32 s = 0; s < Searches; s++)
+    {
+        if( 0 == (Kept & (1 << u32FindRoot(Group, s))) )
+        {
+            for(u32 i = 0; i < Tail[s]; i++)
+            {
+                voidSetOutputStatus(Explorer, Queue[s][i], NOT_DISCOVERED);
+            }
+            CutCells += Tail[s];
+        }
+    }
+    voidUndiscoverNeighbors(Explorer, Mine);
+    for(u32 s = 0; s < Searches; s++)
+    {
+        if( 0 == (Kept & (1 << u32FindRoot(Group, s))) )
+        {
+            for(u32 i = 0; i < Tail[s]; i++)
+            {
+                voidUndiscoverNeighbors(Explorer, Queue[s][i]);
+            }
+        }
+        free(Queue[s]);
+    }
+
+    return CutCells;
+
+}/*end of u32CutOffCells()*/
+
+/*this function makes discovered (MINE and DISCOVERED_NOT_MINE) surrounding cells of a cell that is not VISITED
+ *any more NOT_DISCOVERED again when no VISITED cell is next to them
+ *Arguments : pointer to explorer , cell index
+ *Return    : void */
+static void voidUndiscoverNeighbors(explorer *Explorer, u32 Index)
+{
+    cellmap *map = &Explorer->Outputmap;
+    const u32 Neighbors[4] = {Index + 1, Index + map->Stride, Index - map->Stride, Index - 1};
+
+    for(u8 d = 0; d < 4; d++)
+    {
+        u8 Status = MAP_GET(map, Neighbors[d]);
+
+        if( ((MINE == Status) || (DISCOVERED_NOT_MINE == Status)) &&
+            (FALSE == u8HasVisitedNeighbor(Explorer, Neighbors[d])) )
+        {
+            voidSetOutputStatus(Explorer, Neighbors[d], NOT_DISCOVERED);
+        }
+    }
+
+}/*end of voidUndiscoverNeighbors()*/
+
+/*this function checks if any surrounding cell of an output map cell is VISITED
+ *Arguments : pointer to explorer , cell index
+ *Return    : TRUE if a surrounding cell is VISITED , FALSE otherwise */
+static u8 u8HasVisitedNeighbor(explorer *Explorer, u32 Index)
+{
+    cellmap *map = &Explorer->Outputmap;
+
+    return ( (VISITED == MAP_GET(map, Index + 1)) || (VISITED == MAP_GET(map, Index - 1)) ||
+             (VISITED == MAP_GET(map, Index + map->Stride)) || (VISITED == MAP_GET(map, Index - map->Stride)) ) ? TRUE : FALSE;
+
+}/*end of u8HasVisitedNeighbor()*/
+
+/*this function appends a cell index to a cell list , list grows by doubling its capacity
+ *Arguments : pointer to list entries , pointers to its number of entries and capacity , cell index
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY (cell is not appended) */
+static u8 u8AppendCell(u32 **Cells, u32 *Size, u32 *Capacity, u32 Index)
+{
+    if( *Size == *Capacity )
+    {
+        u32 NewCapacity = (0 == *Capacity) ? BRANCH_STACK_INITIAL_SIZE : (*Capacity * 2);
+        u32 *NewCells   = (u32 *)realloc(*Cells, (size_t)NewCapacity * sizeof(u32));
+
+        if( NULL == NewCells )
+        {
+            return ERROR_NO_MEMORY;
+        }
+        *Cells    = NewCells;
+        *Capacity = NewCapacity;
+    }
+
+    (*Cells)[*Size] = Index;
+    (*Size)++;
+
+    return ERROR_NONE;
+
+}/*end of u8AppendCell()*/
+
+/*this function lets input map cells be changed , a memory mapped map file is mapped read only
+ *so its pages are made writable , mapping is private and map file itself is never changed
+ *Arguments : pointer to input map
+ *Return    : ERROR_NONE or ERROR_READ_FILE if pages can not be made writable */
+static u8 u8UnlockInputMap(cellmap *map)
+{
+#if !defined(_WIN32)
+    /*packed and tiled maps keep their own copy of a map file*/
+    if( (MAP_STORAGE_MAPPED == map->Storage) && (NULL != map->Status) )
+    {
+        u64 NumberOfCells = (u64)map->Stride * (u64)(map->Height+2);
+
+        if( 0 != mprotect(map->Status - MAP_FILE_HEADER_SIZE, (size_t)(MAP_FILE_HEADER_SIZE + NumberOfCells),
+                          PROT_READ | PROT_WRITE) )
+        {
+            return ERROR_READ_FILE;
+        }
+    }
+#else
+    (void)map;
+#endif
+
+    return ERROR_NONE;
+
+}/*end of u8UnlockInputMap()*/
+
+/*this function sets up a live monitor for an output map with one byte per cell , bands of rows around
+ *current cell are then stamped by every step of an explorer the monitor is attached to
+ *Arguments : pointer to monitor , pointer to output map it watches
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY */
+u8 u8CreateMonitor(monitor *Monitor, const cellmap *map)
+{
+    memset(Monitor, 0, sizeof(monitor));
+    Monitor->Status = map->Status;
+    Monitor->Cells  = map->Stride * (map->Height+2);
+    Monitor->Width  = map->Width;
+    Monitor->Height = map->Height;
+    Monitor->Stride = map->Stride;
+
+    /*a band holds at least 1 << MONITOR_BAND_SHIFT cells and more than two rows so rows around a cell
+     *are always in two bands at most*/
+    Monitor->BandShift = MONITOR_BAND_SHIFT;
+    while( ((u64)1 << Monitor->BandShift) <= (2 * (u64)map->Stride) )
+    {
+        Monitor->BandShift++;
+    }
+    Monitor->Bands    = (u32)(((u64)Monitor->Cells + ((u64)1 << Monitor->BandShift) - 1) >> Monitor->BandShift);
+    Monitor->BandStep = (atomic_uint *)malloc((size_t)Monitor->Bands * sizeof(atomic_uint));
+    if( NULL == Monitor->BandStep )
+    {
+        return ERROR_NO_MEMORY;
+    }
+    for(u32 Band = 0; Band < Monitor->Bands; Band++)
+    {
+        atomic_init(&Monitor->BandStep[Band], 0);
+    }
+    atomic_init(&Monitor->Position, 0);
+    atomic_init(&Monitor->Generation, 0);
+
+    return ERROR_NONE;
+
+}/*end of u8CreateMonitor()*/
+
+/*this function releases band stamps of a live monitor
+ *Arguments : pointer to monitor
+ *Return    : void */
+void voidFreeMonitor(monitor *Monitor)
+{
+    free(Monitor->BandStep);
+    Monitor->BandStep = NULL;
+
+}/*end of voidFreeMonitor()*/
+
+/*this function stamps every band of a live monitor , it is used around writes that are not done by a search step
+ *Arguments : pointer to monitor , stamp (MONITOR_CHANGING while writes are done)
+ *Return    : void */
+static void voidStampAllBands(monitor *Monitor, u32 Step)
+{
+    for(u32 Band = 0; Band < Monitor->Bands; Band++)
+    {
+        atomic_store_explicit(&Monitor->BandStep[Band], Step, memory_order_release);
+    }
+    atomic_thread_fence(memory_order_release);
+
+}/*end of voidStampAllBands()*/
+
+/*this function sets up an empty snapshot of a live monitor , its first update copies every band
+ *Arguments : pointer to snapshot , pointer to monitor
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY */
+u8 u8CreateSnapshot(snapshot *Snapshot, const monitor *Monitor)
+{
+    memset(Snapshot, 0, sizeof(snapshot));
+    Snapshot->Status   = (u8 *)calloc(Monitor->Cells, 1);
+    Snapshot->Band     = (u8 *)malloc((size_t)1 << Monitor->BandShift);
+    Snapshot->BandStep = (u32 *)malloc((size_t)Monitor->Bands * sizeof(u32));
+    if( (NULL == Snapshot->Status) || (NULL == Snapshot->Band) || (NULL == Snapshot->BandStep) )
+    {
+        voidFreeSnapshot(Snapshot);
+        return ERROR_NO_MEMORY;
+    }
+    for(u32 Band = 0; Band < Monitor->Bands; Band++)
+    {
+        Snapshot->BandStep[Band] = MONITOR_CHANGING;
+    }
+
+    return ERROR_NONE;
+
+}/*end of u8CreateSnapshot()*/
+
+/*this function releases a snapshot
+ *Arguments : pointer to snapshot
+ *Return    : void */
+void voidFreeSnapshot(snapshot *Snapshot)
+{
+    free(Snapshot->Status);
+    free(Snapshot->Band);
+    free(Snapshot->BandStep);
+    Snapshot->Status   = NULL;
+    Snapshot->Band     = NULL;
+    Snapshot->BandStep = NULL;
+
+}/*end of voidFreeSnapshot()*/
+
+/*this function copies bands changed since last update of a snapshot and reads explorer position , it is called
+ *by reader thread while explorer runs and never makes explorer wait
+ *Arguments : pointer to monitor , pointer to snapshot of monitor
+ *Return    : number of copied bands */
+u32 u32UpdateSnapshot(monitor *Monitor, snapshot *Snapshot)
+{
+    u64 Position   = atomic_load_explicit(&Monitor->Position, memory_order_acquire);
+    u32 Generation = atomic_load_explicit(&Monitor->Generation, memory_order_acquire);
+    u32 Done       = (u32)(Position >> 32);
+    u32 Copied     = 0;
+
+    Snapshot->CurrentCell = (u32)Position;
+    Snapshot->Step        = Done;
+    Snapshot->BusyBands   = 0;
+
+    /*stamps of bands written by map changes may be older than stamps already copied*/
+    if( Generation != Snapshot->Generation )
+    {
+        for(u32 Band = 0; Band < Monitor->Bands; Band++)
+        {
+            Snapshot->BandStep[Band] = MONITOR_CHANGING;
+        }
+        Snapshot->Generation = Generation;
+    }
+
+    for(u32 Band = 0; Band < Monitor->Bands; Band++)
+    {
+        u32 Stamp = atomic_load_explicit(&Monitor->BandStep[Band], memory_order_acquire);
+        u32 First;
+        u32 Size;
+
+        if( Stamp == Snapshot->BandStep[Band] )
+        {
+            /*band did not change since it was copied*/
+            continue;
+        }
+        if( Stamp > Done )
+        {
+            /*a step that was not done when position was read wrote to band*/
+            Snapshot->BusyBands++;
+            continue;
+        }
+
+        /*copy band aside , it is kept only when no step began writing to it during the copy ,
+         *cells are read with relaxed atomic loads as explorer may be writing them (MAP_SET)*/
+        First = Band << Monitor->BandShift;
+        Size  = ((Monitor->Cells - First) < ((u32)1 << Monitor->BandShift)) ? (Monitor->Cells - First) : ((u32)1 << Monitor->BandShift);
+        for(u32 i = 0; i < Size; i++)
+        {
+            Snapshot->Band[i] = __atomic_load_n(&Monitor->Status[First + i], __ATOMIC_RELAXED);
+        }
+        atomic_thread_fence(memory_order_acquire);
+        if( Stamp != atomic_load_explicit(&Monitor->BandStep[Band], memory_order_relaxed) )
+        {
+            Snapshot->BusyBands++;
+            continue;
+        }
+        memcpy(&Snapshot->Status[First], Snapshot->Band, Size);
+        Snapshot->BandStep[Band] = Stamp;
+        Copied++;
+    }
+
+    return Copied;
+
+}/*end of u32UpdateSnapshot()*/
+
+/*this function makes an explorer write a checkpoint every period while it searches and starts checkpoint
+ *writer thread
+ *Arguments : pointer to explorer , pointer to checkpoint state , checkpoint file name , period in nanoseconds
+ *Return    : ERROR_NONE , ERROR_OPEN_FILE if file name is longer than CHECKPOINT_NAME_SIZE , ERROR_NO_MEMORY
+ *            or ERROR_THREAD */
+u8 u8StartCheckpoints(explorer *Explorer, checkpoint *Checkpoint, const char *FileName, u64 Period)
+{
+    cellmap *map = &Explorer->Outputmap;
+    u64 Cells = (u64)map->Stride * (map->Height+2);
+
+    memset(Checkpoint, 0, sizeof(checkpoint));
+    if( (strlen(FileName) + 5) > CHECKPOINT_NAME_SIZE )
+    {
+        return ERROR_OPEN_FILE;
+    }
+    strcpy(Checkpoint->FileName, FileName);
+    sprintf(Checkpoint->TempName, "%s.tmp", FileName);
+    Checkpoint->Period    = Period;
+    Checkpoint->Due       = u64ReadClock() + Period;
+    Checkpoint->NextCheck = Explorer->VisitedCells + CHECKPOINT_CHECK_STEPS;
+
+    /*a step writes cells one row above and below its first cell at most , bands are longer than two rows
+     *so a step writes two bands at most and a slice copies them again before next band*/
+    Checkpoint->BandShift = CHECKPOINT_BAND_SHIFT;
+    while( ((u64)1 << Checkpoint->BandShift) <= (2 * (u64)map->Stride) )
+    {
+        Checkpoint->BandShift++;
+    }
+    Checkpoint->Bands = (u32)((Cells + ((u64)1 << Checkpoint->BandShift) - 1) >> Checkpoint->BandShift);
+
+    /*branch points have their own buffer that grows with branch stack*/
+    Checkpoint->ImageSize  = CHECKPOINT_HEADER_SIZE + OUTPUT_MAP_PLANES * ((Cells + 7) / 8);
+    Checkpoint->Image      = (u8 *)malloc((size_t)Checkpoint->ImageSize);
+    Checkpoint->Dirty      = (u8 *)calloc(Checkpoint->Bands, sizeof(u8));
+    Checkpoint->DirtyBands = (u32 *)malloc((size_t)Checkpoint->Bands * sizeof(u32));
+    if( (NULL == Checkpoint->Image) || (NULL == Checkpoint->Dirty) || (NULL == Checkpoint->DirtyBands) )
+    {
+        free(Checkpoint->Image);
+        free(Checkpoint->Dirty);
+        free(Checkpoint->DirtyBands);
+        Checkpoint->Image = NULL;
+        return ERROR_NO_MEMORY;
+    }
+
+#if !defined(_WIN32)
+    pthread_mutex_init(&Checkpoint->Lock, NULL);
+    pthread_cond_init(&Checkpoint->Wake, NULL);
+    if( 0 != pthread_create(&Checkpoint->Writer, NULL, pvCheckpointWriter, Checkpoint) )
+    {
+        pthread_mutex_destroy(&Checkpoint->Lock);
+        pthread_cond_destroy(&Checkpoint->Wake);
+        free(Checkpoint->Image);
+        free(Checkpoint->Dirty);
+        free(Checkpoint->DirtyBands);
+        Checkpoint->Image = NULL;
+        return ERROR_THREAD;
+    }
+#endif
+
+    Explorer->Checkpoint = Checkpoint;
+
+    return ERROR_NONE;
+
+}/*end of u8StartCheckpoints()*/
+
+/*this function starts copying a checkpoint image if one is due , copies next slice of image while one is
+ *copied and hands a complete image to writer thread , it is called by u8StepSearch(); at end of a step
+ *Arguments : pointer to explorer with checkpoints
+ *Return    : void */
+static void voidWriteCheckpoint(explorer *Explorer)
+{
+    checkpoint *Checkpoint = Explorer->Checkpoint;
+    u32 Stride = Explorer->Outputmap.Stride;
+    u64 Now = u64ReadClock();
+    u32 Slice = 0;
+
+    if( FALSE == Checkpoint->Copying )
+    {
+        Checkpoint->NextCheck = Explorer->VisitedCells + CHECKPOINT_CHECK_STEPS;
+        if( Now < Checkpoint->Due )
+        {
+            return;
+        }
+        Checkpoint->Due = Now + Checkpoint->Period;
+
+#if !defined(_WIN32)
+        u8 Pending;
+
+        /*previous image is still being written , this checkpoint is skipped*/
+        pthread_mutex_lock(&Checkpoint->Lock);
+        Pending = Checkpoint->Pending;
+        pthread_mutex_unlock(&Checkpoint->Lock);
+        if( TRUE == Pending )
+        {
+            Checkpoint->Skipped++;
+            return;
+        }
+#endif
+        Checkpoint->Copying     = TRUE;
+        Checkpoint->NextBand    = 0;
+        Checkpoint->BranchCount = 0;
+    }
+    else
+    {
+        /*cells this step wrote are next to cell it began on , their bands are copied again if they were copied
+         *and branch points it popped are copied again*/
+        voidMarkCheckpointBand(Checkpoint, (Checkpoint->LastCell - Stride) >> Checkpoint->BandShift);
+        voidMarkCheckpointBand(Checkpoint, (Checkpoint->LastCell + Stride) >> Checkpoint->BandShift);
+        if( Checkpoint->BranchCount > Explorer->BranchStack.Size )
+        {
+            Checkpoint->BranchCount = Explorer->BranchStack.Size;
+        }
+    }
+    Checkpoint->LastCell = Explorer->CurrentCell;
+    /*every step is seen while image is copied*/
+    Checkpoint->NextCheck = Explorer->VisitedCells;
+
+    /*copy a slice , bands written since they were copied first*/
+    while( (Slice < CHECKPOINT_SLICE_BANDS) && (0 != Checkpoint->DirtyCount) )
+    {
+        u32 Band = Checkpoint->DirtyBands[--Checkpoint->DirtyCount];
+
+        Checkpoint->Dirty[Band] = FALSE;
+        voidCopyCheckpointBand(Explorer, Band);
+        Slice++;
+    }
+    while( (Slice < CHECKPOINT_SLICE_BANDS) && (Checkpoint->NextBand < Checkpoint->Bands) )
+    {
+        voidCopyCheckpointBand(Explorer, Checkpoint->NextBand);
+        Checkpoint->NextBand++;
+        Slice++;
+    }
+    if( FALSE == u8CopyCheckpointBranches(Explorer) )
+    {
+        voidDropCheckpointCopy(Checkpoint);
+        Checkpoint->Copying   = FALSE;
+        Checkpoint->NextCheck = Explorer->VisitedCells + CHECKPOINT_CHECK_STEPS;
+#if !defined(_WIN32)
+        pthread_mutex_lock(&Checkpoint->Lock);
+#endif
+        Checkpoint->Failed++;
+#if !defined(_WIN32)
+        pthread_mutex_unlock(&Checkpoint->Lock);
+#endif
+    }
+
+    /*image is explorer at end of this step once nothing is left to copy*/
+    else if( (Checkpoint->NextBand == Checkpoint->Bands) && (0 == Checkpoint->DirtyCount) &&
+             (Checkpoint->BranchCount == Explorer->BranchStack.Size) )
+    {
+        voidCopyCheckpointHeader(Explorer);
+        Checkpoint->Copying   = FALSE;
+        Checkpoint->NextCheck = Explorer->VisitedCells + CHECKPOINT_CHECK_STEPS;
+#if defined(_WIN32)
+        /*there is no writer thread , checkpoint is written by search itself*/
+        if( TRUE == u8SaveCheckpoint(Checkpoint) )
+        {
+            Checkpoint->Written++;
+        }
+        else
+        {
+            Checkpoint->Failed++;
+        }
+#else
+        /*writer thread writes image while search goes on*/
+        pthread_mutex_lock(&Checkpoint->Lock);
+        Checkpoint->Pending = TRUE;
+        pthread_cond_signal(&Checkpoint->Wake);
+        pthread_mutex_unlock(&Checkpoint->Lock);
+#endif
+    }
+
+    if( (u64ReadClock() - Now) > Checkpoint->LongestStall )
+    {
+        Checkpoint->LongestStall = u64ReadClock() - Now;
+    }
+
+}/*end of voidWriteCheckpoint()*/
+
+/*this function waits for pending checkpoint image to be written , stops writer thread and stops checkpoints
+ *of an explorer , an image that is still being copied is dropped
+ *Arguments : pointer to explorer with checkpoints
+ *Return    : void */
+void voidFinishCheckpoints(explorer *Explorer)
+{
+    checkpoint *Checkpoint = Explorer->Checkpoint;
+
+#if !defined(_WIN32)
+    /*writer writes pending image before it sees Stop*/
+    pthread_mutex_lock(&Checkpoint->Lock);
+    Checkpoint->Stop = TRUE;
+    pthread_cond_signal(&Checkpoint->Wake);
+    pthread_mutex_unlock(&Checkpoint->Lock);
+    pthread_join(Checkpoint->Writer, NULL);
+    pthread_cond_destroy(&Checkpoint->Wake);
+    pthread_mutex_destroy(&Checkpoint->Lock);
+#endif
+    free(Checkpoint->Image);
+    free(Checkpoint->Branches);
+    free(Checkpoint->Dirty);
+    free(Checkpoint->DirtyBands);
+    Checkpoint->Image          = NULL;
+    Checkpoint->ImageSize      = 0;
+    Checkpoint->Branches       = NULL;
+    Checkpoint->BranchCapacity = 0;
+    Checkpoint->Dirty          = NULL;
+    Checkpoint->DirtyBands     = NULL;
+    Checkpoint->Copying        = FALSE;
+    Explorer->Checkpoint       = NULL;
+
+}/*end of voidFinishCheckpoints()*/
+
+/*this function copies bit planes of one output map band to checkpoint image
+ *Arguments : pointer to explorer with checkpoints , band number
+ *Return    : void */
+static void voidCopyCheckpointBand(explorer *Explorer, u32 Band)
+{
+    checkpoint *Checkpoint = Explorer->Checkpoint;
+    cellmap    *map        = &Explorer->Outputmap;
+    u64 Cells      = (u64)map->Stride * (map->Height+2);
+    u64 PlaneBytes = (Cells + 7) / 8;
+    u8  *Planes    = &Checkpoint->Image[CHECKPOINT_HEADER_SIZE];
+    /*bands start on a byte of planes , last band ends with map*/
+    u64 First      = ((u64)Band << Checkpoint->BandShift) / 8;
+    u64 Last       = (((u64)(Band+1) << Checkpoint->BandShift) / 8 < PlaneBytes) ? (((u64)(Band+1) << Checkpoint->BandShift) / 8) : PlaneBytes;
+
+    /*bit planes of packed codes*/
+#if MAP_PACKED == TRUE
+    /*packed map already holds planes of codes*/
+    for(u8 p = 0; p < OUTPUT_MAP_PLANES; p++)
+    {
+        for(u64 i = First; i < Last; i++)
+        {
+            Planes[p*PlaneBytes + i] = (u8)(map->Bits[(u64)p*map->Words + (i >> 3)] >> (8 * (i & 7)));
+        }
+    }
+#else
+    /*bit p of a code is spread to byte p so bytes of 8 cells are made in one pass over band*/
+    const u32 Spread[8] = {0x000000, 0x000001, 0x000100, 0x000101, 0x010000, 0x010001, 0x010100, 0x010101};
+
+    for(u64 i = First; i < Last; i++)
+    {
+        u32 Bytes = 0;
+        u32 Count = ((Cells - i*8) < 8) ? (u32)(Cells - i*8) : 8;
+
+        for(u32 b = 0; b < Count; b++)
+        {
+            Bytes |= Spread[StatusToCode[MAP_GET(map, (u32)(i*8 + b))]] << b;
+        }
+        for(u8 p = 0; p < OUTPUT_MAP_PLANES; p++)
+        {
+            Planes[p*PlaneBytes + i] = (u8)(Bytes >> (8 * p));
+        }
+    }
+#endif
+
+}/*end of voidCopyCheckpointBand()*/
+
+/*this function marks a band that was copied to checkpoint image to be copied again
+ *Arguments : pointer to checkpoint state , band number
+ *Return    : void */
+static void voidMarkCheckpointBand(checkpoint *Checkpoint, u32 Band)
+{
+    /*bands not copied yet are copied as they are when sweep gets to them*/
+    if( (Band < Checkpoint->NextBand) && (FALSE == Checkpoint->Dirty[Band]) )
+    {
+        Checkpoint->Dirty[Band] = TRUE;
+        Checkpoint->DirtyBands[Checkpoint->DirtyCount] = Band;
+        Checkpoint->DirtyCount++;
+    }
+
+}/*end of voidMarkCheckpointBand()*/
+
+/*this function copies branch points pushed since they were copied to checkpoint image , a slice at most
+ *Arguments : pointer to explorer with checkpoints
+ *Return    : TRUE if branch points were copied , FALSE if there is no memory for them */
+static u8 u8CopyCheckpointBranches(explorer *Explorer)
+{
+    checkpoint *Checkpoint = Explorer->Checkpoint;
+    u32 Count = Explorer->BranchStack.Size - Checkpoint->BranchCount;
+
+    if( Count > CHECKPOINT_SLICE_BRANCHES )
+    {
+        Count = CHECKPOINT_SLICE_BRANCHES;
+    }
+
+    /*buffer grows to branch stack capacity*/
+    if( (Checkpoint->BranchCount + Count) > Checkpoint->BranchCapacity )
+    {
+        u8 *NewBranches = (u8 *)realloc(Checkpoint->Branches, 4 * (size_t)Explorer->BranchStack.Capacity);
+
+        if( NULL == NewBranches )
+        {
+            return FALSE;
+        }
+        Checkpoint->Branches       = NewBranches;
+        Checkpoint->BranchCapacity = Explorer->BranchStack.Capacity;
+    }
+
+    /*branch points , bottom of stack first*/
+    for(u32 i = Checkpoint->BranchCount; i < (Checkpoint->BranchCount + Count); i++)
+    {
+        voidWriteLittleEndian(&Checkpoint->Branches[4*(u64)i], Explorer->BranchStack.Entries[i]);
+    }
+    Checkpoint->BranchCount += Count;
+    return TRUE;
+
+}/*end of u8CopyCheckpointBranches()*/
+
+/*this function writes checkpoint header of an explorer to its checkpoint image
+ *Arguments : pointer to explorer with checkpoints
+ *Return    : void */
+static void voidCopyCheckpointHeader(explorer *Explorer)
+{
+    u8 *Header = Explorer->Checkpoint->Image;
+
+    memset(Header, 0, CHECKPOINT_HEADER_SIZE);
+    memcpy(Header, CHECKPOINT_FILE_MAGIC, 4);
+    voidWriteLittleEndian(&Header[4],  Explorer->Outputmap.Width);
+    voidWriteLittleEndian(&Header[8],  Explorer->Outputmap.Height);
+    voidWriteLittleEndian(&Header[12], Explorer->CurrentCell);
+    voidWriteLittleEndian(&Header[16], Explorer->EntryCell);
+    voidWriteLittleEndian(&Header[20], Explorer->ReachableCells);
+    voidWriteLittleEndian(&Header[24], Explorer->VisitedCells);
+    voidWriteLittleEndian(&Header[28], Explorer->Backtracks);
+    voidWriteLittleEndian(&Header[32], Explorer->FrontierCells);
+    voidWriteLittleEndian(&Header[36], Explorer->FrontierRescans);
+    voidWriteLittleEndian(&Header[40], Explorer->BranchStack.Size);
+    voidWriteLittleEndian(&Header[44], Explorer->BranchStack.HighWater);
+    voidWriteLittleEndian(&Header[48], (u32)Explorer->RouteCells);
+    voidWriteLittleEndian(&Header[52], (u32)(Explorer->RouteCells >> 32));
+    Header[56] = Explorer->DeadendCondition;
+    Header[57] = Explorer->Planner;
+
+}/*end of voidCopyCheckpointHeader()*/
+
+/*this function drops checkpoint image copied so far so next copy starts from first band
+ *Arguments : pointer to checkpoint state
+ *Return    : void */
+static void voidDropCheckpointCopy(checkpoint *Checkpoint)
+{
+    while( 0 != Checkpoint->DirtyCount )
+    {
+        Checkpoint->DirtyCount--;
+        Checkpoint->Dirty[Checkpoint->DirtyBands[Checkpoint->DirtyCount]] = FALSE;
+    }
+    Checkpoint->NextBand    = 0;
+    Checkpoint->BranchCount = 0;
+
+}/*end of voidDropCheckpointCopy()*/
+
+/*this function writes checkpoint image to temporary file and renames it to checkpoint file
+ *Arguments : pointer to checkpoint state with an image
+ *Return    : TRUE if checkpoint was written , FALSE otherwise */
+static u8 u8SaveCheckpoint(checkpoint *Checkpoint)
+{
+    u8  Written = TRUE;
+    FILE *File = fopen(Checkpoint->TempName, "wb");
+
+    if( NULL == File )
+    {
+        return FALSE;
+    }
+    Written &= (Checkpoint->ImageSize == fwrite(Checkpoint->Image, 1, (size_t)Checkpoint->ImageSize, File));
+    if( 0 != Checkpoint->BranchCount )
+    {
+        Written &= (Checkpoint->BranchCount == fwrite(Checkpoint->Branches, 4, Checkpoint->BranchCount, File));
+    }
+
+    /*checkpoint file is only replaced by a checkpoint that is on disk*/
+    Written &= (0 == fflush(File));
+#if !defined(_WIN32)
+    Written &= (0 == fsync(fileno(File)));
+#endif
+    Written &= (0 == fclose(File));
+    if( TRUE == Written )
+    {
+#if defined(_WIN32)
+        remove(Checkpoint->FileName);
+#endif
+        Written = (0 == rename(Checkpoint->TempName, Checkpoint->FileName)) ? TRUE : FALSE;
+    }
+    return Written;
+
+}/*end of u8SaveCheckpoint()*/
+
+#if !defined(_WIN32)
+/*this function is checkpoint writer thread , it writes every pending image until it is stopped
+ *Arguments : pointer to checkpoint state
+ *Return    : NULL */
+static void *pvCheckpointWriter(void *Argument)
+{
+    checkpoint *Checkpoint = (checkpoint *)Argument;
+
+    pthread_mutex_lock(&Checkpoint->Lock);
+    while( TRUE )
+    {
+        u8 Saved;
+
+        while( (FALSE == Checkpoint->Pending) && (FALSE == Checkpoint->Stop) )
+        {
+            pthread_cond_wait(&Checkpoint->Wake, &Checkpoint->Lock);
+        }
+        if( FALSE == Checkpoint->Pending )
+        {
+            break;
+        }
+
+        /*search does not touch image while it is pending*/
+        pthread_mutex_unlock(&Checkpoint->Lock);
+        Saved = u8SaveCheckpoint(Checkpoint);
+        pthread_mutex_lock(&Checkpoint->Lock);
+        if( TRUE == Saved )
+        {
+            Checkpoint->Written++;
+        }
+        else
+        {
+            Checkpoint->Failed++;
+        }
+        Checkpoint->Pending = FALSE;
+    }
+    pthread_mutex_unlock(&Checkpoint->Lock);
+    return NULL;
+
+}/*end of pvCheckpointWriter()*/
+#endif
+
+/*this function restores search state of an explorer from a checkpoint file so u8WalkMap(); goes on
+ *where search stopped , output map is not valid anymore if checkpoint can not be restored
+ *Arguments : pointer to explorer created by u8CreateExplorer(); , checkpoint file name ,
+ *            pointer that receives planner checkpoint was written with (PLANNER_xxx)
+ *Return    : ERROR_NONE , ERROR_OPEN_FILE , ERROR_READ_FILE , ERROR_BAD_FILE if file is not a valid checkpoint
+ *            of input map , ERROR_PLANNER if it was written by a search with another planner than explorer has
+ *            or an error of u8PushBranch(); */
+u8 u8LoadCheckpoint(explorer *Explorer, const char *FileName, u8 *Planner)
+{
+    cellmap *map = &Explorer->Outputmap;
+    u64  Cells      = (u64)map->Stride * (map->Height+2);
+    u64  PlaneBytes = (Cells + 7) / 8;
+    u8   Header[CHECKPOINT_HEADER_SIZE];
+    u8   Chunk[OUTPUT_MAP_PLANES][CHECKPOINT_CHUNK];
+    u32  Branches;
+    u32  CurrentCell;
+    u64  FileSize;
+    int  Result;
+    FILE *File = fopen(FileName, "rb");
+
+    *Planner = Explorer->Planner;
+    if( NULL == File )
+    {
+        return ERROR_OPEN_FILE;
+    }
+#if defined(_WIN32)
+    Result   = _fseeki64(File, 0, SEEK_END);
+    FileSize = (u64)_ftelli64(File);
+#else
+    Result   = fseeko(File, 0, SEEK_END);
+    FileSize = (u64)ftello(File);
+#endif
+    rewind(File);
+    if( 0 != Result )
+    {
+        fclose(File);
+        return ERROR_READ_FILE;
+    }
+
+    /*Check header and file size*/
+    /*=============================================*/
+    if( 1 != fread(Header, CHECKPOINT_HEADER_SIZE, 1, File) )
+    {
+        fclose(File);
+        return ERROR_BAD_FILE;
+    }
+    /*branch stack can not be deeper than map has cells nor than its own high water mark*/
+    Branches    = u32ReadLittleEndian(&Header[40]);
+    CurrentCell = u32ReadLittleEndian(&Header[12]);
+    if( (0 != memcmp(Header, CHECKPOINT_FILE_MAGIC, 4)) || (u32ReadLittleEndian(&Header[4]) != map->Width) ||
+        (u32ReadLittleEndian(&Header[8]) != map->Height) || (CurrentCell >= Cells) ||
+        (u32ReadLittleEndian(&Header[16]) >= Cells) || (Branches > Cells) ||
+        (Branches > u32ReadLittleEndian(&Header[44])) || (Header[56] > TRUE) || (Header[57] > PLANNER_NEAREST) ||
+        (FileSize != (CHECKPOINT_HEADER_SIZE + OUTPUT_MAP_PLANES * PlaneBytes + 4 * (u64)Branches)) )
+    {
+        fclose(File);
+        return ERROR_BAD_FILE;
+    }
+    /*planner marks and route counts of checkpoint are only right for planner it was written with*/
+    *Planner = Header[57];
+    if( Header[57] != Explorer->Planner )
+    {
+        fclose(File);
+        return ERROR_PLANNER;
+    }
+
+    /*Output map from same chunk of every bit plane*/
+    /*=============================================*/
+    for(u64 First = 0; First < PlaneBytes; First += CHECKPOINT_CHUNK)
+    {
+        u32 Bytes = ((PlaneBytes - First) < CHECKPOINT_CHUNK) ? (u32)(PlaneBytes - First) : CHECKPOINT_CHUNK;
+
+        for(u8 p = 0; p < OUTPUT_MAP_PLANES; p++)
+        {
+#if defined(_WIN32)
+            Result = _fseeki64(File, (long long)(CHECKPOINT_HEADER_SIZE + p*PlaneBytes + First), SEEK_SET);
+#else
+            Result = fseeko(File, (off_t)(CHECKPOINT_HEADER_SIZE + p*PlaneBytes + First), SEEK_SET);
+#endif
+            if( (0 != Result) || (Bytes != fread(Chunk[p], 1, Bytes, File)) )
+            {
+                fclose(File);
+                return ERROR_READ_FILE;
+            }
+        }
+        for(u32 i = 0; i < Bytes; i++)
+        {
+            for(u32 b = 0; (b < 8) && (((First + i) * 8 + b) < Cells); b++)
+            {
+                u8 Code = (u8)(((Chunk[0][i] >> b) & 1) | (((Chunk[1][i] >> b) & 1) << 1) | (((Chunk[2][i] >> b) & 1) << 2));
+
+                MAP_SET(map, (u32)((First + i) * 8 + b), CodeToStatus[Code]);
+            }
+        }
+    }
+#if defined(_WIN32)
+    if( 0 != _fseeki64(File, (long long)(CHECKPOINT_HEADER_SIZE + OUTPUT_MAP_PLANES * PlaneBytes), SEEK_SET) )
+#else
+    if( 0 != fseeko(File, (off_t)(CHECKPOINT_HEADER_SIZE + OUTPUT_MAP_PLANES * PlaneBytes), SEEK_SET) )
+#endif
+    {
+        fclose(File);
+        return ERROR_READ_FILE;
+    }
+
+    /*explorer stands on a cell it knows to be safe*/
+    if( (VISITED != MAP_GET(map, CurrentCell)) && (CURRENT_LOCATION != MAP_GET(map, CurrentCell)) &&
+        (DISCOVERED_NOT_MINE != MAP_GET(map, CurrentCell)) )
+    {
+        fclose(File);
+        return ERROR_BAD_FILE;
+    }
+
+    /*Branch stack , every branch point is a cell explorer stood on*/
+    /*=============================================*/
+    Explorer->BranchStack.Size = 0;
+    for(u32 i = 0; i < Branches; i++)
+    {
+        u8  Entry[4];
+        u32 Index;
+
+        if( 1 != fread(Entry, 4, 1, File) )
+        {
+            fclose(File);
+            return ERROR_READ_FILE;
+        }
+        Index = u32ReadLittleEndian(Entry);
+        if( (Index >= Cells) || ((VISITED != MAP_GET(map, Index)) && (CURRENT_LOCATION != MAP_GET(map, Index))) )
+        {
+            fclose(File);
+            return ERROR_BAD_FILE;
+        }
+        if( ERROR_NONE != u8PushBranch(Explorer, Index) )
+        {
+            fclose(File);
+            return Explorer->Error;
+        }
+    }
+    fclose(File);
+
+    /*Search state*/
+    /*=============================================*/
+    Explorer->CurrentCell            = CurrentCell;
+    Explorer->EntryCell              = u32ReadLittleEndian(&Header[16]);
+    Explorer->ReachableCells         = u32ReadLittleEndian(&Header[20]);
+    Explorer->VisitedCells           = u32ReadLittleEndian(&Header[24]);
+    Explorer->Backtracks             = u32ReadLittleEndian(&Header[28]);
+    Explorer->FrontierCells          = u32ReadLittleEndian(&Header[32]);
+    Explorer->FrontierRescans        = u32ReadLittleEndian(&Header[36]);
+    Explorer->BranchStack.HighWater  = u32ReadLittleEndian(&Header[44]);
+    Explorer->RouteCells             = (u64)u32ReadLittleEndian(&Header[48]) | ((u64)u32ReadLittleEndian(&Header[52]) << 32);
+    Explorer->DeadendCondition       = Header[56];
+
+    return ERROR_NONE;
+
+}/*end of u8LoadCheckpoint()*/
+
+/*this function sets up a simulated sensor over an input map
+ *Arguments : pointer to sensor , pointer to sensed map , latency and jitter of a sensor read in nanoseconds , random seed
+ *Return    : void */
+void voidCreateSensor(sensor *Sensor, const cellmap *Inputmap, u64 Latency, u64 Jitter, u32 Seed)
+{
+    memset(Sensor, 0, sizeof(sensor));
+    Sensor->Source.Probe   = voidProbeSensor;
+    Sensor->Source.Read    = u8ReadSensor;
+    Sensor->Source.Context = Sensor;
+    Sensor->Inputmap       = Inputmap;
+    Sensor->Latency        = Latency;
+    Sensor->Jitter         = Jitter;
+    /*random state must never be 0*/
+    Sensor->Random         = ((u64)Seed << 1) | 1;
+
+}/*end of voidCreateSensor()*/
+
+/*this function starts sensor reads of cells , cells of one tile share a read and cells already probed are skipped
+ *Arguments : pointer to cell source of a sensor , array of cell indices and its number of entries
+ *Return    : void */
+static void voidProbeSensor(cellsource *Source, const u32 *Cells, u32 Count)
+{
+    sensor *Sensor = (sensor *)Source->Context;
+    u32 TileStride = (Sensor->Inputmap->Stride + SENSOR_TILE_SIZE - 1) >> SENSOR_TILE_SHIFT;
+    /*tile and ready time of every sensor read started by this probe*/
+    u32 ReadTile[SENSOR_MAX_PENDING];
+    u64 ReadReady[SENSOR_MAX_PENDING];
+    u32 Reads = 0;
+    u64 Now = u64ReadClock();
+
+    for(u32 c = 0; c < Count; c++)
+    {
+        u32 Cell = Cells[c];
+        u32 Tile = ((Cell / Sensor->Inputmap->Stride) >> SENSOR_TILE_SHIFT) * TileStride +
+                   ((Cell % Sensor->Inputmap->Stride) >> SENSOR_TILE_SHIFT);
+        u32 r    = 0;
+        u64 Ready;
+
+        if( SENSOR_MAX_PENDING != u32FindPendingCell(Sensor, Cell) )
+        {
+            continue;
+        }
+
+        /*join a read of the same tile started by this probe or start a new one on first free channel*/
+        while( (r < Reads) && (ReadTile[r] != Tile) )
+        {
+            r++;
+        }
+        if( r < Reads )
+        {
+            Ready = ReadReady[r];
+        }
+        else
+        {
+            u32 Channel = 0;
+            u64 Start;
+
+            for(u32 i = 1; i < SENSOR_CHANNELS; i++)
+            {
+                if( Sensor->ChannelFree[i] < Sensor->ChannelFree[Channel] )
+                {
+                    Channel = i;
+                }
+            }
+            Start = (Sensor->ChannelFree[Channel] > Now) ? Sensor->ChannelFree[Channel] : Now;
+            Ready = Start + Sensor->Latency +
+                    ((0 == Sensor->Jitter) ? 0 : (u32NextRandom(&Sensor->Random) % (Sensor->Jitter + 1)));
+            Sensor->ChannelFree[Channel] = Ready;
+            Sensor->SensorReads++;
+            if( Reads < SENSOR_MAX_PENDING )
+            {
+                ReadTile[Reads]  = Tile;
+                ReadReady[Reads] = Ready;
+                Reads++;
+            }
+        }
+
+        /*oldest pending cell is dropped when all entries are taken , it is probed again if it is read*/
+        Sensor->PendingCell[Sensor->PendingNext]  = Cell;
+        Sensor->PendingReady[Sensor->PendingNext] = Ready;
+        Sensor->PendingNext = (Sensor->PendingNext + 1) % SENSOR_MAX_PENDING;
+        Sensor->Probes++;
+    }
+
+}/*end of voidProbeSensor()*/
+
+/*this function waits until status of a probed cell is read by sensor , a cell that was not probed is probed first
+ *Arguments : pointer to cell source of a sensor , cell index
+ *Return    : input map status of cell */
+static u8 u8ReadSensor(cellsource *Source, u32 Cell)
+{
+    sensor *Sensor = (sensor *)Source->Context;
+    u32 Entry = u32FindPendingCell(Sensor, Cell);
+    u64 Now;
+
+    if( SENSOR_MAX_PENDING == Entry )
+    {
+        voidProbeSensor(Source, &Cell, 1);
+        Entry = u32FindPendingCell(Sensor, Cell);
+    }
+
+    /*sensor has no way to tell it is done , poll clock until read time passes*/
+    Now = u64ReadClock();
+    if( Now < Sensor->PendingReady[Entry] )
+    {
+        Sensor->WaitTime += Sensor->PendingReady[Entry] - Now;
+        while( u64ReadClock() < Sensor->PendingReady[Entry] )
+        {
+        }
+    }
+
+    Sensor->PendingCell[Entry] = 0;
+    Sensor->CellReads++;
+    return MAP_GET(Sensor->Inputmap, Cell);
+
+}/*end of u8ReadSensor()*/
+
+/*this function finds pending entry of a probed cell
+ *Arguments : pointer to sensor , cell index
+ *Return    : entry index or SENSOR_MAX_PENDING if cell is not pending */
+static u32 u32FindPendingCell(const sensor *Sensor, u32 Cell)
+{
+    for(u32 i = 0; i < SENSOR_MAX_PENDING; i++)
+    {
+        if( Cell == Sensor->PendingCell[i] )
+        {
+            return i;
+        }
+    }
+    return SENSOR_MAX_PENDING;
+
+}/*end of u32FindPendingCell()*/
+
+/*this function builds block summary of an output map from its current cell statuses , it is attached
+ *to an explorer afterwards (Explorer->Summary) so that search keeps it up to date
+ *Arguments : pointer to block summary , pointer to output map
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY */
+u8 u8CreateSummary(blocksummary *Summary, const cellmap *map)
+{
+    u8 Level = 0;
+
+    memset(Summary, 0, sizeof(blocksummary));
+    Summary->Stride = map->Stride;
+    Summary->Rows   = map->Height + 2;
+
+    /*add levels of blocks twice as big until a level has one block*/
+    do
+    {
+        u32 Shift = SUMMARY_BLOCK_SHIFT + Level;
+
+        Summary->BlockCols[Level] = ((Summary->Stride - 1) >> Shift) + 1;
+        Summary->BlockRows[Level] = ((Summary->Rows - 1) >> Shift) + 1;
+        Summary->Count[Level] = (blockcount *)calloc((size_t)Summary->BlockCols[Level] * Summary->BlockRows[Level], sizeof(blockcount));
+        if( NULL == Summary->Count[Level] )
+        {
+            Summary->Levels = Level;
+            voidFreeSummary(Summary);
+            return ERROR_NO_MEMORY;
+        }
+        Level++;
+    } while( (Summary->BlockCols[Level-1] > 1) || (Summary->BlockRows[Level-1] > 1) );
+    Summary->Levels = Level;
+
+    /*level 0 blocks changed by search are marked and folded into levels above when a question needs them*/
+    Summary->Folded      = (blockcount *)malloc((size_t)Summary->BlockCols[0] * Summary->BlockRows[0] * sizeof(blockcount));
+    Summary->Dirty       = (u8 *)calloc((size_t)Summary->BlockCols[0] * Summary->BlockRows[0], sizeof(u8));
+    Summary->DirtyBlocks = (u32 *)malloc((size_t)Summary->BlockCols[0] * Summary->BlockRows[0] * sizeof(u32));
+    if( (NULL == Summary->Folded) || (NULL == Summary->Dirty) || (NULL == Summary->DirtyBlocks) )
+    {
+        voidFreeSummary(Summary);
+        return ERROR_NO_MEMORY;
+    }
+
+    /*count every cell in its level 0 block*/
+    for(u32 Row = 0; Row < Summary->Rows; Row++)
+    {
+        blockcount *BlockRow = &Summary->Count[0][(Row >> SUMMARY_BLOCK_SHIFT) * Summary->BlockCols[0]];
+
+        for(u32 Col = 0; Col < Summary->Stride; Col++)
+        {
+            u8 Class = SummaryClass[MAP_CELL(map, Row, Col)];
+            if( 0 != Class )
+            {
+                BlockRow[Col >> SUMMARY_BLOCK_SHIFT].Cells[Class-1]++;
+            }
+        }
+    }
+    /*add up blocks of every level into blocks above them*/
+    for(Level = 1; Level < Summary->Levels; Level++)
+    {
+        for(u32 Row = 0; Row < Summary->BlockRows[Level-1]; Row++)
+        {
+            for(u32 Col = 0; Col < Summary->BlockCols[Level-1]; Col++)
+            {
+                const blockcount *Block  = &Summary->Count[Level-1][Row * Summary->BlockCols[Level-1] + Col];
+                blockcount       *Parent = &Summary->Count[Level][(Row >> 1) * Summary->BlockCols[Level] + (Col >> 1)];
+
+                for(u8 Class = 0; Class < SUMMARY_CLASSES; Class++)
+                {
+                    Parent->Cells[Class] += Block->Cells[Class];
+                }
+            }
+        }
+    }
+    /*finished blocks of every level and whole map counts*/
+    for(Level = 0; Level < Summary->Levels; Level++)
+    {
+        for(u32 Block = 0; Block < (Summary->BlockCols[Level] * Summary->BlockRows[Level]); Block++)
+        {
+            if( (0 == Summary->Count[Level][Block].Cells[SUMMARY_UNKNOWN]) && (0 == Summary->Count[Level][Block].Cells[SUMMARY_FRONTIER]) )
+            {
+                Summary->Finished[Level]++;
+            }
+        }
+    }
+    memcpy(Summary->Total, Summary->Count[Summary->Levels - 1][0].Cells, sizeof(Summary->Total));
+    memcpy(Summary->Folded, Summary->Count[0], (size_t)Summary->BlockCols[0] * Summary->BlockRows[0] * sizeof(blockcount));
+
+    return ERROR_NONE;
+
+}/*end of u8CreateSummary()*/
+
+/*this function releases block counts of a block summary
+ *Arguments : pointer to block summary
+ *Return    : void */
+void voidFreeSummary(blocksummary *Summary)
+{
+    for(u8 Level = 0; Level < Summary->Levels; Level++)
+    {
+        free(Summary->Count[Level]);
+        Summary->Count[Level] = NULL;
+    }
+    free(Summary->Folded);
+    free(Summary->Dirty);
+    free(Summary->DirtyBlocks);
+    Summary->Folded      = NULL;
+    Summary->Dirty       = NULL;
+    Summary->DirtyBlocks = NULL;
+    Summary->DirtyCount  = 0;
+    Summary->Levels      = 0;
+
+}/*end of voidFreeSummary()*/
+
+/*this function moves one output map cell change into block summary , level 0 block holding the cell and
+ *whole map counts are only changed if cell class changes and block is marked to be folded into finished
+ *block counts and levels above
+ *Arguments : pointer to block summary , cell index , old and new cell status
+ *Return    : void */
+static void voidUpdateSummary(blocksummary *Summary, u32 Index, u8 OldStatus, u8 NewStatus)
+{
+    u8  OldClass = SummaryClass[OldStatus];
+    u8  NewClass = SummaryClass[NewStatus];
+    u32 Block;
+    blockcount *Count;
+
+    if( OldClass == NewClass )
+    {
+        return;
+    }
+
+    /*row of cell is found from row of last changed cell , walker changes cells one row apart at most*/
+    if( (Index - Summary->RowStart) >= Summary->Stride )
+    {
+        if( (Index - (Summary->RowStart + Summary->Stride)) < Summary->Stride )
+        {
+            Summary->Row++;
+            Summary->RowStart += Summary->Stride;
+        }
+        else if( (Index - (Summary->RowStart - Summary->Stride)) < Summary->Stride )
+        {
+            Summary->Row--;
+            Summary->RowStart -= Summary->Stride;
+        }
+        else
+        {
+            Summary->Row      = Index / Summary->Stride;
+            Summary->RowStart = Summary->Row * Summary->Stride;
+        }
+    }
+    Block = (Summary->Row >> SUMMARY_BLOCK_SHIFT) * Summary->BlockCols[0] + ((Index - Summary->RowStart) >> SUMMARY_BLOCK_SHIFT);
+    Count = &Summary->Count[0][Block];
+
+    if( 0 != OldClass )
+    {
+        Count->Cells[OldClass-1]--;
+        Summary->Total[OldClass-1]--;
+    }
+    if( 0 != NewClass )
+    {
+        Count->Cells[NewClass-1]++;
+        Summary->Total[NewClass-1]++;
+    }
+
+    /*finished blocks and levels above see the change once block is folded*/
+    if( FALSE == Summary->Dirty[Block] )
+    {
+        Summary->Dirty[Block] = TRUE;
+        Summary->DirtyBlocks[Summary->DirtyCount] = Block;
+        Summary->DirtyCount++;
+    }
+
+}/*end of voidUpdateSummary()*/
+
+/*this function folds level 0 blocks changed since last fold into blocks of levels above them
+ *Arguments : pointer to block summary
+ *Return    : void */
+static void voidFoldSummary(blocksummary *Summary)
+{
+    while( 0 != Summary->DirtyCount )
+    {
+        u32 Block = Summary->DirtyBlocks[--Summary->DirtyCount];
+        u32 Row   = Block / Summary->BlockCols[0];
+        u32 Col   = Block - Row * Summary->BlockCols[0];
+        blockcount *Folded = &Summary->Folded[Block];
+        blockcount *Count  = &Summary->Count[0][Block];
+        u32 Delta[SUMMARY_CLASSES];
+
+        /*counts only change by difference since last fold (unsigned differences wrap back when added)*/
+        for(u8 Class = 0; Class < SUMMARY_CLASSES; Class++)
+        {
+            Delta[Class] = Count->Cells[Class] - Folded->Cells[Class];
+        }
+        Summary->Finished[0] += (u32)(0 == (Count->Cells[SUMMARY_UNKNOWN] | Count->Cells[SUMMARY_FRONTIER])) -
+                                (u32)(0 == (Folded->Cells[SUMMARY_UNKNOWN] | Folded->Cells[SUMMARY_FRONTIER]));
+        *Folded = *Count;
+        Summary->Dirty[Block] = FALSE;
+
+        for(u8 Level = 1; Level < Summary->Levels; Level++)
+        {
+            blockcount *Count = &Summary->Count[Level][(Row >> Level) * Summary->BlockCols[Level] + (Col >> Level)];
+            u8 WasFinished = (0 == (Count->Cells[SUMMARY_UNKNOWN] | Count->Cells[SUMMARY_FRONTIER]));
+
+            for(u8 Class = 0; Class < SUMMARY_CLASSES; Class++)
+            {
+                Count->Cells[Class] += Delta[Class];
+            }
+            Summary->Finished[Level] += (u32)(0 == (Count->Cells[SUMMARY_UNKNOWN] | Count->Cells[SUMMARY_FRONTIER])) - (u32)WasFinished;
+        }
+    }
+
+}/*end of voidFoldSummary()*/
+
+/*this function finds DISCOVERED_NOT_MINE cell nearest to a cell (fewest rows plus columns) , blocks are searched
+ *from top level nearest first and blocks without frontier cells or farther than best cell found are skipped ,
+ *changed blocks are folded into levels above first
+ *Arguments : pointer to block summary , pointer to output map it summarizes , cell index , pointer that receives distance
+ *Return    : cell index of nearest frontier cell or 0 if there is none */
+u32 u32NearestFrontier(blocksummary *Summary, const cellmap *map, u32 Cell, u32 *Distance)
+{
+    u32 BestDistance = 0xFFFFFFFF;
+    u32 BestCell     = 0;
+
+    voidFoldSummary(Summary);
+    voidSearchFrontierBlock(Summary, map, (u8)(Summary->Levels - 1), 0, 0, Cell / Summary->Stride, Cell % Summary->Stride,
+                            &BestDistance, &BestCell);
+    *Distance = (0 == BestCell) ? 0 : BestDistance;
+
+    return BestCell;
+
+}/*end of u32NearestFrontier()*/
+
+/*this function searches one summary block and blocks below it for a frontier cell nearer than best one found
+ *Arguments : pointer to block summary , pointer to output map , level , block row and column ,
+ *            row and column of cell distance is measured from , pointers to best distance and best cell
+ *Return    : void */
+static void voidSearchFrontierBlock(const blocksummary *Summary, const cellmap *map, u8 Level, u32 BlockRow, u32 BlockCol,
+                                    u32 Row, u32 Col, u32 *BestDistance, u32 *BestCell)
+{
+    u32 ChildRow[4], ChildCol[4], ChildDistance[4];
+    u8  Children = 0;
+
+    /*skip blocks without frontier cells and blocks that can not hold a nearer one*/
+    if( (0 == Summary->Count[Level][BlockRow * Summary->BlockCols[Level] + BlockCol].Cells[SUMMARY_FRONTIER]) ||
+        (u32BlockDistance(Summary, Level, BlockRow, BlockCol, Row, Col) >= *BestDistance) )
+    {
+        return;
+    }
+
+    if( 0 == Level )
+    {
+        /*look at every cell of level 0 block*/
+        u32 FirstRow = BlockRow << SUMMARY_BLOCK_SHIFT;
+        u32 FirstCol = BlockCol << SUMMARY_BLOCK_SHIFT;
+        u32 EndRow   = ((FirstRow + (1u << SUMMARY_BLOCK_SHIFT)) < Summary->Rows) ? (FirstRow + (1u << SUMMARY_BLOCK_SHIFT)) : Summary->Rows;
+        u32 EndCol   = ((FirstCol + (1u << SUMMARY_BLOCK_SHIFT)) < Summary->Stride) ? (FirstCol + (1u << SUMMARY_BLOCK_SHIFT)) : Summary->Stride;
+
+        for(u32 r = FirstRow; r < EndRow; r++)
+        {
+            for(u32 c = FirstCol; c < EndCol; c++)
+            {
+                u32 Distance = ((r > Row) ? (r - Row) : (Row - r)) + ((c > Col) ? (c - Col) : (Col - c));
+
+                if( (Distance < *BestDistance) && (DISCOVERED_NOT_MINE == MAP_CELL(map, r, c)) )
+                {
+                    *BestDistance = Distance;
+                    *BestCell     = r * Summary->Stride + c;
+                }
+            }
+        }
+        return;
+    }
+
+    /*search 2 x 2 blocks of level below nearest first*/
+    for(u32 r = 2*BlockRow; (r <= 2*BlockRow + 1) && (r < Summary->BlockRows[Level-1]); r++)
+    {
+        for(u32 c = 2*BlockCol; (c <= 2*BlockCol + 1) && (c < Summary->BlockCols[Level-1]); c++)
+        {
+            u32 Distance = u32BlockDistance(Summary, (u8)(Level - 1), r, c, Row, Col);
+            u8  i = Children;
+
+            /*insertion in distance order*/
+            while( (i > 0) && (ChildDistance[i-1] > Distance) )
+            {
+                ChildRow[i]      = ChildRow[i-1];
+                ChildCol[i]      = ChildCol[i-1];
+                ChildDistance[i] = ChildDistance[i-1];
+                i--;
+            }
+            ChildRow[i]      = r;
+            ChildCol[i]      = c;
+            ChildDistance[i] = Distance;
+            Children++;
+        }
+    }
+    for(u8 i = 0; i < Children; i++)
+    {
+        voidSearchFrontierBlock(Summary, map, (u8)(Level - 1), ChildRow[i], ChildCol[i], Row, Col, BestDistance, BestCell);
+    }
+
+}/*end of voidSearchFrontierBlock()*/
+
+/*this function finds distance (rows plus columns) from a cell to nearest cell of a summary block
+ *Arguments : pointer to block summary , level , block row and column , row and column of cell
+ *Return    : distance , 0 if cell is in block */
+static u32 u32BlockDistance(const blocksummary *Summary, u8 Level, u32 BlockRow, u32 BlockCol, u32 Row, u32 Col)
+{
+    u32 Shift    = SUMMARY_BLOCK_SHIFT + Level;
+    u32 FirstRow = BlockRow << Shift;
+    u32 FirstCol = BlockCol << Shift;
+    /*last row and column of block , blocks of last row and column may be cut by map size*/
+    u32 LastRow  = (((u64)(BlockRow + 1) << Shift) < Summary->Rows) ? (((BlockRow + 1) << Shift) - 1) : (Summary->Rows - 1);
+    u32 LastCol  = (((u64)(BlockCol + 1) << Shift) < Summary->Stride) ? (((BlockCol + 1) << Shift) - 1) : (Summary->Stride - 1);
+    u32 Distance = 0;
+
+    if( Row < FirstRow )
+    {
+        Distance += FirstRow - Row;
+    }
+    else if( Row > LastRow )
+    {
+        Distance += Row - LastRow;
+    }
+    if( Col < FirstCol )
+    {
+        Distance += FirstCol - Col;
+    }
+    else if( Col > LastCol )
+    {
+        Distance += Col - LastCol;
+    }
+    return Distance;
+
+}/*end of u32BlockDistance()*/
+
+/*this function gives number of blocks of a summary level that have no unknown or frontier cells left ,
+ *changed blocks are folded into levels above first
+ *Arguments : pointer to block summary , level
+ *Return    : number of finished blocks */
+u32 u32FinishedBlocks(blocksummary *Summary, u8 Level)
+{
+    voidFoldSummary(Summary);
+    return Summary->Finished[Level];
+
+}/*end of u32FinishedBlocks()*/
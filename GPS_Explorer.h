@@ -0,0 +1,1200 @@
+/*==================================================================================*/
+/*==================================================================================*/
+/*Explorer library
+ *search engine of GPS_Project , an explorer holds whole state of one search (maps , branch stack ,
+ *route marks , trace stream and counters) and every function works only on the explorer or map
+ *passed to it , so any number of searches can live in one process and each of them can be run
+ *or stepped from its own thread
+ *
+ *Usage : u8CreateExplorer(); with an input map , then u8SearchMap(); or u8StartSearch(); and
+ *        u8StepSearch(); until it returns STEP_DONE , voidFreeExplorer(); releases explorer
+ *Build : GPS_Explorer.c is compiled with the program that uses it , build flags (-DMAP_PACKED=1 ...)
+ *        must be the same for both
+ *Errors : functions that can fail return an error code (ERROR_xxx) , printing it is left to the program*/
+/*==================================================================================*/
+/*==================================================================================*/
+#ifndef GPS_EXPLORER_H
+#define GPS_EXPLORER_H
+
+#include <stdio.h>
+#include <stdatomic.h>
+#include <signal.h>
+#if !defined(_WIN32)
+#include <pthread.h>
+#endif
+
+/*==================================================================================*/
+/*==================================================================================*/
+/*New Types definitions*/
+/*=========================================*/
+typedef unsigned char   u8;
+typedef unsigned int    u16;
+typedef unsigned int    u32;
+typedef unsigned long long u64;
+/*==================================================================================*/
+/*==================================================================================*/
+/*Define new data structure Tile Cache that keeps recently used tiles of a tiled map (MAP_TILED) in memory
+ *map is split in TILE_SIZE x TILE_SIZE cell tiles , tile t is tile row t / TileCols and tile column t % TileCols
+ *tiles are read from backing file when needed and changed tiles are written back when they are replaced*/
+typedef struct struct_tile_cache tilecache;
+struct struct_tile_cache
+{
+    FILE *File;        //backing file of map status
+    u64  DataOffset;   //file offset of first status byte
+    u8   Layout;       //layout of backing file (TILE_LAYOUT_xxx)
+    u32  TileCols;     //number of tiles in one tile row
+    u32  Tiles;        //number of tiles
+    u32  *TileSlot;    //cache slot holding each tile or TILE_NONE
+    u8   *TileStored;  //TRUE for tiles that have been written to backing file
+    u8   *Data;        //TILE_CACHE_SLOTS tiles of TILE_SIZE x TILE_SIZE status bytes
+    u32  *SlotTile;    //tile held by each cache slot or TILE_NONE
+    u64  *SlotLastUse; //clock value of last use of each cache slot
+    u8   *SlotDirty;   //TRUE for cache slots changed since they were read
+    u64  Clock;        //incremented every time another tile is used
+    u32  LastTile;     //last used tile and its cache slot , most accesses hit them
+    u32  LastSlot;
+    u64  Hits;         //accesses to tiles already in cache
+    u64  Misses;       //accesses that had to read a tile
+    u64  WriteBacks;   //changed tiles written to backing file
+    u8   Error;        //first tile read or write failure (ERROR_xxx) , ERROR_NONE if none
+};
+
+/*Define new data structure Map that holds a runtime sized rectangular map
+ *status of all cells including borders is stored row by row in one flat block so cell (row,col)
+ *is Status[row*Stride + col] and surrounding cells of cell index i are found by index arithmetic
+ *Right cell i+1 , Left cell i-1 , Upper cell i+Stride , Lower cell i-Stride
+ *a cell index is the same in input and output maps as both have the same layout*/
+typedef struct struct_map cellmap;
+struct struct_map
+{
+    u32  Width;       //number of map columns without borders
+    u32  Height;      //number of map rows without borders
+    u32  Stride;      //number of cells in one row including borders (Width+2)
+    u8   *Status;     //status of (Height+2) x (Width+2) cells (one byte per cell)
+    u8   Storage;     //where Status memory comes from (MAP_STORAGE_xxx)
+    u64  *Bits;       //status bit planes of packed maps (MAP_PACKED) , plane p is Bits[p*Words .. p*Words+Words-1]
+    u32  Words;       //number of 64 bit words in one bit plane
+    u8   Planes;      //number of bit planes , 2 for input maps and 3 for output maps
+    tilecache *Tiles; //tile cache of tiled maps (MAP_TILED)
+};
+
+/*Define new data structure Map Archive that holds an open map archive file and its band index ,
+ *bands are read and decoded one at a time so a map is never expanded in memory as a whole and any band
+ *can be read on its own through the index (u8ReadArchiveBand();)*/
+typedef struct struct_map_archive maparchive;
+struct struct_map_archive
+{
+    FILE *File;       //archive file
+    u32  Width;       //number of map columns without borders
+    u32  Height;      //number of map rows without borders
+    u32  Stride;      //number of cells in one row including borders (Width+2)
+    u32  BandRows;    //number of rows in one band
+    u32  Bands;       //number of bands
+    u64  *Index;      //file offset of every band and end of last band
+    u8   *Data;       //encoded bytes of band being decoded , big enough for biggest band
+};
+
+/*Define new data structure Arena that gives out blocks of one caller supplied memory block (MAP_ARENA)
+ *blocks are taken one after the other and are only released all together by voidResetArena();*/
+typedef struct struct_arena arena;
+struct struct_arena
+{
+    u8  *Memory;     //memory given by caller
+    u64 Size;        //its size in bytes
+    u64 Used;        //bytes given out
+};
+
+/*Define new data structure Branch Stack that holds last available cells (branch points)
+ *each entry is a cell index which is the same in input and output maps as both have the same layout*/
+typedef struct struct_branch_stack branchstack;
+struct struct_branch_stack
+{
+    u32 *Entries;    //cell index of each saved branch point
+    u32 Size;        //number of saved branch points
+    u32 Capacity;    //number of allocated entries
+    u32 HighWater;   //maximum number of branch points saved at the same time
+};
+
+/*Define new data structure Work Array that holds cell indices of a work deque , Capacity is a power of 2
+ *and entry i of deque is Entries[i & (Capacity-1)]*/
+typedef struct struct_work_array workarray;
+struct struct_work_array
+{
+    long long   Capacity;   //number of entries
+    workarray   *Previous;  //smaller array replaced by this one , released when search ends
+    atomic_uint Entries[];  //cell indices
+};
+
+/*Define new data structure Worker that holds state of one parallel explorer
+ *its work deque holds claimed cells not yet explored , owner pushes and takes cells at Bottom
+ *(depth first like branch stack) and idle workers steal cells at Top (Chase-Lev work stealing deque)
+ *Top and Bottom are kept on their own 64 byte cache lines as they are written by different threads*/
+typedef struct struct_worker worker;
+typedef struct struct_parallel_search parallelsearch;
+struct struct_worker
+{
+    _Alignas(64) atomic_llong Top;     //next entry to be stolen
+    _Alignas(64) atomic_llong Bottom;  //next free entry of owner
+    _Atomic(workarray *) Array;                     //current deque entries
+    parallelsearch *Search;  //parallel search this worker belongs to
+    u32 Number;        //worker number
+    u32 Seed;          //random state used to pick steal victims
+    u32 VisitedCells;  //number of cells explored by this worker
+    u64 Steals;        //number of cells stolen from other workers
+};
+
+/*Define new data structure Parallel Search that holds state shared by parallel explorers of one search*/
+struct struct_parallel_search
+{
+    worker        *Workers;          //parallel explorers and their number
+    u32           NumberOfWorkers;
+    const cellmap *Inputmap;         //input map they search
+    cellmap       *Map;              //output map they share
+    atomic_uint   PendingCells;      //number of claimed cells not yet explored , search ends when it drops to 0
+    atomic_uchar  Error;             //first explorer failure (ERROR_xxx) , ERROR_NONE if none
+};
+
+/*Configurations*/
+/*==================================================================================*/
+/*==================================================================================*/
+/*Cell Status names*/
+/*=========================================*/
+/* NOT_DISCOVERED      : Cell is not yet discovered by algorithm
+ * MINE                : this cell is a Mine
+ * NOT_MINE            : this cell is not a Mine
+ * VISITED             : this cell have been visited by algorithm
+ * DISCOVERED_NOT_MINE : this cell wad discovered not to be a Mine by algorithm
+ * BORDER              : this cell is map border cell
+ * CURRENT_LOCATION    : algorithm is currently in this cell
+ */
+#define NOT_DISCOVERED           '0'
+#define MINE                     '*'
+#define NOT_MINE                 '-'
+#define VISITED                  ' '
+#define DISCOVERED_NOT_MINE      'D'
+#define BORDER                   '='
+#define CURRENT_LOCATION         '+'
+
+/*Maps are allocated on cache line boundaries*/
+#define CACHE_LINE_SIZE          64
+
+/*Map status storage
+ * MAP_STORAGE_STATIC : status array is not released (built in cells[][])
+ * MAP_STORAGE_HEAP   : status array is released by free()
+ * MAP_STORAGE_MAPPED : status array is part of a memory mapped map file
+ * MAP_STORAGE_ARENA  : status array is taken from map arena (MAP_ARENA) and is not released*/
+#define MAP_STORAGE_STATIC       0
+#define MAP_STORAGE_HEAP         1
+#define MAP_STORAGE_MAPPED       2
+#define MAP_STORAGE_ARENA        3
+
+/*Error codes , library functions that can fail return ERROR_NONE when they succeed or why they failed ,
+ *they never print an error nor terminate program , caller does
+ *u8StepSearch(); returns STEP_DONE after last step of a search , it is not an error*/
+#define ERROR_NONE               0
+#define STEP_DONE                1
+#define ERROR_NO_MEMORY          2   //memory could not be allocated
+#define ERROR_ARENA_FULL         3   //map arena (MAP_ARENA) has no room left
+#define ERROR_MAP_SIZE           4   //map size is not supported by this build
+#define ERROR_OPEN_FILE          5   //file could not be opened or created
+#define ERROR_READ_FILE          6   //file could not be read
+#define ERROR_WRITE_FILE         7   //file could not be written
+#define ERROR_BAD_FILE           8   //file is not a valid map file , map archive or checkpoint of the map
+#define ERROR_THREAD             9   //thread could not be started
+#define ERROR_PLANNER            10  //checkpoint was written by a search with another planner
+#define ERROR_NO_ENTRY           11  //first row of input map is full of mines
+#define ERROR_CHECK              12  //a search consistency check failed (FRONTIER_CHECK , reachable cells)
+#define ERROR_CODES              13
+
+/*Map file format , all numbers are little endian
+ * offset 0  : 4 bytes "GPSM"
+ * offset 4  : u32 Width  (number of columns without borders)
+ * offset 8  : u32 Height (number of rows without borders)
+ * offset 12 : reserved up to MAP_FILE_HEADER_SIZE , written as 0
+ * offset MAP_FILE_HEADER_SIZE : (Height+2) x (Width+2) status bytes row by row including borders
+ *             using the same status names as cells[][] , MINE '*' NOT_MINE '-' BORDER '='
+ *header takes a whole cache line so the memory mapped status bytes stay cache aligned*/
+#define MAP_FILE_MAGIC           "GPSM"
+#define MAP_FILE_HEADER_SIZE     64
+
+/*Largest number of map columns or rows , Stride (Width+2) must fit in u32*/
+#define MAP_MAX_SIDE             0xFFFFFFFDu
+
+/*Map archive format , all numbers are little endian
+ * offset 0  : 4 bytes "GPSR"
+ * offset 4  : u32 Width  (number of columns without borders)
+ * offset 8  : u32 Height (number of rows without borders)
+ * offset 12 : u32 number of rows in one band , last band may have fewer rows
+ * offset 16 : u32 number of bands
+ * offset 20 : reserved up to MAP_FILE_HEADER_SIZE , written as 0
+ * offset MAP_FILE_HEADER_SIZE : band index , (bands+1) u64 file offsets , band b is stored from offset b to offset b+1
+ * then bands , a band is runs of same status cells row by row including borders and no run goes past its band
+ *   run byte : packed code (CODE_xxx) of run cells in bits 7..5 , run length - 1 in bits 4..0
+ *   when bits 4..0 are ARCHIVE_LONG_RUN run length - (ARCHIVE_LONG_RUN+1) follows in bytes of 7 bits ,
+ *   low bits first , bit 7 is set on every byte but the last one
+ *every band is decoded on its own so any row band is read through the index without rows before it*/
+#define MAP_ARCHIVE_MAGIC        "GPSR"
+#define ARCHIVE_LONG_RUN         31
+#define ARCHIVE_INDEX_ENTRY_SIZE 8
+
+/*Number of rows in one map archive band*/
+#ifndef ARCHIVE_BAND_ROWS
+#define ARCHIVE_BAND_ROWS        64
+#endif
+
+/*initial number of branch stack entries , stack capacity is doubled whenever it is full*/
+#define BRANCH_STACK_INITIAL_SIZE    64
+
+/*Define true and false*/
+#define TRUE             1
+#define FALSE            0
+
+/*Packed maps , when TRUE map status is stored as 2 (input map) or 3 (output map) bit planes
+ *of one bit per cell instead of one byte per cell and whole map operations work on 64 cells
+ *at a time (build with -DMAP_PACKED=1)*/
+#ifndef MAP_PACKED
+#define MAP_PACKED       FALSE
+#endif
+
+/*Tiled maps , when TRUE map status is kept in a disk file split in TILE_SIZE x TILE_SIZE cell tiles
+ *and only TILE_CACHE_SLOTS tiles of each map are in memory , least recently used tile is replaced
+ *(and written back if it was changed) when another tile is needed (build with -DMAP_TILED=1)*/
+#ifndef MAP_TILED
+#define MAP_TILED        FALSE
+#endif
+#if (MAP_PACKED == TRUE) && (MAP_TILED == TRUE)
+#error MAP_PACKED and MAP_TILED can not be used together
+#endif
+
+/*Tile size is 2^TILE_SIZE_SHIFT cells , 256 x 256 cells (64 KB) by default*/
+#ifndef TILE_SIZE_SHIFT
+#define TILE_SIZE_SHIFT          8
+#endif
+#define TILE_SIZE                (1u << TILE_SIZE_SHIFT)
+#define TILE_CELLS               (TILE_SIZE * TILE_SIZE)
+
+/*Number of tiles kept in memory for each map*/
+#ifndef TILE_CACHE_SLOTS
+#define TILE_CACHE_SLOTS         64
+#endif
+
+/*No tile or no cache slot*/
+#define TILE_NONE                0xFFFFFFFF
+
+/*Tiled map backing file layout
+ * TILE_LAYOUT_ROWS  : status bytes row by row like a map file , read only (input maps)
+ * TILE_LAYOUT_TILES : TILE_CELLS status bytes of tile t at offset t*TILE_CELLS (output maps)
+ *                     tiles never written are built from map size when they are first read*/
+#define TILE_LAYOUT_ROWS         0
+#define TILE_LAYOUT_TILES        1
+
+/*Packed status codes , input map status (MINE , NOT_MINE , BORDER) only needs codes 0..3 so
+ *input maps keep 2 bit planes , any unknown status is packed as MINE (code 0)*/
+#define CODE_MINE                    0
+#define CODE_NOT_MINE                1
+#define CODE_BORDER                  2
+#define CODE_NOT_DISCOVERED          4
+#define CODE_VISITED                 5
+#define CODE_DISCOVERED_NOT_MINE     6
+#define CODE_CURRENT_LOCATION        7
+#define INPUT_MAP_PLANES             2
+#define OUTPUT_MAP_PLANES            3
+
+/*Read and write status of cell index of a map*/
+#if MAP_PACKED == TRUE
+#define MAP_GET(map,Index)           u8GetPackedStatus((map),(Index))
+#define MAP_SET(map,Index,Value)     voidSetPackedStatus((map),(Index),(Value))
+#elif MAP_TILED == TRUE
+#define MAP_GET(map,Index)           (*pu8GetTiledCell((map),(Index),FALSE))
+#define MAP_SET(map,Index,Value)     (*pu8GetTiledCell((map),(Index),TRUE) = (u8)(Value))
+#else
+/*cells are written with relaxed atomic stores (a plain byte store on usual targets) as live monitor reader
+ *may be copying them at the same time , explorer is the only writer so its own reads stay plain*/
+#define MAP_GET(map,Index)           ((map)->Status[(Index)])
+#define MAP_SET(map,Index,Value)     __atomic_store_n(&(map)->Status[(Index)], (u8)(Value), __ATOMIC_RELAXED)
+#endif
+
+/*Read status of cell (row,col) of a map*/
+#define MAP_CELL(map,row,col)        MAP_GET((map), (u32)(row)*((map)->Stride) + (u32)(col))
+
+/*Map arena , when TRUE maps , branch stack and route search memory of an explorer are taken from one
+ *arena given by caller (voidSetArena();) instead of heap , nothing is released until arena is reset and
+ *branch stack never grows so every search step takes the same work , it is made for controllers without heap
+ *that search maps up to ARENA_MAX_WIDTH x ARENA_MAX_HEIGHT (build with -DMAP_ARENA=1 , MAP_PACKED=1 makes maps 8 times smaller)*/
+#ifndef MAP_ARENA
+#define MAP_ARENA        FALSE
+#endif
+#if (MAP_ARENA == TRUE) && (MAP_TILED == TRUE)
+#error MAP_ARENA and MAP_TILED can not be used together
+#endif
+
+/*Largest map an arena is sized for (columns and rows without borders)*/
+#ifndef ARENA_MAX_WIDTH
+#define ARENA_MAX_WIDTH          256
+#endif
+#ifndef ARENA_MAX_HEIGHT
+#define ARENA_MAX_HEIGHT         256
+#endif
+
+/*Number of branch stack entries , every branch point on stack is a different map cell so a stack
+ *of one entry per cell never gets full , a smaller stack fits in less memory but a map with more
+ *branch points than that stops search with an error (an open map needs nearly one entry per cell)*/
+#ifndef ARENA_BRANCH_POINTS
+#define ARENA_BRANCH_POINTS      (ARENA_MAX_WIDTH * ARENA_MAX_HEIGHT)
+#endif
+
+/*Route search marks and queue are only in arena budget when TRUE , they take 8 bytes per cell and
+ *are needed by measure and nearest planners and path queries*/
+#ifndef ARENA_ROUTES
+#define ARENA_ROUTES     FALSE
+#endif
+
+/*Worst case arena budget in bytes , every block is taken on a cache line boundary
+ *input map of one byte per cell maps is the status array given by caller so it takes no arena memory*/
+#define ARENA_MAX_CELLS          ((u64)(ARENA_MAX_WIDTH + 2) * (u64)(ARENA_MAX_HEIGHT + 2))
+#define ARENA_BLOCK(Bytes)       ((((u64)(Bytes) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE) * CACHE_LINE_SIZE)
+#if MAP_PACKED == TRUE
+#define ARENA_PLANE_BYTES        (((ARENA_MAX_CELLS + 511) / 512) * 64)
+#define ARENA_INPUT_MAP_BYTES    (INPUT_MAP_PLANES * ARENA_PLANE_BYTES)
+#define ARENA_OUTPUT_MAP_BYTES   (OUTPUT_MAP_PLANES * ARENA_PLANE_BYTES)
+#else
+#define ARENA_INPUT_MAP_BYTES    ((u64)0)
+#define ARENA_OUTPUT_MAP_BYTES   ARENA_BLOCK(ARENA_MAX_CELLS)
+#endif
+#define ARENA_BRANCH_STACK_BYTES ARENA_BLOCK((u64)ARENA_BRANCH_POINTS * 4)
+#if ARENA_ROUTES == TRUE
+#define ARENA_ROUTE_BYTES        (2 * ARENA_BLOCK(ARENA_MAX_CELLS * 4))
+#else
+#define ARENA_ROUTE_BYTES        ((u64)0)
+#endif
+/*trace stream buffer of program , far smaller than a heap trace buffer so trace is written more often*/
+#ifndef ARENA_TRACE_BYTES
+#define ARENA_TRACE_BYTES        ARENA_BLOCK(4096)
+#endif
+#define ARENA_BYTES              (ARENA_INPUT_MAP_BYTES + ARENA_OUTPUT_MAP_BYTES + ARENA_BRANCH_STACK_BYTES + ARENA_ROUTE_BYTES + \
+                                  ARENA_TRACE_BYTES)
+
+/*Arena size given by caller , set it to memory that can be spared (-DARENA_SIZE=65536) and build
+ *fails if worst case budget does not fit in it*/
+#ifndef ARENA_SIZE
+#define ARENA_SIZE               ARENA_BYTES
+#endif
+#if MAP_ARENA == TRUE
+_Static_assert(ARENA_BYTES <= ARENA_SIZE, "ARENA_SIZE is smaller than worst case arena budget of ARENA_MAX_WIDTH x ARENA_MAX_HEIGHT maps");
+#endif
+
+/*Fixed map size , when MAP_FIXED_WIDTH and MAP_FIXED_HEIGHT are set maps of that size are searched by
+ *u8WalkFixedMap(); whose surrounding cell offsets are constants (build with -DMAP_FIXED_WIDTH=10 -DMAP_FIXED_HEIGHT=10)
+ *a build supports one map size only , GPS_Project rejects a map of any other size , library callers and
+ *benchmark suites searching other sizes get the usual searching loop that takes the same moves*/
+#ifndef MAP_FIXED_WIDTH
+#define MAP_FIXED_WIDTH          0
+#endif
+#ifndef MAP_FIXED_HEIGHT
+#define MAP_FIXED_HEIGHT         0
+#endif
+#if (0 == MAP_FIXED_WIDTH) != (0 == MAP_FIXED_HEIGHT)
+#error MAP_FIXED_WIDTH and MAP_FIXED_HEIGHT must be set together
+#endif
+#define MAP_FIXED_STRIDE         (MAP_FIXED_WIDTH + 2)
+
+/*Frontier counter check mode , when TRUE every dead end also scans whole output map and
+ *compares number of DISCOVERED_NOT_MINE cells found with frontier counter (build with -DFRONTIER_CHECK=1)*/
+#ifndef FRONTIER_CHECK
+#define FRONTIER_CHECK   FALSE
+#endif
+
+/*Search counters mode , when TRUE search functions count calls , moves and scanned cells and time
+ *every phase of the search loop , counters are dumped with -m (build with -DSEARCH_STATS=1)*/
+#ifndef SEARCH_STATS
+#define SEARCH_STATS     FALSE
+#endif
+
+/*Search phases that are counted and timed , phase times are only measured in one step of every
+ *STATS_SAMPLE_PERIOD steps (a power of 2) and scaled by number of calls so clock reads stay cheap*/
+#define PHASE_UPDATE             0
+#define PHASE_ACTION             1
+#define PHASE_BACK_PROPAGATE     2
+#define PHASE_FRONTIER_SCAN      3
+#define PHASE_PRINT              4
+#define STATS_PHASES             5
+#define STATS_SAMPLE_PERIOD      64
+
+/*Add to a search counter , choose whether current step is timed , read clock at start of a phase
+ *and count a phase call and its time , they compile to nothing unless SEARCH_STATS is TRUE*/
+#if SEARCH_STATS == TRUE
+#define STATS_ADD(Explorer,Counter,Value)     ((Explorer)->Stats.Counter += (u64)(Value))
+#define STATS_SAMPLE(Explorer)                ((Explorer)->Stats.Sampled = (0 == ((Explorer)->VisitedCells & (STATS_SAMPLE_PERIOD-1))))
+#define STATS_START(Explorer,Start)           u64 Start = ((Explorer)->Stats.Sampled) ? u64ReadClock() : 0
+#define STATS_PHASE(Explorer,Phase,Start)     do { (Explorer)->Stats.Calls[(Phase)]++;                                      \
+                                                   if( (Explorer)->Stats.Sampled )                                           \
+                                                   {                                                                         \
+                                                       (Explorer)->Stats.SampledCalls[(Phase)]++;                            \
+                                                       (Explorer)->Stats.SampledTime[(Phase)] += u64ReadClock() - (Start);   \
+                                                   } } while(0)
+#else
+#define STATS_ADD(Explorer,Counter,Value)
+#define STATS_SAMPLE(Explorer)
+#define STATS_START(Explorer,Start)
+#define STATS_PHASE(Explorer,Phase,Start)
+#endif
+
+/*Search counters dump formats*/
+#define STATS_FORMAT_OFF         0
+#define STATS_FORMAT_JSON        1
+#define STATS_FORMAT_PROMETHEUS  2
+
+/*Trace levels , they select how much of the search is written to trace stream
+ * TRACE_OFF     : only final number of steps is written
+ * TRACE_SUMMARY : maps before and after search and final results are written
+ * TRACE_DELTAS  : summary plus cells changed at every step , one "row col old new" line per cell
+ *                 (row and col in decimal , old and new status in hex) after a "Step n" line
+ * TRACE_FULL    : summary plus whole output map every TraceSnapshotPeriod steps*/
+#define TRACE_OFF                0
+#define TRACE_SUMMARY            1
+#define TRACE_DELTAS             2
+#define TRACE_FULL               3
+
+/*Maximum number of distinct output cells changed in one step (current cell , its 4 neighbors
+ *and previous cell) , pending changes are written early if a step ever changes more*/
+#define TRACE_MAX_DELTAS         8
+
+/*Back propagation planners , they select how explorer leaves a dead end
+ * PLANNER_OFF     : jump to last branch point , counted as one step (original behavior)
+ * PLANNER_MEASURE : same jump as PLANNER_OFF but length of shortest route back to branch point
+ *                   over visited cells is measured and reported as travel distance
+ * PLANNER_NEAREST : drive over visited cells to nearest DISCOVERED_NOT_MINE cell , branch stack is not used*/
+#define PLANNER_OFF              0
+#define PLANNER_MEASURE          1
+#define PLANNER_NEAREST          2
+
+/*Moves to surrounding cells , they are numbered in the order explorer tries them*/
+#define MOVE_RIGHT               0
+#define MOVE_UP                  1
+#define MOVE_LOW                 2
+#define MOVE_LEFT                3
+#define MOVE_NONE                4
+
+/*Maximum number of parallel explorers and initial number of work deque entries of each explorer*/
+#define PARALLEL_MAX_THREADS     64
+#define WORK_DEQUE_INITIAL_SIZE  1024
+
+/*Define new data structure Search Stats that holds search counters of one explorer (SEARCH_STATS)
+ *times are in nanoseconds , take action time includes back propagation and frontier scan times*/
+typedef struct struct_search_stats searchstats;
+struct struct_search_stats
+{
+    u64 Moves[4];                     //moves to right , upper , lower and left cell
+    u64 ScanCells;                    //cells touched by dead end whole output map frontier scans
+    u64 Calls[STATS_PHASES];          //calls of every phase (PHASE_xxx)
+    u64 SampledCalls[STATS_PHASES];   //calls in timed steps and their time
+    u64 SampledTime[STATS_PHASES];
+    u8  Sampled;                      //TRUE if phases of current step are timed
+};
+
+/*Define new data structure Cell Source that gives input map cell statuses to an explorer the way a sensor does ,
+ *Probe starts reading a list of cells and returns at once , Read returns status of one cell and waits until
+ *it is read (a cell that was not probed is probed first) , an explorer without cell source reads its input map*/
+typedef struct struct_cell_source cellsource;
+struct struct_cell_source
+{
+    void (*Probe)(cellsource *Source, const u32 *Cells, u32 Count);
+    u8   (*Read)(cellsource *Source, u32 Cell);
+    void *Context;     //state of source
+};
+
+/*Simulated sensor , probed cells of one SENSOR_TILE_SIZE x SENSOR_TILE_SIZE tile share one sensor read ,
+ *SENSOR_CHANNELS reads are served at the same time and up to SENSOR_MAX_PENDING probed cells wait to be read*/
+#define SENSOR_TILE_SHIFT        3
+#define SENSOR_TILE_SIZE         (1u << SENSOR_TILE_SHIFT)
+#define SENSOR_CHANNELS          4
+#define SENSOR_MAX_PENDING       128
+
+/*Maximum number of moves cells are probed ahead of explorer , cells up to PROBE_AHEAD_MAX+1 moves from current
+ *cell are probed and the number of cells probed at one step is PROBE_CELLS at most*/
+#define PROBE_AHEAD_MAX          4
+#define PROBE_CELLS              (2*(PROBE_AHEAD_MAX+1)*(PROBE_AHEAD_MAX+2) + 1)
+
+/*Define new data structure Sensor that simulates a slow sensor over an input map , every sensor read takes
+ *latency plus a random jitter , times are in nanoseconds*/
+typedef struct struct_sensor sensor;
+struct struct_sensor
+{
+    cellsource    Source;                              //cell source given to explorer , its context is the sensor
+    const cellmap *Inputmap;                           //sensed map
+    u64           Latency;                             //time of one sensor read and its maximum random jitter
+    u64           Jitter;
+    u64           Random;                              //jitter random state
+    u64           ChannelFree[SENSOR_CHANNELS];        //time every channel ends its last read
+    u32           PendingCell[SENSOR_MAX_PENDING];     //probed cells not read yet (0 for free entry)
+    u64           PendingReady[SENSOR_MAX_PENDING];    //and time their status is ready
+    u32           PendingNext;                         //next pending entry to be reused
+    u64           Probes;                              //number of probed cells
+    u64           SensorReads;                         //number of sensor reads , probed cells of one tile share a read
+    u64           CellReads;                           //number of statuses read by explorer
+    u64           WaitTime;                            //time explorer waited for statuses
+};
+
+/*Live monitor , output map is split in bands of at least 1 << MONITOR_BAND_SHIFT cells , a step stamps bands
+ *it writes to with its step number before writing and publishes its number once it is done (seqlock with one
+ *sequence per band) , reader copies a band only when its stamp is a done step and did not change during the copy
+ *so explorer never waits for reader and a band written while it was copied is copied again next time
+ *map changes stamp every band with MONITOR_CHANGING until they are applied*/
+#define MONITOR_BAND_SHIFT       12
+#define MONITOR_CHANGING         0xFFFFFFFFU
+
+/*Begin and end writes of a step at a cell , every cell a step writes is in rows of cell - Stride to cell + Stride
+ *and a band holds more than two rows so they are in two bands at most (or twice the same band)*/
+#define MONITOR_BEGIN(Monitor,Index,Stride,Step)  do { atomic_store_explicit(&(Monitor)->BandStep[((Index) - (Stride)) >> (Monitor)->BandShift], (Step), memory_order_relaxed); \
+                                                       atomic_store_explicit(&(Monitor)->BandStep[((Index) + (Stride)) >> (Monitor)->BandShift], (Step), memory_order_relaxed); \
+                                                       atomic_thread_fence(memory_order_release); } while(0)
+#define MONITOR_END(Monitor,Index,Step)           atomic_store_explicit(&(Monitor)->Position, ((u64)(Step) << 32) | (Index), memory_order_release)
+
+/*Define new data structure Monitor that lets another thread watch output map of a running search
+ *it is written by explorer only , reader keeps its own copy of output map in a snapshot*/
+typedef struct struct_monitor monitor;
+struct struct_monitor
+{
+    const u8     *Status;        //status of watched output map (one byte per cell)
+    u32          Cells;          //number of cells of output map including borders
+    u32          Width;          //map size without borders and number of cells of a row with borders
+    u32          Height;
+    u32          Stride;
+    u32          Bands;          //number of bands of output map , band of a cell is its index >> BandShift
+    u32          BandShift;
+    atomic_uint  *BandStep;      //number of last step that began writing to every band
+    atomic_ullong Position;      //number of last done step << 32 | current cell after it
+    atomic_uint  Generation;     //number of applied map changes , every band is copied again after them
+};
+
+/*Define new data structure Snapshot that holds a copy of output map and explorer position taken by reader
+ *every band is copied at a moment no step wrote to it but bands may come from different steps , bands copied
+ *by an update are not older than position read by it*/
+typedef struct struct_snapshot snapshot;
+struct struct_snapshot
+{
+    u8  *Status;        //output map status , Stride x (Height+2) cells including borders
+    u8  *Band;          //band copied before its stamp is checked again
+    u32 *BandStep;      //stamp of every band when it was copied , MONITOR_CHANGING before first copy
+    u32 Generation;     //number of map changes applied before last update
+    u32 CurrentCell;    //explorer position and step number read before bands were copied
+    u32 Step;
+    u32 BusyBands;      //number of changed bands not copied by last update as a step was writing to them
+};
+
+/*Checkpoint file format , all numbers are little endian
+ * offset 0  : 4 bytes "GPSK"
+ * offset 4  : u32 Width  (number of columns without borders)
+ * offset 8  : u32 Height (number of rows without borders)
+ * offset 12 : u32 CurrentCell      offset 16 : u32 EntryCell      offset 20 : u32 ReachableCells
+ * offset 24 : u32 VisitedCells     offset 28 : u32 Backtracks     offset 32 : u32 FrontierCells
+ * offset 36 : u32 FrontierRescans  offset 40 : u32 number of branch points
+ * offset 44 : u32 branch stack high water mark
+ * offset 48 : u64 RouteCells       offset 56 : u8 DeadendCondition offset 57 : u8 Planner
+ * offset 58 : reserved up to CHECKPOINT_HEADER_SIZE , written as 0
+ * offset CHECKPOINT_HEADER_SIZE : OUTPUT_MAP_PLANES bit planes of output map , (Cells+7)/8 bytes each ,
+ *             bit b of byte i of plane p is bit p of packed code (CODE_xxx) of cell 8*i+b
+ * then      : u32 cell index of every branch point , bottom of stack first
+ *checkpoint is written to CheckpointFile.tmp and renamed once it is complete so a crash while it is written
+ *leaves previous checkpoint , a search can only be resumed with the planner it was checkpointed with*/
+#define CHECKPOINT_FILE_MAGIC    "GPSK"
+#define CHECKPOINT_HEADER_SIZE   64
+
+/*Planes are read CHECKPOINT_CHUNK bytes at a time*/
+#define CHECKPOINT_CHUNK         4096
+
+/*Clock is only read every CHECKPOINT_CHECK_STEPS steps to find out if a checkpoint is due*/
+#define CHECKPOINT_CHECK_STEPS   65536
+
+/*A due checkpoint image is copied over the following steps , every step copies CHECKPOINT_SLICE_BANDS output map
+ *bands of 1 << CHECKPOINT_BAND_SHIFT cells at least (bands written since they were copied first) and
+ *CHECKPOINT_SLICE_BRANCHES branch points so no step copies the whole map*/
+#define CHECKPOINT_BAND_SHIFT    12
+#define CHECKPOINT_SLICE_BANDS   4
+#define CHECKPOINT_SLICE_BRANCHES 4096
+
+/*Longest checkpoint file name*/
+#define CHECKPOINT_NAME_SIZE     1024
+
+/*Define new data structure Checkpoint that holds periodic checkpoints of a search , a due checkpoint is
+ *copied to an image (header , bit planes and branch stack as they are in checkpoint file) one slice per step ,
+ *a step writes cells in rows around its first cell only so bands it wrote that were already copied are copied
+ *again and branch points below lowest stack size since they were copied are kept , image is complete at end of
+ *the step that leaves nothing to copy and a writer thread writes it to file while search goes on*/
+typedef struct struct_checkpoint checkpoint;
+struct struct_checkpoint
+{
+    char FileName[CHECKPOINT_NAME_SIZE];  //checkpoint file
+    char TempName[CHECKPOINT_NAME_SIZE];  //file checkpoint is written to before it replaces checkpoint file
+    u64  Period;        //time between two checkpoints in nanoseconds
+    u64  Due;           //clock value next checkpoint is due at
+    u32  NextCheck;     //step number clock is read at next
+    u8   *Image;        //header and bit planes of checkpoint file image , only written by search while no image is pending
+    u64  ImageSize;     //bytes of header and bit planes
+    u8   *Branches;     //branch points of image as they are in checkpoint file , their number and room for them
+    u32  BranchCount;
+    u32  BranchCapacity;
+    u8   Copying;       //TRUE while an image is copied one slice per step
+    u32  Bands;         //number of output map bands , band of a cell is its index >> BandShift
+    u32  BandShift;
+    u32  NextBand;      //next band copied for the first time , Bands once every band was copied
+    u8   *Dirty;        //TRUE for every band written since it was copied
+    u32  *DirtyBands;   //bands to be copied again and their number
+    u32  DirtyCount;
+    u32  LastCell;      //current cell at end of last step , first cell of next step
+#if !defined(_WIN32)
+    pthread_t       Writer;   //thread writing pending images to checkpoint file
+    pthread_mutex_t Lock;     //guards Pending , Stop , Written and Failed
+    pthread_cond_t  Wake;     //signals writer that an image is pending or that it has to stop
+    u8   Pending;       //TRUE while writer has an image to write
+    u8   Stop;          //TRUE once writer has to stop after pending image
+#endif
+    u32  Written;       //number of checkpoints written
+    u32  Skipped;       //number of due checkpoints skipped as previous one was still being written
+    u32  Failed;        //number of checkpoints that could not be written
+    u64  LongestStall;  //longest time a step spent on checkpoints (copying a slice of image)
+};
+
+/*Block summary , output map (borders included) is split in blocks of 2^SUMMARY_BLOCK_SHIFT x 2^SUMMARY_BLOCK_SHIFT
+ *cells at level 0 , a block of level l+1 holds 2 x 2 blocks of level l and top level has one block for whole map*/
+#define SUMMARY_BLOCK_SHIFT      4
+#define SUMMARY_MAX_LEVELS       32
+
+/*Cell classes counted by block summary , NOT_DISCOVERED cells are unknown , DISCOVERED_NOT_MINE cells are frontier
+ *and VISITED or CURRENT_LOCATION cells are visited , other cells (MINE , BORDER) are not counted*/
+#define SUMMARY_UNKNOWN          0
+#define SUMMARY_FRONTIER         1
+#define SUMMARY_VISITED          2
+#define SUMMARY_CLASSES          3
+
+/*Define new data structure Block Count that holds number of cells of every class in one summary block*/
+typedef struct struct_block_count blockcount;
+struct struct_block_count
+{
+    u32 Cells[SUMMARY_CLASSES];   //number of cells of class c in block (SUMMARY_xxx)
+};
+
+/*Define new data structure Block Summary that holds cell class counts of output map blocks at every level ,
+ *every output map change of the explorer it is attached to only changes its level 0 block and whole map counts ,
+ *changed level 0 blocks are folded into levels above them when a question needs them so questions about
+ *frontier and explored cells go down from top level and skip blocks that have nothing to look for*/
+typedef struct struct_block_summary blocksummary;
+struct struct_block_summary
+{
+    u32        Stride;                         //number of cells in one row of output map including borders
+    u32        Rows;                           //number of rows of output map including borders
+    u8         Levels;                         //number of levels , top level is Levels-1
+    u32        BlockCols[SUMMARY_MAX_LEVELS];  //number of blocks in one row and one column of each level
+    u32        BlockRows[SUMMARY_MAX_LEVELS];
+    blockcount *Count[SUMMARY_MAX_LEVELS];     //counts of each level , block (r,c) of level l is Count[l][r*BlockCols[l] + c]
+    u32        Finished[SUMMARY_MAX_LEVELS];   //number of blocks of each level without unknown or frontier cells
+    u32        Total[SUMMARY_CLASSES];         //cell counts of whole map
+    blockcount *Folded;                        //level 0 counts as they were last folded into levels above
+    u8         *Dirty;                         //TRUE for level 0 blocks changed since they were folded
+    u32        *DirtyBlocks;                   //level 0 blocks to be folded and their number
+    u32        DirtyCount;
+    u32        Row;                            //row of last changed cell and index of its first cell , cells
+    u32        RowStart;                       //changed by a walker are next to each other so no division finds their row
+};
+
+/*Cell counts of whole map*/
+#define SUMMARY_TOTAL(Summary,Class)   ((Summary)->Total[(Class)])
+
+/*Define new data structure Explorer that holds whole state of one map search , every search function
+ *works on the explorer passed to it so several maps can be searched at the same time
+ *it is set up by u8CreateExplorer(); and released by voidFreeExplorer();*/
+typedef struct struct_explorer explorer;
+struct struct_explorer
+{
+    cellmap     Inputmap;          //I/P map
+    cellmap     Outputmap;         //O/P map
+    u32         CurrentCell;       //cell index of current position (same in both maps) , 0 (a border cell) means no position
+    u32         EntryCell;         //entry point chosen before search , 0 to enter at first NOT_MINE cell of first row
+    u32         ReachableCells;    //number of input map cells reachable from chosen entry point , 0 if not analysed
+    branchstack BranchStack;       //stack of last available cells (branch points)
+    u32         FrontierCells;     //number of DISCOVERED_NOT_MINE cells in output map (frontier cells that still can be visited)
+    u8          DeadendCondition;  //dead end variable that is used to terminate search
+    u8          Error;             //first failure of a search step (ERROR_xxx) , ERROR_NONE if none
+    u8          AvailableMask;     //available surrounding cells of current cell found by voidUpdateOutputMap(); , bit d for move d
+    u32         VisitedCells;      //number of visited cells (search steps)
+    u32         Backtracks;        //number of back propagations to a branch point
+    u32         FrontierRescans;   //number of whole output map frontier scans (FRONTIER_CHECK)
+    searchstats Stats;             //search counters (SEARCH_STATS)
+    u64         StatsClockCost;    //time of one clock read , it is taken out of every timed phase call (SEARCH_STATS)
+    volatile sig_atomic_t *StatsDumpRequest; //counters are dumped at end of a step once caller (a SIGUSR1 handler) sets it
+                                             //to non 0 , it is set back to 0 , NULL if counters are not dumped during search
+    u8          StatsFormat;       //counters dump format (STATS_FORMAT_xxx)
+    const char  *StatsFileName;    //counters file name , NULL for stderr
+    u8          Planner;           //back propagation planner (PLANNER_xxx)
+    cellsource  *Source;           //cell source (sensor) input map cells are read from , NULL to read input map directly
+    u8          ProbeAhead;        //number of moves cells are probed ahead , 0 to probe surrounding cells of current cell only
+    monitor     *Monitor;          //live monitor steps are written to , NULL if search is not watched
+    checkpoint  *Checkpoint;       //periodic checkpoints of search , NULL if none are written
+    blocksummary *Summary;         //block summary of output map kept up to date by search , NULL if none
+    arena       *Arena;            //caller arena output map , branch stack and route search memory are taken from (MAP_ARENA)
+    u64         RouteCells;        //number of cells driven on back propagation routes (PLANNER_MEASURE , PLANNER_NEAREST)
+    u32         *RouteMarks;       //route search mark of every cell , a cell was reached by current search if its mark is RouteGeneration
+    u32         RouteGeneration;
+    u32         *RouteQueue;       //route search queue and its number of entries
+    u32         RouteQueueCapacity;
+    FILE        *TraceFile;        //trace stream and trace level (TRACE_xxx)
+    u8          TraceLevel;
+    u32         TraceSnapshotPeriod; //number of steps between two output map snapshots in TRACE_FULL level
+    u32         TraceDeltaIndex[TRACE_MAX_DELTAS]; //output cells changed in current step
+    u8          TraceDeltaOld[TRACE_MAX_DELTAS];   //and their status at start of step
+    u8          TraceDeltas;       //number of output cells changed in current step
+};
+
+/*Define new data structure Map Change that holds one input map cell change applied after search*/
+typedef struct struct_map_change mapchange;
+struct struct_map_change
+{
+    u32 Index;    //cell index (same in both maps)
+    u8  Status;   //new input map status , MINE or NOT_MINE
+};
+
+/*Generated map families
+ * MAP_FAMILY_UNIFORM  : every cell is a mine with the same probability (density %)
+ * MAP_FAMILY_MAZE     : perfect maze of one cell wide paths (binary tree maze)
+ * MAP_FAMILY_CORRIDOR : one long corridor winding down the map , no branch points
+ * MAP_FAMILY_OPEN     : no mines at all
+ * MAP_FAMILY_WORST    : comb of one cell wide dead end teeth hanging from first row ,
+ *                       every tooth is a branch point that needs a back propagation
+ *every family keeps first cell of first row free so search has an entry point*/
+#define MAP_FAMILY_UNIFORM       0
+#define MAP_FAMILY_MAZE          1
+#define MAP_FAMILY_CORRIDOR      2
+#define MAP_FAMILY_OPEN          3
+#define MAP_FAMILY_WORST         4
+#define MAP_FAMILIES             5
+
+/*Safe path queries , number of cached distance fields and length of a query that has no path*/
+#define PATH_CACHE_FIELDS        16
+#define PATH_NONE                0xFFFFFFFF
+
+/*Define new data structure Path Index that answers shortest safe path queries over a searched output map
+ *cells that are known to be safe (VISITED , DISCOVERED_NOT_MINE , CURRENT_LOCATION) are labelled with
+ *their connected component , distance fields of recent destinations are cached (least recently used is replaced)*/
+typedef struct struct_path_index pathindex;
+struct struct_path_index
+{
+    u32 Width;                            //map size without borders
+    u32 Height;
+    u32 Stride;                           //number of cells of one row including borders
+    u32 *Component;                       //component of every cell , 0 for unsafe cells
+    u32 Components;                       //number of components
+    u32 *Queue;                           //breadth first search queue , one entry per cell
+    u32 FieldTarget[PATH_CACHE_FIELDS];   //destination of each cached distance field , 0 for empty slot
+    u64 FieldLastUse[PATH_CACHE_FIELDS];  //clock value of last use of each field
+    u32 *Field[PATH_CACHE_FIELDS];        //distance of every cell to destination , PATH_NONE outside its component
+    u64 Clock;                            //incremented every query
+    u64 Hits;                             //number of queries answered by a cached field
+    u64 Misses;                           //number of distance fields built
+};
+
+/*Row bits are padded to a whole number of 256 bit vectors*/
+#define ROW_BITS_ALIGN           4
+
+/*Define new data structure Row Bits that holds a map as one bitset per row so reachability of whole
+ *map is found by word wide flood fill , bit c of row r is inner cell (r+1 , c+1)*/
+typedef struct struct_row_bits rowbits;
+struct struct_row_bits
+{
+    u32 Width;        //map size without borders
+    u32 Height;
+    u32 RowWords;     //number of 64 bit words of one row , multiple of ROW_BITS_ALIGN
+    u64 *Passable;    //cells that can be entered (NOT_MINE , VISITED , DISCOVERED_NOT_MINE , CURRENT_LOCATION)
+    u64 *Reached;     //cells reached by flood fill
+    u64 *Empty;       //row of zeros , neighbor of first and last row
+};
+
+/*==================================================================================*/
+/*==================================================================================*/
+/*Functions Prototypes*/
+/*=========================================*/
+
+/*this function allocates cells of a Height x Width map (plus borders) in one cache aligned block
+ *Arguments : pointer to map to be created , number of columns and number of rows without borders ,
+ *            arena map is taken from (MAP_ARENA , not used by other builds)
+ *Return    : ERROR_NONE , ERROR_MAP_SIZE if map size is not supported , ERROR_NO_MEMORY , ERROR_ARENA_FULL
+ *            or ERROR_OPEN_FILE (tile file of MAP_TILED) if map can not be allocated */
+u8 u8CreateMap(cellmap *map, u32 Width, u32 Height, arena *Arena);
+
+/*this function releases cells of a map whatever its storage is
+ *Arguments : pointer to map
+ *Return    : void */
+void voidFreeMap(cellmap *map);
+
+/*this function is responsible for initializing a map with its initial status value for each cell
+ *borders get BORDER status and all other cells get NOT_DISCOVERED status
+ *Arguments : pointer to map created by u8CreateMap();
+ *Return    : void */
+void voidInitializeMap(cellmap *map);
+
+/*this function creates an Input map from a u8 array of cell status like cells[][]
+ *the array becomes the map status without any copy , with MAP_PACKED it is packed into
+ *bit planes and released , with MAP_TILED it is written to a temporary backing file and released
+ *if map can not be created array is not released and stays owned by caller
+ *Arguments : pointer to map , status array of (Height+2) x (Width+2) elements including borders ,
+ *            number of columns and rows without borders , storage of the array (MAP_STORAGE_xxx) ,
+ *            arena bit planes are taken from (MAP_ARENA with MAP_PACKED , not used by other builds)
+ *Return    : ERROR_NONE , ERROR_NO_MEMORY , ERROR_ARENA_FULL , ERROR_MAP_SIZE , ERROR_OPEN_FILE or ERROR_WRITE_FILE */
+u8 u8CreateInputMap(cellmap *map, u8 *Source, u32 Width, u32 Height, u8 Storage, arena *Arena);
+
+/*this function checks if a file starts with map file magic "GPSM"
+ *Arguments : file name
+ *Return    : TRUE if file is a map file , FALSE otherwise (also if it can not be opened) */
+u8 u8IsMapFile(const char *FileName);
+
+/*this function creates an Input map by memory mapping a map file , map status is read
+ *straight from the mapping , with MAP_TILED map file becomes backing file of the map and its tiles
+ *are read when needed (borders are then checked as tiles are read , see u8TiledMapError();)
+ *Arguments : pointer to map , map file name , arena bit planes are taken from (MAP_ARENA with MAP_PACKED)
+ *Return    : ERROR_NONE , ERROR_OPEN_FILE , ERROR_READ_FILE , ERROR_BAD_FILE if file is not a valid map file
+ *            (bad header , size or borders) or an error of u8CreateInputMap(); */
+u8 u8LoadMapFile(cellmap *map, const char *FileName, arena *Arena);
+
+/*this function writes a map to a map file
+ *Arguments : pointer to map , map file name
+ *Return    : ERROR_NONE , ERROR_OPEN_FILE , ERROR_WRITE_FILE or ERROR_NO_MEMORY */
+u8 u8SaveMapFile(cellmap *map, const char *FileName);
+
+/*this function checks if a file starts with map archive magic "GPSR"
+ *Arguments : file name
+ *Return    : TRUE if file is a map archive , FALSE otherwise (also if it can not be opened) */
+u8 u8IsMapArchive(const char *FileName);
+
+/*this function writes a map (input or output map) to a map archive , cells are read one band at a time
+ *Arguments : pointer to map , map archive file name , pointer that receives archive size in bytes
+ *Return    : ERROR_NONE , ERROR_OPEN_FILE , ERROR_WRITE_FILE or ERROR_NO_MEMORY */
+u8 u8SaveMapArchive(cellmap *map, const char *FileName, u64 *Size);
+
+/*this function creates an Input map from a map archive , bands are decoded one after the other straight
+ *into input map (into its bit planes or tile file with MAP_PACKED or MAP_TILED) so whole archive is never
+ *expanded first
+ *Arguments : pointer to map , map archive file name , arena bit planes are taken from (MAP_ARENA with MAP_PACKED)
+ *Return    : ERROR_NONE , an error of u8OpenMapArchive(); or u8ReadArchiveBand(); , ERROR_BAD_FILE if a border
+ *            cell is missing , ERROR_NO_MEMORY , ERROR_ARENA_FULL , ERROR_OPEN_FILE or ERROR_WRITE_FILE (tile file) */
+u8 u8LoadMapArchive(cellmap *map, const char *FileName, arena *Arena);
+
+/*this function opens a map archive and reads its band index , archive is closed again if it is not valid
+ *Arguments : pointer to map archive , map archive file name
+ *Return    : ERROR_NONE , ERROR_OPEN_FILE , ERROR_READ_FILE , ERROR_NO_MEMORY or ERROR_BAD_FILE if archive
+ *            is not a valid map archive (bad header , damaged index) */
+u8 u8OpenMapArchive(maparchive *Archive, const char *FileName);
+
+/*this function reads one band of a map archive through its index and decodes it , bands can be read in
+ *any order , band b holds BandRows map rows from row b*BandRows on (border rows included , top border is row 0)
+ *Arguments : pointer to open map archive , band number , status array of BandRows x Stride cells that receives band rows ,
+ *            pointer that receives number of rows in band
+ *Return    : ERROR_NONE , ERROR_READ_FILE or ERROR_BAD_FILE if band is damaged or not in archive */
+u8 u8ReadArchiveBand(maparchive *Archive, u32 Band, u8 *Rows, u32 *BandRows);
+
+/*this function closes a map archive opened by u8OpenMapArchive();
+ *Arguments : pointer to open map archive
+ *Return    : void */
+void voidCloseMapArchive(maparchive *Archive);
+
+/*this function reads a little endian u32 number
+ *Arguments : pointer to first byte
+ *Return    : number */
+u32 u32ReadLittleEndian(const u8 *Bytes);
+
+/*this function gives a memory block to a caller owned map arena (MAP_ARENA) , maps , branch stack and route
+ *search memory of explorers created with the arena are taken from it , memory should be ARENA_SIZE bytes
+ *on a cache line boundary
+ *Arguments : pointer to arena , memory block , its size in bytes
+ *Return    : void */
+void voidSetArena(arena *Arena, u8 *Memory, u64 Size);
+
+/*this function takes a block from a map arena , a block that does not fit is never given so a map
+ *bigger than arena never writes past it , blocks of caller (trace buffer) are taken the same way
+ *Arguments : pointer to arena , block size in bytes
+ *Return    : pointer to block on a cache line boundary , NULL if arena is full */
+void *pvArenaAllocate(arena *Arena, u64 Size);
+
+/*this function releases every block of a map arena , maps and explorers using them must not be used anymore
+ *Arguments : pointer to arena
+ *Return    : void */
+void voidResetArena(arena *Arena);
+
+/*this function reads status of a cell from bit planes of a packed map
+ *Arguments : pointer to map , cell index
+ *Return    : cell status */
+u8 u8GetPackedStatus(const cellmap *map, u32 Index);
+
+/*this function writes status of a cell into bit planes of a packed map
+ *Arguments : pointer to map , cell index , cell status
+ *Return    : void */
+void voidSetPackedStatus(cellmap *map, u32 Index, u8 Status);
+
+/*this function finds a cell of a tiled map in tile cache , its tile is read first if it is not in cache
+ *Arguments : pointer to map , cell index , TRUE if cell is going to be changed
+ *Return    : pointer to cell status in tile cache , valid until another tile is read */
+u8 *pu8GetTiledCell(const cellmap *map, u32 Index, u8 Write);
+
+/*this function gives first tile read or write failure of a tiled map , cells of tiles that could not be
+ *read are BORDER cells so a search or a copy of the map that used them is not valid
+ *Arguments : pointer to map
+ *Return    : ERROR_NONE , ERROR_READ_FILE , ERROR_WRITE_FILE or ERROR_BAD_FILE (border cell missing in map file) */
+u8 u8TiledMapError(const cellmap *map);
+
+/*this function counts cells of a map (borders included) that have a status
+ *packed maps are counted 64 cells at a time
+ *Arguments : pointer to map , cell status
+ *Return    : number of cells */
+u32 u32CountStatus(const cellmap *map, u8 Status);
+
+/*this function compares status of all cells of two maps , packed maps are compared 64 cells at a time
+ *Arguments : pointers to two maps
+ *Return    : TRUE if both maps have the same size and the same status in every cell */
+u8 u8CompareMaps(const cellmap *map1, const cellmap *map2);
+
+/*this function loads a map from a text file , each line is a map row of '*' (MINE) and '-' (NOT_MINE)
+ *characters , any other character is ignored and lines without map characters are skipped
+ *so a map printed by voidPrintMap(); can be loaded again
+ *Arguments : file name , pointer that receives allocated status array of (Height+2) x (Width+2) elements
+ *            including borders , pointers to Width and Height that receive map dimensions
+ *Return    : ERROR_NONE , ERROR_OPEN_FILE , ERROR_BAD_FILE if rows do not have the same width or there is no row ,
+ *            ERROR_MAP_SIZE or ERROR_NO_MEMORY */
+u8 u8LoadTextMap(const char *FileName, u8 **Map, u32 *Width, u32 *Height);
+
+/*this function generates a map of a family (MAP_FAMILY_xxx)
+ *Arguments : family , number of columns and rows without borders , seed , mine density (%) of uniform maps ,
+ *            pointer that receives allocated status array of (Height+2) x (Width+2) elements including borders
+ *Return    : ERROR_NONE , ERROR_MAP_SIZE or ERROR_NO_MEMORY */
+u8 u8GenerateMap(u8 Family, u32 Width, u32 Height, u32 Seed, u32 Density, u8 **Map);
+
+/*this function prints a map passed to it
+ *Arguments : output stream and pointer to map
+ *Return    : void */
+void voidPrintMap(FILE *Stream, cellmap *map);
+
+/*this function makes an explorer ready to search an input map , explorer takes the input map and
+ *creates its own output map , trace and counters are off until caller sets them
+ *if explorer can not be created input map is not taken and stays owned by caller
+ *Arguments : pointer to explorer , pointer to input map (explorer releases it with voidFreeExplorer();) ,
+ *            arena output map and search memory are taken from (MAP_ARENA , not used by other builds)
+ *Return    : ERROR_NONE or an error of u8CreateMap(); , ERROR_ARENA_FULL if branch stack does not fit in arena */
+u8 u8CreateExplorer(explorer *Explorer, const cellmap *Inputmap, arena *Arena);
+
+/*this function releases maps and search memory of an explorer
+ *Arguments : pointer to explorer created by u8CreateExplorer();
+ *Return    : void */
+void voidFreeExplorer(explorer *Explorer);
+
+/*this function uses u8StartSearch(); and u8StepSearch(); functions to search map until the whole map is discovered
+ *Arguments : pointer to explorer created by u8CreateExplorer();
+ *Return    : ERROR_NONE if map was searched , ERROR_NO_ENTRY if first row is full of mines (no entry point)
+ *            or error that stopped the search (see u8StepSearch();) */
+u8 u8SearchMap(explorer *Explorer);
+
+/*this function places explorer at entry point of the search , searching is then done one step at a time
+ *by u8StepSearch();
+ *Arguments : pointer to explorer created by u8CreateExplorer();
+ *Return    : ERROR_NONE if search can start , ERROR_NO_ENTRY if first row is full of mines (no entry point) */
+u8 u8StartSearch(explorer *Explorer);
+
+/*this function does one searching step , explorer updates output map around its current cell then moves
+ *to next cell , it only touches the explorer it is given so different explorers may be stepped from
+ *different threads at the same time
+ *a step that fails (branch stack or route search memory , tile file , FRONTIER_CHECK) stops the search ,
+ *explorer keeps the error and every later step returns it
+ *Arguments : pointer to explorer started by u8StartSearch();
+ *Return    : ERROR_NONE if search goes on , STEP_DONE once dead end is reached or error that stopped the search */
+u8 u8StepSearch(explorer *Explorer);
+
+/*this function moves explorer from its current cell until dead end is reached , it is the searching loop
+ *of u8SearchMap(); and walks newly reachable cells after map changes
+ *Arguments : pointer to explorer with current cell set
+ *Return    : ERROR_NONE once dead end is reached or error that stopped the search (see u8StepSearch();) */
+u8 u8WalkMap(explorer *Explorer);
+
+/*this function prints final result of a search done by u8SearchMap();
+ *Arguments : pointer to explorer
+ *Return    : ERROR_NONE , ERROR_CHECK if visited cells are not the reachable cells found before search (FRONTIER_CHECK) */
+u8 u8PrintSearchResults(explorer *Explorer);
+
+/*this function finds number of cells driven by a search , every move to a neighbor cell and every
+ *cell of back propagation routes , it is only known when a planner measures routes
+ *Arguments : pointer to explorer
+ *Return    : number of cells driven */
+u64 u64TravelCells(explorer *Explorer);
+
+/*this function writes search counters of an explorer as JSON or Prometheus text to counters file
+ *(rewritten every dump) or to stderr
+ *Arguments : pointer to explorer
+ *Return    : ERROR_NONE , ERROR_OPEN_FILE or ERROR_WRITE_FILE */
+u8 u8DumpStats(explorer *Explorer);
+
+/*this function releases branch stack entries
+ *Arguments : pointer to explorer
+ *Return    : void */
+void voidFreeBranchStack(explorer *Explorer);
+
+/*this function finds entry point of search , entry point chosen before search if any
+ *otherwise first NOT_MINE cell of first input map row
+ *Arguments : pointer to explorer
+ *Return    : cell index of entry point or 0 if there is none */
+u32 u32FindEntryCell(explorer *Explorer);
+
+/*this function analyses reachability of input map before search , NOT_MINE cells are joined into
+ *connected components (union find) and the first row cell whose component is largest is chosen
+ *as entry point , number of cells reachable from it is kept in explorer
+ *Arguments : pointer to explorer , pointer that receives cell index of chosen entry point or 0 if first row is full of mines
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY */
+u8 u8FindBestEntryCell(explorer *Explorer, u32 *Entry);
+
+/*this function reads a monotonic clock
+ *Arguments : void
+ *Return    : time in nanoseconds */
+u64 u64ReadClock(void);
+
+/*this function searches input map with parallel explorers that share one output map
+ *every reachable NOT_MINE cell is claimed by exactly one explorer which explores it , it is a flood fill
+ *and not u8WalkMap(); walker , cells are explored in another order and there are no backtracking steps
+ *explorers that can not be started leave their cells to the others so output map is still filled
+ *Arguments : pointer to explorer whose input map is searched ,
+ *            pointer to output map initialized by voidInitializeMap(); , number of explorers ,
+ *            entry cell index , pointer that receives total number of stolen cells
+ *Return    : ERROR_NONE , ERROR_NO_MEMORY (output map is then not complete) , ERROR_THREAD (or number of
+ *            explorers is 0) or ERROR_MAP_SIZE (MAP_PACKED and MAP_TILED maps have no byte per cell) */
+u8 u8ParallelSearch(explorer *Explorer, cellmap *map, u32 Threads, u32 EntryCell, u64 *Steals);
+
+/*this function fills output map like u8ParallelSearch(); does with one explorer and no deque , it is the
+ *serial baseline parallel search is timed against , like parallel search it explores every reachable cell
+ *once depth first and does not take walker moves (no backtracking steps) , so cells are explored in
+ *another order than u8WalkMap(); and their number is not its step count
+ *Arguments : pointer to explorer whose input map is searched ,
+ *            pointer to output map initialized by voidInitializeMap(); , entry cell index ,
+ *            pointer that receives number of explored cells
+ *Return    : ERROR_NONE , ERROR_NO_MEMORY (output map is then not complete) or ERROR_MAP_SIZE (MAP_PACKED and
+ *            MAP_TILED maps have no byte per cell) */
+u8 u8SerialFill(explorer *Explorer, cellmap *map, u32 EntryCell, u32 *Explored);
+
+/*this function clears search state of an explorer so it can search its maps again
+ *branch stack entries are kept so a reused explorer does not allocate them again
+ *Arguments : pointer to explorer
+ *Return    : void */
+void voidResetExplorer(explorer *Explorer);
+
+/*this function builds a path index of a searched output map , safe cells are labelled with their
+ *connected component so queries between components are answered without a search
+ *Arguments : pointer to path index , pointer to output map
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY */
+u8 u8BuildPathIndex(pathindex *Index, cellmap *map);
+
+/*this function answers a shortest safe path query , path follows distance field of destination downhill
+ *Arguments : pointer to path index , start and destination cell indices ,
+ *            array that receives path cells from start to destination (or NULL) and its number of entries ,
+ *            pointer that receives path length in moves or PATH_NONE if there is no safe path
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY (no distance field for destination) */
+u8 u8QueryPath(pathindex *Index, u32 From, u32 To, u32 *Path, u32 PathCapacity, u32 *Length);
+
+/*this function releases path index
+ *Arguments : pointer to path index
+ *Return    : void */
+void voidFreePathIndex(pathindex *Index);
+
+/*this function checks explorer output against a flood fill of input map from entry point ,
+ *every reachable cell must be VISITED and every VISITED cell must be reachable
+ *Arguments : pointer to explorer after search , pointers that receive number of cells that are reachable
+ *            but not visited or visited but not reachable , number of reachable cells ,
+ *            flood fill time in nanoseconds and number of sweeps
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY */
+u8 u8CheckCoverage(explorer *Explorer, u64 *Mismatches, u64 *Reachable, u64 *FloodTime, u32 *Sweeps);
+
+/*this function applies input map cell changes to a searched map and updates output map around them
+ *without a new search , newly reachable cells are walked and VISITED cells cut off from entry point
+ *become NOT_DISCOVERED again
+ *a cleared mine next to a VISITED cell becomes a frontier cell and search walks on from it , a new mine
+ *on a VISITED cell may cut VISITED cells off from entry point and a new mine on entry point cuts off all
+ *of them so search enters again at first NOT_MINE cell of first row , work done depends on changed cells ,
+ *cut off cells and newly reachable cells instead of map size
+ *a failure (memory of cut off and walk searches , input map file pages) stops the changes , explorer keeps it
+ *like a failed search step and maps are not valid anymore
+ *Arguments : pointer to explorer after search , array of changes and its number of entries ,
+ *            pointer that receives number of VISITED cells cut off
+ *Return    : ERROR_NONE , ERROR_NO_MEMORY , ERROR_ARENA_FULL , ERROR_READ_FILE (input map file pages can not
+ *            be made writable) or error that stopped a walk (see u8StepSearch();) */
+u8 u8ApplyMapChanges(explorer *Explorer, const mapchange *Changes, u32 Count, u32 *CutCells);
+
+/*this function sets up a live monitor for an output map with one byte per cell , bands of rows around
+ *current cell are then stamped by every step of an explorer the monitor is attached to
+ *Arguments : pointer to monitor , pointer to output map it watches
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY */
+u8 u8CreateMonitor(monitor *Monitor, const cellmap *map);
+
+/*this function releases band stamps of a live monitor
+ *Arguments : pointer to monitor
+ *Return    : void */
+void voidFreeMonitor(monitor *Monitor);
+
+/*this function sets up an empty snapshot of a live monitor , its first update copies every band
+ *Arguments : pointer to snapshot , pointer to monitor
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY */
+u8 u8CreateSnapshot(snapshot *Snapshot, const monitor *Monitor);
+
+/*this function releases a snapshot
+ *Arguments : pointer to snapshot
+ *Return    : void */
+void voidFreeSnapshot(snapshot *Snapshot);
+
+/*this function copies bands changed since last update of a snapshot and reads explorer position , it is called
+ *by reader thread while explorer runs and never makes explorer wait
+ *Arguments : pointer to monitor , pointer to snapshot of monitor
+ *Return    : number of copied bands */
+u32 u32UpdateSnapshot(monitor *Monitor, snapshot *Snapshot);
+
+/*this function makes an explorer write a checkpoint every period while it searches and starts checkpoint
+ *writer thread
+ *Arguments : pointer to explorer , pointer to checkpoint state , checkpoint file name , period in nanoseconds
+ *Return    : ERROR_NONE , ERROR_OPEN_FILE if file name is longer than CHECKPOINT_NAME_SIZE , ERROR_NO_MEMORY
+ *            or ERROR_THREAD */
+u8 u8StartCheckpoints(explorer *Explorer, checkpoint *Checkpoint, const char *FileName, u64 Period);
+
+/*this function waits for pending checkpoint image to be written , stops writer thread and stops checkpoints
+ *of an explorer
+ *Arguments : pointer to explorer with checkpoints
+ *Return    : void */
+void voidFinishCheckpoints(explorer *Explorer);
+
+/*this function restores search state of an explorer from a checkpoint file so u8WalkMap(); goes on
+ *where search stopped , output map is not valid anymore if checkpoint can not be restored
+ *Arguments : pointer to explorer created by u8CreateExplorer(); , checkpoint file name ,
+ *            pointer that receives planner checkpoint was written with (PLANNER_xxx)
+ *Return    : ERROR_NONE , ERROR_OPEN_FILE , ERROR_READ_FILE , ERROR_BAD_FILE if file is not a valid checkpoint
+ *            of input map , ERROR_PLANNER if it was written by a search with another planner than explorer has
+ *            or an error of u8PushBranch(); */
+u8 u8LoadCheckpoint(explorer *Explorer, const char *FileName, u8 *Planner);
+
+/*this function sets up a simulated sensor over an input map
+ *Arguments : pointer to sensor , pointer to sensed map , latency and jitter of a sensor read in nanoseconds , random seed
+ *Return    : void */
+void voidCreateSensor(sensor *Sensor, const cellmap *Inputmap, u64 Latency, u64 Jitter, u32 Seed);
+
+/*this function builds block summary of an output map from its current cell statuses , it is attached
+ *to an explorer afterwards (Explorer->Summary) so that search keeps it up to date
+ *Arguments : pointer to block summary , pointer to output map
+ *Return    : ERROR_NONE or ERROR_NO_MEMORY */
+u8 u8CreateSummary(blocksummary *Summary, const cellmap *map);
+
+/*this function releases block counts of a block summary
+ *Arguments : pointer to block summary
+ *Return    : void */
+void voidFreeSummary(blocksummary *Summary);
+
+/*this function finds DISCOVERED_NOT_MINE cell nearest to a cell (fewest rows plus columns) , blocks are searched
+ *from top level nearest first and blocks without frontier cells or farther than best cell found are skipped ,
+ *changed blocks are folded into levels above first
+ *Arguments : pointer to block summary , pointer to output map it summarizes , cell index , pointer that receives distance
+ *Return    : cell index of nearest frontier cell or 0 if there is none */
+u32 u32NearestFrontier(blocksummary *Summary, const cellmap *map, u32 Cell, u32 *Distance);
+
+/*this function gives number of blocks of a summary level that have no unknown or frontier cells left ,
+ *changed blocks are folded into levels above first
+ *Arguments : pointer to block summary , level
+ *Return    : number of finished blocks */
+u32 u32FinishedBlocks(blocksummary *Summary, u8 Level);
+
+#endif
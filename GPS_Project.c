@@ -1,63 +1,125 @@
+#if !defined(_WIN32)
+/*fseeko() and 64 bit file offsets for tiled maps*/
+#define _POSIX_C_SOURCE  200809L
+#define _FILE_OFFSET_BITS 64
+#endif
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <stdatomic.h>
+#include <signal.h>
+#if !defined(_WIN32)
+#include <pthread.h>
+#include <sched.h>
+#include <dirent.h>
+#include <sys/resource.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+#include "GPS_Explorer.h"
 
 
 /*==================================================================================*/
 /*==================================================================================*/
 /*New Types definitions*/
 /*=========================================*/
-typedef unsigned char   u8;
-typedef unsigned int    u16;
-/*==================================================================================*/
-/*==================================================================================*/
-/*Define new data structure Cell that will enable each cell to have information
- *about surrounding cells*/
-typedef struct struct_cell cell;
-struct struct_cell
+/*Built in map elements Size (BUILTIN_MAP_HEIGHT,BUILTIN_MAP_WIDTH) used when no map file is given*/
+#define BUILTIN_MAP_HEIGHT       5
+#define BUILTIN_MAP_WIDTH        5
+
+/*Trace stream buffer size*/
+#define TRACE_BUFFER_SIZE        (1024*1024)
+
+/*Define new data structure Batch Job that locates one map of a batch , a whole map file of a
+ *directory or one map of a file of concatenated maps*/
+typedef struct struct_batch_job batchjob;
+struct struct_batch_job
+{
+    u32 File;      //index of file name in batch file names
+    u32 Number;    //map number inside its file , 0 for first map
+    u64 Offset;    //file offset of first map byte
+    u64 Length;    //number of map bytes
+};
+
+/*Define new data structure Batch Result that holds result record of one batch map*/
+typedef struct struct_batch_result batchresult;
+struct struct_batch_result
 {
-    u8   Status;   //Cell status name
-    cell *RCell;   //pointer to right cell
-    cell *LCell;   //pointer to left cell
-    cell *UpCell;  //pointer to upper cell
-    cell *LowCell; //pointer to lower cell
+    u8  Status;          //BATCH_xxx
+    u8  Error;           //error that stopped search of a BATCH_FAILED map (ERROR_xxx)
+    u32 Width;           //map size without borders
+    u32 Height;
+    u32 Steps;           //number of search steps
+    u32 Backtracks;      //number of back propagations
+    u32 ReachableCells;  //number of VISITED cells in final output map
+    u64 Hash;            //hash of final output map (u64HashMap())
 };
 
+/*Define new data structure Batch Worker that holds one batch thread explorer and buffers
+ *they are reused for every map the worker searches and only grow when a bigger map comes*/
+typedef struct struct_batch_worker batchworker;
+struct struct_batch_worker
+{
+    explorer Explorer;        //explorer , its branch stack keeps its entries between maps
+    u8       *Bytes;          //map bytes read from batch file
+    u64      BytesCapacity;
+    u8       *Input;          //input map status of text maps
+    u64      InputCapacity;
+    u8       *Output;         //output map status
+    u64      OutputCapacity;
+    FILE     *File;           //open batch file and its index in batch file names
+    u32      FileIndex;
+};
 
-/*Configurations*/
-/*==================================================================================*/
-/*==================================================================================*/
-/*Cell Status names*/
-/*=========================================*/
-/* NOT_DISCOVERED      : Cell is not yet discovered by algorithm
- * MINE                : this cell is a Mine
- * NOT_MINE            : this cell is not a Mine
- * VISITED             : this cell have been visited by algorithm
- * DISCOVERED_NOT_MINE : this cell wad discovered not to be a Mine by algorithm
- * BORDER              : this cell is map border cell
- * CURRENT_LOCATION    : algorithm is currently in this cell
- */
-#define NOT_DISCOVERED           '0'
-#define MINE                     '*'
-#define NOT_MINE                 '-'
-#define VISITED                  ' '
-#define DISCOVERED_NOT_MINE      'D'
-#define BORDER                   '='
-#define CURRENT_LOCATION         '+'
-
-/*Map elements Size (MAP_SIZE,MAP_SIZE)*/
-#define MAP_SIZE         5
-
-/*last available cell queue size*/
-#define QUEUE_SIZE       10
-
-/*Define true and false*/
-#define TRUE             1
-#define FALSE            0
+/*Batch result status
+ * BATCH_SEARCHED : map was searched
+ * BATCH_NO_ENTRY : first row of map is full of mines
+ * BATCH_BAD_MAP  : map could not be read or is not a valid map
+ * BATCH_FAILED   : search of map stopped on an error*/
+#define BATCH_SEARCHED           0
+#define BATCH_NO_ENTRY           1
+#define BATCH_BAD_MAP            2
+#define BATCH_FAILED             3
+
+/*Hash of output maps (64 bit FNV-1a)*/
+#define HASH_OFFSET_BASIS        0xCBF29CE484222325ULL
+#define HASH_PRIME               0x00000100000001B3ULL
+
+/*Default mine density (%) of uniform maps*/
+#define DEFAULT_MINE_DENSITY     25
+
+/*Benchmark suite , square maps of every family from 5 x 5 up to 16384 x 16384 generated with BENCH_SEED*/
+#define BENCH_SEED               1
+#define BENCH_MAX_SIDE           16384
+#define BENCH_SIZES              6
+
+/*Maximum number of live monitor snapshots per second*/
+#define MONITOR_MAX_RATE         1000
+
+/*Define new data structure Monitor Reader that holds live monitor thread state , it updates a snapshot of
+ *a running search at a fixed rate and writes it to a file in trace format if one is given*/
+typedef struct struct_monitor_reader monitorreader;
+struct struct_monitor_reader
+{
+    monitor     *Monitor;        //monitor of explorer
+    snapshot    Snapshot;        //reader copy of output map
+    u32         Rate;            //snapshots per second
+    FILE        *File;           //snapshot file , NULL to only take snapshots
+    atomic_uint Done;            //TRUE once search ended
+    u32         Snapshots;       //number of snapshots taken
+    u64         CopiedBands;     //number of bands copied to snapshot
+    u64         BusyBands;       //number of times a changed band was not copied as a step was writing to it
+};
 
 
 /*declare array of u8 number that will hold status of each input map cells*/
 /*========================================================================*/
-u8 cells[MAP_SIZE+2][MAP_SIZE+2] = {{'=','=','=','=','=','=','='},
+u8 cells[BUILTIN_MAP_HEIGHT+2][BUILTIN_MAP_WIDTH+2] = {{'=','=','=','=','=','=','='},
                                     {'=','-','-','-','-','*','='},
                                     {'=','-','-','-','-','*','='},
                                     {'=','-','-','-','*','-','='},
@@ -66,7 +128,7 @@ u8 cells[MAP_SIZE+2][MAP_SIZE+2] = {{'=','=','=','=','=','=','='},
                                     {'=','=','=','=','=','=','='}};
 /*10 x 10 Map */
 /*===================================================================================
-u8 cells[MAP_SIZE+2][MAP_SIZE+2] = {{'=','=','=','=','=','=','=','=','=','=','=','='},
+u8 cells[BUILTIN_MAP_HEIGHT+2][BUILTIN_MAP_WIDTH+2] = {{'=','=','=','=','=','=','=','=','=','=','=','='},
                                     {'=','-','*','*','*','*','-','-','-','-','*','='},
                                     {'=','-','*','-','-','-','-','-','*','-','-','='},
                                     {'=','-','*','-','-','-','-','-','-','-','-','='},
@@ -85,560 +147,1956 @@ u8 cells[MAP_SIZE+2][MAP_SIZE+2] = {{'=','=','=','=','=','=','=','=','=','=','='
 /*Functions Prototypes*/
 /*=========================================*/
 
-/*this function is responsible for initializing a map with its initial status value for each cell
- *as well as establishing links between each cells(initialize each cell pointers)
- *Arguments : it takes a 2D array of cell type that represent a map map[row][col]
+/*this function reads a generated map description "family:WidthxHeight[:seed[:density]]"
+ *it prints a message and terminates program if description is not valid
+ *Arguments : description , pointers that receive family , number of columns and rows , seed and density
  *Return    : void */
-void voidInitializeMap(cell map[][(MAP_SIZE+2)]);
+void voidParseMapSpec(const char *Spec, u8 *Family, u32 *Width, u32 *Height, u32 *Seed, u32 *Density);
 
-/*this function creates an Input map from predefined u8 array cells[][]
- *Arguments : it takes a 2D array of cell type that represent a map map[row][col]
+/*this function prints why a library function failed and terminates program , nothing is done if it did not fail
+ *Arguments : error code returned by library function (ERROR_xxx) , what was being done and name of its file or map
+ *            (NULL if there is none) for the message
  *Return    : void */
-void voidCreateInputMap(cell map[][(MAP_SIZE+2)]);
+void voidExitOnError(u8 Error, const char *What, const char *Name);
 
-/*this function prints a map passed to it
- *Arguments : it takes a 2D array of cell type that represent a map map[row][col]
+/*this function selects trace stream , trace is written to a file or to stdout through a large buffer
+ *(a small buffer taken from map arena with MAP_ARENA)
+ *Arguments : trace file name or NULL for stdout
  *Return    : void */
-void voidPrintMap(cell map[][(MAP_SIZE+2)]);
+void voidOpenTrace(const char *FileName);
 
-/*this function Searches the map and uses TakeAction(); and UpdateOutputMap(); functions to do that
+/*this function flushes and closes trace stream
  *Arguments : void
  *Return    : void */
-void voidSearchMap(void);
+void voidCloseTrace(void);
 
-/*this function contain the algorithm used for decision making based on surrounding cell status
- *it decide which cell should be visited next
- *Arguments : void
+/*this function times parallel flood fill of input map with 1 , 2 , 4 ... MaxThreads explorers , compares
+ *each time with serial flood fill of same kind (walker search is printed for reference only , it takes
+ *backtracking steps and explores cells in another order) and each output map with walker output map
+ *Arguments : pointer to explorer , maximum number of explorers , walker search time in nanoseconds
  *Return    : void */
-void voidTakeAction(void);
+void voidParallelReport(explorer *Explorer, u32 MaxThreads, u64 WalkTime);
 
-/*this function responsible for changing output map cell's status based on discovered input map cells
- *it also saves last available cell coordinates in case the algorithm got stuck in a dead end rout
- *it could reposition itself to a cell that has available routs
- *ie cells that is surrounded by more than one NOT_MINE Cells
- *
- *Arguments : void
+/*this function is SIGUSR1 handler , it only asks search loop to dump search counters
+ *Arguments : signal number
  *Return    : void */
-void voidUpdateOutputMap(void);
+void voidStatsSignal(int Signal);
 
-/*this function reposition current cell position to last available cell so that
- *search algorithm can take new rout
- *Arguments : void
+/*this function hashes size and status of all cells of a map (64 bit FNV-1a)
+ *Arguments : pointer to map
+ *Return    : hash */
+u64 u64HashMap(const cellmap *map);
+
+/*this function searches every map of a directory of map files or of a file of concatenated maps
+ *on a pool of worker threads and writes one result record per map in batch order to trace stream
+ *Arguments : directory or file name , number of workers or 0 for one worker per processor
  *Return    : void */
-void voidBackPropagate(void);
+void voidRunBatch(const char *Path, u32 Workers);
 
+/*this function compares two file names for qsort();
+ *Arguments : pointers to two file name pointers
+ *Return    : strcmp(); result */
+int intCompareNames(const void *Name1, const void *Name2);
 
-/*this function reposition current cell position to Right Cell
- *Arguments : void
+/*this function finds maps of a batch , every file of a directory (in name order) is one map
+ *and a file given alone may hold several concatenated maps
+ *Arguments : directory or file name
  *Return    : void */
-void voidGotoRightCell(void);
+void voidScanBatch(const char *Path);
 
-/*this function reposition current cell position to Left Cell
- *Arguments : void
+/*this function adds a file name to batch file names
+ *Arguments : allocated file name , released with batch
  *Return    : void */
-void voidGotoLeftCell(void);
+void voidAddBatchFile(char *Name);
 
-/*this function reposition current cell position to Upper Cell
- *Arguments : void
+/*this function adds a map to batch jobs
+ *Arguments : file index , map number inside file , file offset and length of map bytes
  *Return    : void */
-void voidGotoUppertCell(void);
+void voidAddBatchJob(u32 File, u32 Number, u64 Offset, u64 Length);
 
-/*this function reposition current cell position to Lower Cell
- *Arguments : void
+/*this function finds concatenated maps of a batch file , map files are found by their headers and
+ *text maps are runs of lines with map characters separated by lines without map characters
+ *Arguments : file index
  *Return    : void */
-void voidGotoLowerCell(void);
+void voidScanBatchFile(u32 File);
 
+/*this function is run by every batch worker , it takes next batch job until all maps are searched
+ *Arguments : pointer to batch worker
+ *Return    : NULL */
+void *pvBatchWorker(void *Argument);
 
+/*this function reads , searches and records one batch map using worker buffers
+ *Arguments : pointer to batch worker , job index
+ *Return    : void */
+void voidSearchBatchJob(batchworker *Worker, u32 Job);
+
+/*this function makes a worker buffer hold at least a number of bytes , it is cache aligned
+ *and its old content is dropped when it grows
+ *Arguments : pointer to buffer pointer , pointer to buffer capacity , needed number of bytes
+ *Return    : TRUE if buffer is big enough , FALSE if there is not enough memory */
+u8 u8GrowBuffer(u8 **Buffer, u64 *Capacity, u64 Size);
+
+/*this function reads a batch map into worker buffers , a map file is used as it is read and
+ *a text map is converted to a status array with borders like u8LoadTextMap(); does
+ *Arguments : pointer to batch worker , pointer to job , pointers that receive input map status
+ *            array including borders and map dimensions
+ *Return    : TRUE if map is valid , FALSE otherwise */
+u8 u8ReadBatchMap(batchworker *Worker, const batchjob *Job, u8 **Input, u32 *Width, u32 *Height);
+
+/*this function runs benchmark suite , every map family in every suite size up to a maximum side ,
+ *or a single generated map , and writes one JSON record per search to trace stream
+ *Arguments : generated map description or NULL for whole suite , maximum map side of suite , back propagation planner
+ *Return    : void */
+void voidRunBenchmark(const char *Spec, u32 MaxSide, u8 Planner);
 
-/*==================================================================================*/
-/*==================================================================================*/
-/*Global variable*/
-/*=========================================*/
-
-/*Maps*/
-/*=========================*/
-/*I/P map of type cell*/
-cell Inputmap[MAP_SIZE+2][MAP_SIZE+2];
-/*O/P map of type cell*/
-cell Outputmap[MAP_SIZE+2][MAP_SIZE+2];
-/*=========================*/
+/*this function generates and searches one benchmark map and writes its JSON record
+ *per step trace of the search (if any) goes to a temporary file and is only counted
+ *Arguments : family , number of columns and rows , seed , density , back propagation planner , TRUE for first record
+ *Return    : void */
+void voidBenchmarkMap(u8 Family, u32 Width, u32 Height, u32 Seed, u32 Density, u8 Planner, u8 First);
 
-/*Cell pointer that will be used to point to input map current position
- *and will be used to navigate through input map and collect information about cells*/
-cell *CurrentInputCell  = NULL;
-/*Cell pointer that will be used to point to output map current position
- *and will be used to navigate through output map*/
-cell *CurrentOutputCell = NULL;
+/*this function finds memory used by status of a map
+ *Arguments : pointer to map
+ *Return    : number of bytes */
+u64 u64MapMemory(const cellmap *map);
 
+/*this function answers queries of a file over output map of explorer , each query is a line
+ *"row1 col1 row2 col2" in map coordinates (border row and column are 0) , answers go to trace stream
+ *Arguments : pointer to explorer after search , query file name
+ *Return    : void */
+void voidRunPathQueries(explorer *Explorer, const char *FileName);
 
-/* Note remember to chose queue size that match array size for bigger map you will need a bigger queue size
- * to match it other wise last available number will exceed queue size*/
-/*Pointer to Last available input map cell*/
-cell *LastAvailableInputCell[QUEUE_SIZE] = {NULL};
-/*Pointer to Last available output map cell*/
-cell *LastAvailableOutputCell[QUEUE_SIZE]= {NULL};
+/*this function reads map changes from a file and applies them to explorer after search , each change is
+ *a line "row col status" in map coordinates with status '*' (new mine) or '-' (cleared cell)
+ *Arguments : pointer to explorer after search , map changes file name
+ *Return    : void */
+void voidRunMapChanges(explorer *Explorer, const char *FileName);
 
+/*this function prints explored part of map , cells of every class and finished blocks from block summary
+ *of explorer and frontier cell nearest to explorer
+ *Arguments : pointer to explorer with block summary
+ *Return    : void */
+void voidSummaryReport(explorer *Explorer);
 
+/*this function writes a map to a map archive and prints archive size against map file size
+ *Arguments : name of map for the report , pointer to map , map archive file name
+ *Return    : void */
+void voidArchiveReport(const char *Name, cellmap *map, const char *FileName);
 
+/*this function is run by live monitor thread , it updates snapshot of search at every period until
+ *search ends , then it takes last snapshot
+ *Arguments : pointer to monitor reader
+ *Return    : NULL */
+void *pvMonitorReader(void *Argument);
 
-/*Dead end variable that is used to terminate Search*/
-u8 DeadendCondition = FALSE;
+/*this function updates snapshot of monitor reader and writes it to snapshot file the way voidTraceStep();
+ *writes output map so GPS_Replay can read it
+ *Arguments : pointer to monitor reader
+ *Return    : void */
+void voidRecordSnapshot(monitorreader *Reader);
 
-/*Number of visited Cells variable*/
-u16 visited_cells =0;
 
-/*Number of available Cells variable*/
-u16 NumberOfAvailableCells =0;
 
 /*==================================================================================*/
 /*==================================================================================*/
+/*Global variable*/
+/*=========================================*/
 
-u8 main(void)
-{
-    /*Initialize Input map*/
-    voidInitializeMap(Inputmap);
-    /*Initialize Output map*/
-    voidInitializeMap(Outputmap);
-    /*Create Input map*/
-    voidCreateInputMap(Inputmap);
-    /*print Input map*/
-    printf("Input Map :\n"
-           "==============================\n");
-    voidPrintMap(Inputmap);
-    /*Search input map*/
-    voidSearchMap();
-    scanf("%d");
-}
+/*Maps*/
+/*=========================*/
+/*Names of generated map families*/
+const char *MapFamilyNames[MAP_FAMILIES] = {"uniform", "maze", "corridor", "open", "worst"};
+/*Names of back propagation planners as they are given on command line*/
+const char *PlannerNames[PLANNER_NEAREST + 1] = {"off", "measure", "nearest"};
+
+/*Explorer of the map given on command line , it holds I/P and O/P maps and search state*/
+explorer MapExplorer;
+#if MAP_ARENA == TRUE
+/*Map arena and its memory , maps and search memory of explorer are taken from it*/
+_Alignas(CACHE_LINE_SIZE) u8 ArenaMemory[ARENA_SIZE];
+arena MapArena;
+#endif
+/*=========================*/
+
+/*Errors*/
+/*=========================*/
+/*Text of library error codes (ERROR_xxx)*/
+const char *ErrorText[ERROR_CODES] = {"no error", "search is done", "not enough memory", "map arena is full",
+                                      "map size is not supported by this build", "can not open file",
+                                      "can not read file", "can not write file", "not a valid file",
+                                      "can not start thread", "written by a search with another planner",
+                                      "first row is full of mines", "search check failed"};
+/*=========================*/
+
+/*Search counters*/
+/*=========================*/
+/*Dump request set by SIGUSR1 , it is taken by explorer of the map given on command line*/
+volatile sig_atomic_t StatsDumpRequest = 0;
+/*=========================*/
+
+/*Trace*/
+/*=========================*/
+/*Trace stream and trace level*/
+FILE *TraceFile  = NULL;
+u8   TraceLevel  = TRACE_FULL;
+/*Number of steps between two output map snapshots in TRACE_FULL level*/
+u32  TraceSnapshotPeriod = 1;
+/*=========================*/
+
+/*Search counters*/
+/*=========================*/
+/*Dump format and counters file name (NULL for stderr)*/
+u8   StatsFormat   = STATS_FORMAT_OFF;
+const char *StatsFileName = NULL;
+/*=========================*/
+
+/*Batch*/
+/*=========================*/
+/*Batch file names , maps found in them and their results*/
+char        **BatchFiles = NULL;
+u32         BatchFileCount = 0;
+batchjob    *BatchJobs = NULL;
+u32         BatchJobCount = 0;
+batchresult *BatchResults = NULL;
+/*Next batch job to be taken by a worker*/
+atomic_uint BatchNextJob;
+/*=========================*/
 
 /*==================================================================================*/
 /*==================================================================================*/
-/*Function Implementations*/
-
-/*this function is responsible for initializing a map with its initial status value for each cell
- *as well as establishing links between each cells(initialize each cell pointers)
- *Arguments : it takes a 2D array of cell type that represent a map map[row][col]
- *Return    : void */
-void voidInitializeMap(cell map[][(MAP_SIZE+2)])
+int main(int argc, char *argv[])
 {
-    /*2 loops to go through all map cells*/
-     for(u8 i = 0 ; i<(MAP_SIZE+2) ; i++)
+    /*Explorer of the map given on command line and its input map*/
+    explorer *Explorer = &MapExplorer;
+    cellmap  Inputmap;
+    /*Simulated sensor input map cells are read through if asked to*/
+    sensor   Sensor;
+    /*Live monitor of search and thread that reads it if asked to*/
+    monitor       Monitor;
+    monitorreader Reader;
+    /*Periodic checkpoints of search if asked to*/
+    checkpoint    Checkpoint;
+    /*Block summary of output map if asked to*/
+    blocksummary  Summary;
+#if !defined(_WIN32)
+    pthread_t     ReaderThread;
+#endif
+    /*Map source status array and its dimensions*/
+    u8  *Source;
+    u32 Width;
+    u32 Height;
+    /*Command line options*/
+    const char *MapFileName   = NULL;
+    const char *TraceFileName = NULL;
+    const char *SaveFileName  = NULL;
+    const char *ArchiveFileName = NULL;
+    const char *OutputArchiveName = NULL;
+    const char *BatchPath     = NULL;
+    const char *GenerateSpec  = NULL;
+    const char *QueryFileName = NULL;
+    const char *ChangeFileName = NULL;
+    u32 BenchmarkSide   = 0;
+    u8  TraceLevelGiven = FALSE;
+    u32 ParallelThreads = 0;
+    u32 BatchWorkers    = 0;
+    u8  Planner         = PLANNER_OFF;
+    const char *SensorSpec = NULL;
+    const char *MonitorSpec = NULL;
+    const char *CheckpointSpec = NULL;
+    const char *ResumeFileName = NULL;
+    /*Map arena maps and search memory are taken from (MAP_ARENA)*/
+    arena *Arena = NULL;
+    u8  BestEntry       = FALSE;
+    u8  CheckCoverage   = FALSE;
+    u8  KeepSummary     = FALSE;
+    /*Single explorer search time*/
+    u64 SearchTime;
+    /*Result of library functions*/
+    u8  Error;
+
+    /*Parse command line : [-t off|summary|deltas|full] [-n snapshot period] [-o trace file]
+     *                     [-s map file to save input map to] [-a map archive to save input map to]
+     *                     [-A map archive to save final output map to] [-j max parallel flood fill explorers]
+     *                     [-b batch directory or file of maps] [-w batch workers]
+     *                     [-g family:WidthxHeight[:seed[:density]]] [-B benchmark max side]
+     *                     [-p off|measure|nearest] [-q path query file] [-u map changes file] [-e] [-v]
+     *                     [-m json|prometheus] [-M counters file] [-S latency_us[:jitter_us[:ahead]]]
+     *                     [-V snapshots per second[:snapshot file]] [-C seconds:checkpoint file]
+     *                     [-R checkpoint file to resume from] [-x] [map file]*/
+    /*=============================================*/
+    for(int i = 1; i < argc; i++)
     {
-        for(u8 j = 0 ; j<(MAP_SIZE+2) ; j++)
+        if( (0 == strcmp(argv[i], "-t")) && ((i+1) < argc) )
+        {
+            i++;
+            if     ( 0 == strcmp(argv[i], "off") )     { TraceLevel = TRACE_OFF;     }
+            else if( 0 == strcmp(argv[i], "summary") ) { TraceLevel = TRACE_SUMMARY; }
+            else if( 0 == strcmp(argv[i], "deltas") )  { TraceLevel = TRACE_DELTAS;  }
+            else if( 0 == strcmp(argv[i], "full") )    { TraceLevel = TRACE_FULL;    }
+            else
+            {
+                printf("Unknown trace level %s\n", argv[i]);
+                return 1;
+            }
+            TraceLevelGiven = TRUE;
+        }
+        else if( (0 == strcmp(argv[i], "-n")) && ((i+1) < argc) )
+        {
+            i++;
+            TraceSnapshotPeriod = (u32)strtoul(argv[i], NULL, 10);
+            if( 0 == TraceSnapshotPeriod )
+            {
+                TraceSnapshotPeriod = 1;
+            }
+        }
+        else if( (0 == strcmp(argv[i], "-o")) && ((i+1) < argc) )
+        {
+            i++;
+            TraceFileName = argv[i];
+        }
+        else if( (0 == strcmp(argv[i], "-s")) && ((i+1) < argc) )
+        {
+            i++;
+            SaveFileName = argv[i];
+        }
+        else if( (0 == strcmp(argv[i], "-a")) && ((i+1) < argc) )
         {
-            /*Border cell Check*/
-            if( (0 == i) || (0 == j) || ((MAP_SIZE+1) ==i) || ((MAP_SIZE+1) ==j) )
+            i++;
+            ArchiveFileName = argv[i];
+        }
+        else if( (0 == strcmp(argv[i], "-A")) && ((i+1) < argc) )
+        {
+            i++;
+            OutputArchiveName = argv[i];
+        }
+        else if( (0 == strcmp(argv[i], "-j")) && ((i+1) < argc) )
+        {
+            i++;
+            ParallelThreads = (u32)strtoul(argv[i], NULL, 10);
+            if( (0 == ParallelThreads) || (ParallelThreads > PARALLEL_MAX_THREADS) )
             {
-                /*if border cell fill it with BORDER status*/
-                map[i][j].Status =  BORDER;
+                printf("Number of parallel explorers must be 1 to %u\n", PARALLEL_MAX_THREADS);
+                return 1;
             }
+        }
+        else if( (0 == strcmp(argv[i], "-p")) && ((i+1) < argc) )
+        {
+            i++;
+            if     ( 0 == strcmp(argv[i], "off") )     { Planner = PLANNER_OFF;     }
+            else if( 0 == strcmp(argv[i], "measure") ) { Planner = PLANNER_MEASURE; }
+            else if( 0 == strcmp(argv[i], "nearest") ) { Planner = PLANNER_NEAREST; }
             else
             {
-                /*if not a border cell fill it with NOT_DISCOVERED status
-                 * and create links with surrounding cell by initializing 4 cell pointers*/
-                map[i][j].Status =  NOT_DISCOVERED;
-                map[i][j].RCell   = &map[i][j+1];
-                map[i][j].LCell   = &map[i][j-1];
-                map[i][j].UpCell  = &map[i+1][j];
-                map[i][j].LowCell = &map[i-1][j];
-            }/*end of border cell Check*/
-
-        }/*end of j for*/
-    }/*end of i for*/
-
-}/*end of voidInitializeMap()*/
+                printf("Unknown planner %s\n", argv[i]);
+                return 1;
+            }
+        }
+        else if( (0 == strcmp(argv[i], "-m")) && ((i+1) < argc) )
+        {
+            i++;
+            if     ( 0 == strcmp(argv[i], "json") )       { StatsFormat = STATS_FORMAT_JSON;       }
+            else if( 0 == strcmp(argv[i], "prometheus") ) { StatsFormat = STATS_FORMAT_PROMETHEUS; }
+            else
+            {
+                printf("Unknown counters format %s\n", argv[i]);
+                return 1;
+            }
+#if SEARCH_STATS == FALSE
+            printf("Search counters need a build with -DSEARCH_STATS=1\n");
+            return 1;
+#endif
+        }
+        else if( (0 == strcmp(argv[i], "-M")) && ((i+1) < argc) )
+        {
+            i++;
+            StatsFileName = argv[i];
+        }
+        else if( 0 == strcmp(argv[i], "-v") )
+        {
+            /*check output map against flood fill of input map*/
+            CheckCoverage = TRUE;
+        }
+        else if( 0 == strcmp(argv[i], "-x") )
+        {
+            /*keep block summary of output map during search*/
+            KeepSummary = TRUE;
+        }
+        else if( 0 == strcmp(argv[i], "-e") )
+        {
+            /*choose entry point that reaches most cells*/
+            BestEntry = TRUE;
+        }
+        else if( (0 == strcmp(argv[i], "-q")) && ((i+1) < argc) )
+        {
+            i++;
+            QueryFileName = argv[i];
+        }
+        else if( (0 == strcmp(argv[i], "-u")) && ((i+1) < argc) )
+        {
+            i++;
+            ChangeFileName = argv[i];
+        }
+        else if( (0 == strcmp(argv[i], "-S")) && ((i+1) < argc) )
+        {
+            i++;
+            SensorSpec = argv[i];
+        }
+        else if( (0 == strcmp(argv[i], "-V")) && ((i+1) < argc) )
+        {
+            i++;
+            MonitorSpec = argv[i];
+        }
+        else if( (0 == strcmp(argv[i], "-C")) && ((i+1) < argc) )
+        {
+            i++;
+            CheckpointSpec = argv[i];
+        }
+        else if( (0 == strcmp(argv[i], "-R")) && ((i+1) < argc) )
+        {
+            i++;
+            ResumeFileName = argv[i];
+        }
+        else if( (0 == strcmp(argv[i], "-g")) && ((i+1) < argc) )
+        {
+            i++;
+            GenerateSpec = argv[i];
+        }
+        else if( (0 == strcmp(argv[i], "-B")) && ((i+1) < argc) )
+        {
+            i++;
+            BenchmarkSide = (u32)strtoul(argv[i], NULL, 10);
+            if( (BenchmarkSide < BUILTIN_MAP_WIDTH) || (BenchmarkSide > BENCH_MAX_SIDE) )
+            {
+                printf("Benchmark max side must be %u to %u\n", BUILTIN_MAP_WIDTH, BENCH_MAX_SIDE);
+                return 1;
+            }
+        }
+        else if( (0 == strcmp(argv[i], "-b")) && ((i+1) < argc) )
+        {
+            i++;
+            BatchPath = argv[i];
+        }
+        else if( (0 == strcmp(argv[i], "-w")) && ((i+1) < argc) )
+        {
+            i++;
+            BatchWorkers = (u32)strtoul(argv[i], NULL, 10);
+            if( (0 == BatchWorkers) || (BatchWorkers > PARALLEL_MAX_THREADS) )
+            {
+                printf("Number of batch workers must be 1 to %u\n", PARALLEL_MAX_THREADS);
+                return 1;
+            }
+        }
+        else
+        {
+            MapFileName = argv[i];
+        }
+    }
 
-/*this function creates an Input map from predefined u8 array cells[][]
- *Arguments : it takes a 2D array of cell type that represent a map map[row][col]
- *Return    : void */
-void voidCreateInputMap(cell map[][(MAP_SIZE+2)])
-{
-    /*2 loops to go through all map cells from (1,1) cell to (MAP_SIZE,MAP_SIZE)*/
-    for(u8 i=1;i<(MAP_SIZE+1);i++)
+#if MAP_ARENA == TRUE
+    /*map arena is sized for one explorer*/
+    if( (NULL != BatchPath) || (0 != BenchmarkSide) || (0 != ParallelThreads) )
     {
-        for(u8 j=1;j<(MAP_SIZE+1);j++)
-        {
-            /*fill input map cell status value with cells array value*/
-            map[i][j].Status  = cells[i][j];
+        printf("Batch , benchmark and parallel searches need more than one explorer , they are not in map arena builds\n");
+        return 1;
+    }
+    /*text maps , map archives and generated maps are built on heap , map files are mapped*/
+    if( (NULL != GenerateSpec) || ((NULL != MapFileName) && (FALSE == u8IsMapFile(MapFileName))) )
+    {
+        printf("Map arena builds search built in map and map files only , text maps , map archives and generated maps "
+               "are built on heap (save them to a map file with -s in a build without MAP_ARENA)\n");
+        return 1;
+    }
+    voidSetArena(&MapArena, ArenaMemory, sizeof(ArenaMemory));
+    Arena = &MapArena;
+#endif
 
-        }/*end of j for*/
-    }/*end of i for*/
+    /*Trace stream must be set up before anything is written to it , its buffer is taken from map arena (MAP_ARENA)*/
+    voidOpenTrace(TraceFileName);
 
-}/*end of voidCreateInputMap();*/
+    /*Batch mode searches every map of a directory or file and writes one result record per map*/
+    if( NULL != BatchPath )
+    {
+        voidRunBatch(BatchPath, BatchWorkers);
+        voidCloseTrace();
+        return 0;
+    }
 
-/*this function prints a map passed to it
- *Arguments : it takes a 2D array of cell type that represent a map map[row][col]
- *Return    : void */
-void voidPrintMap(cell map[][(MAP_SIZE+2)])
-{
-    /*2 loops to go through all map cells from (0,0) cell to (MAP_SIZE+2,MAP_SIZE+2)
-     *to print all cells including Borders */
-    for(u8 i=0;i<(MAP_SIZE+2);i++)
+    /*Benchmark mode times searches only , so per step trace is off unless a trace level is given*/
+    if( 0 != BenchmarkSide )
     {
-        for(u8 j=0;j<(MAP_SIZE+2);j++)
+        if( FALSE == TraceLevelGiven )
         {
-            /*Print cell*/
-            printf("%c ",map[i][j].Status);
-        }/*end of j for*/
-
-        /*Print new line after each row*/
-        printf("\n");
-
-    }/*end of i for*/
-}
+            TraceLevel = TRACE_OFF;
+        }
+        voidRunBenchmark(GenerateSpec, BenchmarkSide, Planner);
+        voidCloseTrace();
+        return 0;
+    }
 
-/*this function uses TakeAction(); and UpdateOutputMap(); functions to search map until the whole map is discovered
- *Arguments : void but it manipulate a global variable
- *Return    : void */
-void voidSearchMap(void)
-{
+    /*Create Input map from map file or generated map if one is given otherwise from built in map cells[][]*/
+    if( NULL != GenerateSpec )
+    {
+        u8  Family;
+        u32 Seed, Density;
+        voidParseMapSpec(GenerateSpec, &Family, &Width, &Height, &Seed, &Density);
+        voidExitOnError(u8GenerateMap(Family, Width, Height, Seed, Density, &Source), "Can not generate map", GenerateSpec);
+        voidExitOnError(u8CreateInputMap(&Inputmap, Source, Width, Height, MAP_STORAGE_HEAP, Arena), "Can not create map", GenerateSpec);
+    }
+    else if( NULL == MapFileName )
+    {
+        voidExitOnError(u8CreateInputMap(&Inputmap, &cells[0][0], BUILTIN_MAP_WIDTH, BUILTIN_MAP_HEIGHT, MAP_STORAGE_STATIC, Arena),
+                        "Can not create built in map", NULL);
+    }
+    else if( TRUE == u8IsMapFile(MapFileName) )
+    {
+        voidExitOnError(u8LoadMapFile(&Inputmap, MapFileName, Arena), "Can not load map file", MapFileName);
+    }
+    else if( TRUE == u8IsMapArchive(MapFileName) )
+    {
+        voidExitOnError(u8LoadMapArchive(&Inputmap, MapFileName, Arena), "Can not load map archive", MapFileName);
+    }
+    else
+    {
+        voidExitOnError(u8LoadTextMap(MapFileName, &Source, &Width, &Height), "Can not load map file", MapFileName);
+        voidExitOnError(u8CreateInputMap(&Inputmap, Source, Width, Height, MAP_STORAGE_HEAP, Arena), "Can not create map", MapFileName);
+    }
 
-    /*loop first row in input map*/
-    for(u8 i = 1; i < (MAP_SIZE) ; i++)
+    /*Only convert input map to a map file or map archive if asked to*/
+    if( (NULL != SaveFileName) || (NULL != ArchiveFileName) )
     {
-        /*first row check*/
-        if( NOT_MINE == Inputmap[1][i].Status )
+        if( NULL != SaveFileName )
+        {
+            voidExitOnError(u8SaveMapFile(&Inputmap, SaveFileName), "Can not save map file", SaveFileName);
+        }
+        if( NULL != ArchiveFileName )
         {
-            /*Make the first available cell in the row the entry point for the search*/
-            /*visit that cell and update it's status by initializing searching input and output pointers*/
-            /*=============================================*/
-            CurrentInputCell  = &Inputmap[1][i];
-            CurrentOutputCell = &Outputmap[1][i];
-            /*=============================================*/
-            /*Increment number of visited cells*/
-            visited_cells++;
-            /*Break for loop*/
-            break;
+            voidArchiveReport("Input map", &Inputmap, ArchiveFileName);
+        }
+        voidFreeMap(&Inputmap);
+        voidCloseTrace();
+        return 0;
+    }
 
-        }/*end of first row check*/
+#if MAP_FIXED_WIDTH != 0
+    /*maps of other sizes are searched by generic search loop of u8WalkMap();*/
+    if( (MAP_FIXED_WIDTH != Inputmap.Width) || (MAP_FIXED_HEIGHT != Inputmap.Height) )
+    {
+        fprintf(TraceFile, "Map size %u x %u is not MAP_FIXED_HEIGHT x MAP_FIXED_WIDTH (%u x %u) , generic search loop is used\n",
+                Inputmap.Height, Inputmap.Width, MAP_FIXED_HEIGHT, MAP_FIXED_WIDTH);
+    }
+#endif
+
+    /*Explorer takes input map and creates its output map , it traces and counts as asked on command line*/
+    voidExitOnError(u8CreateExplorer(Explorer, &Inputmap, Arena), "Can not create explorer", NULL);
+    Explorer->TraceFile           = TraceFile;
+    Explorer->TraceLevel          = TraceLevel;
+    Explorer->TraceSnapshotPeriod = TraceSnapshotPeriod;
+    Explorer->StatsFormat         = StatsFormat;
+    Explorer->StatsFileName       = StatsFileName;
+    Explorer->Planner             = Planner;
+    /*input map cells are read through a simulated sensor , cells a few moves ahead of explorer are probed
+     *before it gets there unless ahead is 0*/
+    if( NULL != SensorSpec )
+    {
+        unsigned int Latency = 0, Jitter = 0, Ahead = 2;
+        if( (sscanf(SensorSpec, "%u:%u:%u", &Latency, &Jitter, &Ahead) < 1) || (Ahead > PROBE_AHEAD_MAX) )
+        {
+            printf("Sensor must be given as latency_us[:jitter_us[:ahead]] with ahead 0 to %u\n", PROBE_AHEAD_MAX);
+            return 1;
+        }
+        voidCreateSensor(&Sensor, &Explorer->Inputmap, (u64)Latency * 1000, (u64)Jitter * 1000, 1);
+        Explorer->Source     = &Sensor.Source;
+        Explorer->ProbeAhead = (u8)Ahead;
+    }
+    /*search goes on from a checkpoint of an earlier run over same input map if asked to*/
+    if( NULL != ResumeFileName )
+    {
+        u8 CheckpointPlanner;
 
-    }/*end of for loop*/
+        Error = u8LoadCheckpoint(Explorer, ResumeFileName, &CheckpointPlanner);
+        if( ERROR_PLANNER == Error )
+        {
+            printf("Checkpoint file %s was written by a search with planner %s , resume it with -p %s\n",
+                   ResumeFileName, PlannerNames[CheckpointPlanner], PlannerNames[CheckpointPlanner]);
+            exit(1);
+        }
+        voidExitOnError(Error, "Can not resume from checkpoint file", ResumeFileName);
+    }
+    /*block summary is built from output map as it is now and kept up to date from here on*/
+    if( TRUE == KeepSummary )
+    {
+        voidExitOnError(u8CreateSummary(&Summary, &Explorer->Outputmap), "Can not create block summary", NULL);
+        Explorer->Summary = &Summary;
+    }
+    /*print Input map*/
+    if( TraceLevel >= TRACE_SUMMARY )
+    {
+        fprintf(TraceFile, "Input Map :\n"
+                           "==============================\n");
+        voidPrintMap(TraceFile, &Explorer->Inputmap);
+    }
+    /*Search input map , counters can be dumped during a long search by sending SIGUSR1*/
+#if (SEARCH_STATS == TRUE) && !defined(_WIN32)
+    if( STATS_FORMAT_OFF != StatsFormat )
+    {
+        struct sigaction Action;
+        memset(&Action, 0, sizeof(Action));
+        Action.sa_handler = voidStatsSignal;
+        sigemptyset(&Action.sa_mask);
+        Action.sa_flags = SA_RESTART;
+        sigaction(SIGUSR1, &Action, NULL);
+        Explorer->StatsDumpRequest = &StatsDumpRequest;
+    }
+#endif
+    /*search is watched by a thread that takes snapshots while it runs*/
+    if( NULL != MonitorSpec )
+    {
+#if (MAP_PACKED == TRUE) || (MAP_TILED == TRUE) || defined(_WIN32)
+        printf("Live monitor needs one byte per cell maps and POSIX threads\n");
+        MonitorSpec = NULL;
+#else
+        const char *Colon = strchr(MonitorSpec, ':');
+
+        memset(&Reader, 0, sizeof(Reader));
+        Reader.Rate = (u32)strtoul(MonitorSpec, NULL, 10);
+        if( (0 == Reader.Rate) || (Reader.Rate > MONITOR_MAX_RATE) )
+        {
+            printf("Number of snapshots per second must be 1 to %u\n", MONITOR_MAX_RATE);
+            return 1;
+        }
+        if( NULL != Colon )
+        {
+            Reader.File = fopen(Colon + 1, "wb");
+            if( NULL == Reader.File )
+            {
+                printf("Can not create snapshot file %s\n", Colon + 1);
+                return 1;
+            }
+        }
+        voidExitOnError(u8CreateMonitor(&Monitor, &Explorer->Outputmap), "Can not create live monitor", NULL);
+        voidExitOnError(u8CreateSnapshot(&Reader.Snapshot, &Monitor), "Can not create live monitor snapshot", NULL);
+        Explorer->Monitor = &Monitor;
+        Reader.Monitor    = &Monitor;
+        atomic_init(&Reader.Done, FALSE);
+        if( 0 != pthread_create(&ReaderThread, NULL, pvMonitorReader, &Reader) )
+        {
+            printf("Can not start live monitor\n");
+            exit(1);
+        }
+#endif
+    }
+    /*search state is written to checkpoint file every period*/
+    if( NULL != CheckpointSpec )
+    {
+        const char *Colon = strchr(CheckpointSpec, ':');
+        u32 Period = (u32)strtoul(CheckpointSpec, NULL, 10);
 
-    /*Check CurrentInputCell value*/
-    if( NULL == CurrentInputCell )
+        if( (NULL == Colon) || ('\0' == Colon[1]) || (0 == Period) )
+        {
+            printf("Checkpoints must be given as seconds:checkpoint file\n");
+            return 1;
+        }
+        voidExitOnError(u8StartCheckpoints(Explorer, &Checkpoint, Colon + 1, (u64)Period * 1000000000ULL),
+                        "Can not write checkpoints to", Colon + 1);
+    }
+    SearchTime = u64ReadClock();
+    if( (TRUE == BestEntry) && (NULL == ResumeFileName) )
+    {
+        voidExitOnError(u8FindBestEntryCell(Explorer, &Explorer->EntryCell), "Can not analyse reachability of input map", NULL);
+    }
+    if( NULL != ResumeFileName )
+    {
+        /*explorer is where checkpoint left it*/
+        Error = u8WalkMap(Explorer);
+    }
+    else
+    {
+        Error = u8SearchMap(Explorer);
+    }
+    if( ERROR_NO_ENTRY == Error )
     {
-        /* if CurrentInputCell value is null that means that the first row
+        /* if there is no entry point that means that the first row
          * in input map is full of mines then print the following message and terminate program*/
         printf("First row is full of mines please rearrange another map\n");
         /*terminate program*/
         exit(0);
-
-    }/*end of CurrentInputCell value Check*/
-
-    /*print map before start searching*/
-    /*=============================================*/
-    printf("Output Map before search :\n"
-           "==============================\n");
-    voidPrintMap(Outputmap);
-    /*=============================================*/
-
-
-
-    /*loop these steps until dead end is reached*/
-    while(!DeadendCondition)
+    }
+    voidExitOnError(Error, "Search stopped", NULL);
+    SearchTime = u64ReadClock() - SearchTime;
+    if( NULL != CheckpointSpec )
     {
-        /*update output map status*/
-        voidUpdateOutputMap();
-
-        /*Print Current output map status*/
-        printf("Step Number : %d\n"
-               "==============================\n",visited_cells);
-        voidPrintMap(Outputmap);
-
-        /*position to next cell based on searching algorithm */
-        voidTakeAction();
-
-    }/*end of Searching loop*/
-
-    /*=============================================*/
-    /*Print final result of search*/
-    /*=============================================*/
-
-    /*print number of steps taken to search map*/
-    /*=============================================*/
-    printf("Map Searched in %d Steps\n"
-           "==============================\n",visited_cells);
-
-    /*Print original input map*/
-    /*=============================================*/
-    printf("Original Input Map\n"
-           "==============================\n");
-    voidPrintMap(Inputmap);
-
-    /*Print final output map*/
-    /*=============================================*/
-    printf("Final Output Map\n"
-           "==============================\n");
-    voidPrintMap(Outputmap);
-
-}/*end of voidSearchMap();*/
-
-/*this function responsible for changing output map cell's status based on discovered input map cells
- *it also saves last available cell coordinates in case the algorithm got stuck in a dead end rout
- *it could reposition itself to a cell that has available routs
- *ie cells that is surrounded by more than one NOT_MINE Cells
- *
- *Arguments : void
- *Return    : void */
-void voidUpdateOutputMap(void)
-{
-    /*available cell variable is used to store number of cells that is not a mine around current cell*/
-    u8 AvailableCells =0;
-
-    /*=====================================================================================*/
-    /*update current cell status to CURRENT_POSITION*/
-    CurrentOutputCell -> Status = CURRENT_LOCATION;
-
-    /*=====================================================================================*/
-    /*Update Surrounding Cells status*/
-    /*Leave VISTED status unchanged in output map*/
-    if( ( (CurrentOutputCell->RCell)  -> Status) != VISITED)
+        voidFinishCheckpoints(Explorer);
+    }
+#if !defined(_WIN32)
+    if( NULL != MonitorSpec )
     {
-        /*Copy Right cell status in input map to Right cell status in output map */
-        (CurrentOutputCell->RCell)  -> Status = (CurrentInputCell->RCell)  -> Status;
+        /*last snapshot shows searched map , later map changes are not watched*/
+        atomic_store(&Reader.Done, TRUE);
+        pthread_join(ReaderThread, NULL);
+        Explorer->Monitor = NULL;
     }
-    if( ( (CurrentOutputCell->LCell)  -> Status) != VISITED)
+#endif
+    if( ERROR_CHECK == u8PrintSearchResults(Explorer) )
     {
-        /*Copy Left cell status in input map to Left cell status in output map */
-        (CurrentOutputCell->LCell)  -> Status = (CurrentInputCell->LCell)  -> Status;
+        printf("Reachable cells mismatch : %u reachable , %u visited\n",
+               Explorer->ReachableCells, u32CountStatus(&Explorer->Outputmap, VISITED));
+        exit(1);
     }
-    if( ( (CurrentOutputCell->UpCell)  -> Status) != VISITED)
+    if( NULL != SensorSpec )
     {
-        /*Copy Upper cell status in input map to Upper cell status in output map */
-        (CurrentOutputCell->UpCell)  -> Status = (CurrentInputCell->UpCell)  -> Status;
+        fprintf(TraceFile, "Sensor : probed cells %llu , sensor reads %llu , cell reads %llu , waited %.3f ms\n"
+                           "==============================\n",
+                Sensor.Probes, Sensor.SensorReads, Sensor.CellReads, (double)Sensor.WaitTime / 1e6);
     }
-    if( ( (CurrentOutputCell->LowCell)  -> Status) != VISITED)
+    if( NULL != MonitorSpec )
     {
-        /*Copy Lower cell status in input map to Lower cell status in output map */
-        (CurrentOutputCell->LowCell)  -> Status = (CurrentInputCell->LowCell)  -> Status;
+        fprintf(TraceFile, "Monitor : %u snapshots at %u Hz , copied bands %llu , busy bands %llu , search %.3f ms\n"
+                           "==============================\n",
+                Reader.Snapshots, Reader.Rate, Reader.CopiedBands, Reader.BusyBands, (double)SearchTime / 1e6);
+        if( NULL != Reader.File )
+        {
+            fclose(Reader.File);
+        }
+        voidFreeSnapshot(&Reader.Snapshot);
+        voidFreeMonitor(&Monitor);
     }
-    /*=====================================================================================*/
-    /*Change every NOT_MINE status in Output map to DISCOVERED_NOT_MINE and increment number
-     *of available routs from this Cell */
-    if( ( (CurrentOutputCell->RCell)  -> Status) == NOT_MINE)
+    if( NULL != CheckpointSpec )
     {
-        (CurrentOutputCell->RCell)  -> Status  = DISCOVERED_NOT_MINE;
-        AvailableCells++;
+        fprintf(TraceFile, "Checkpoints : %u written , %u skipped , %u failed , longest stall %.3f ms\n"
+                           "==============================\n",
+                Checkpoint.Written, Checkpoint.Skipped, Checkpoint.Failed, (double)Checkpoint.LongestStall / 1e6);
     }
-    if( ( (CurrentOutputCell->LCell)  -> Status) == NOT_MINE)
+    if( STATS_FORMAT_OFF != StatsFormat )
     {
-        (CurrentOutputCell->LCell)  -> Status = DISCOVERED_NOT_MINE;
-        AvailableCells++;
+        voidExitOnError(u8DumpStats(Explorer), "Can not write search counters",
+                        (NULL == StatsFileName) ? "to stderr" : StatsFileName);
     }
-    if( ( (CurrentOutputCell->UpCell)  -> Status) == NOT_MINE)
+
+    /*Apply input map changes to searched map if asked to , checks below see changed map*/
+    if( NULL != ChangeFileName )
     {
-        (CurrentOutputCell->UpCell)  -> Status  = DISCOVERED_NOT_MINE;
-        AvailableCells++;
+        voidRunMapChanges(Explorer, ChangeFileName);
     }
-    if( ( (CurrentOutputCell->LowCell)  -> Status) == NOT_MINE)
+
+    /*Archive searched (and changed) output map if asked to*/
+    if( NULL != OutputArchiveName )
     {
-        (CurrentOutputCell->LowCell)  -> Status  = DISCOVERED_NOT_MINE;
-        AvailableCells++;
+        voidArchiveReport("Output map", &Explorer->Outputmap, OutputArchiveName);
     }
-    /*=====================================================================================*/
-    /* Save Current Coordinates of both maps if this input cell has more than one cell that is
-     * not a mine surrounding it*/
-    if( AvailableCells > 1 )
+
+    /*Report explored part of map and nearest frontier cell from block summary*/
+    if( TRUE == KeepSummary )
     {
-        /*Save Input map current cell position in available cells queue*/
-        LastAvailableInputCell[NumberOfAvailableCells]  = CurrentInputCell;
-        /*Save Output map current cell position in available cells queue*/
-        LastAvailableOutputCell[NumberOfAvailableCells] = CurrentOutputCell;
-        /*Increment number of available cells*/
-        NumberOfAvailableCells++;
+        voidSummaryReport(Explorer);
     }
 
-}/*end of voidUpdateOutputMap()*/
+    /*Check that search explored every reachable cell and nothing else if asked to*/
+    if( TRUE == CheckCoverage )
+    {
+        u64 Mismatches, Reachable, FloodTime;
+        u32 Sweeps;
 
-/*this function contain the algorithm used for decision making based on surrounding cell status
- *it decide which cell should be visited next
- *Arguments : void
- *Return    : void */
-void voidTakeAction(void)
-{
-    /*Algorithm sequence is
-    * Go to right cell if available if not
-    * Go to upper cell if available if not
-    * Go to Lower cell if available if not
-    * Go to Left cell if available if not
-    * if all surrounding cells are not available (ie mine or border or already visited)
-    * Go to last available cell (last cell that had more than one cell that were not a mine)
-    * that is done by voidBackPropagate(); function*/
+        voidExitOnError(u8CheckCoverage(Explorer, &Mismatches, &Reachable, &FloodTime, &Sweeps), "Can not check coverage", NULL);
 
-    /*======================================================================================*/
-    /*======================================================================================*/
-    /*Check surrounding cells availability*/
-    /*Check if Right cell is available (DISCOVERED_NOT_MINE)*/
-    if (DISCOVERED_NOT_MINE == ( (CurrentOutputCell->RCell)  -> Status) )
-    {
-        /*Goto Right cell*/
-        voidGotoRightCell();
+        fprintf(TraceFile, "Coverage check : reachable cells %llu , flood fill %.3f ms in %u sweeps , %s\n"
+                           "==============================\n",
+                Reachable, (double)FloodTime / 1e6, Sweeps,
+                (0 == Mismatches) ? "map fully explored" : "output map does not match reachable cells");
+        if( 0 != Mismatches )
+        {
+            fprintf(TraceFile, "%llu cells differ\n", Mismatches);
+        }
     }
-    /*Check if Upper cell is available (DISCOVERED_NOT_MINE)*/
-    else if (DISCOVERED_NOT_MINE == ( (CurrentOutputCell->UpCell)  -> Status) )
+
+    /*Answer safe path queries over discovered map if asked to*/
+    if( NULL != QueryFileName )
     {
-        /*Goto Upper cell*/
-        voidGotoUppertCell();
+        voidRunPathQueries(Explorer, QueryFileName);
     }
-    /*Check if Lower cell is available (DISCOVERED_NOT_MINE)*/
-    else if (DISCOVERED_NOT_MINE == ( (CurrentOutputCell->LowCell)  -> Status) )
+
+    /*Time parallel flood fill against serial flood fill if asked to , fills explore cells in another order
+     *than walker and take no backtracking steps*/
+    if( 0 != ParallelThreads )
     {
-        /*Goto Lower cell*/
-        voidGotoLowerCell();
+        voidParallelReport(Explorer, ParallelThreads, SearchTime);
     }
-    /*Check if Left cell is available (DISCOVERED_NOT_MINE)*/
-    else if (DISCOVERED_NOT_MINE == ( (CurrentOutputCell->LCell)  -> Status) )
+#if MAP_ARENA == TRUE
+    fprintf(TraceFile, "Arena : %llu of %llu bytes used , budget of %u x %u maps %llu bytes (input map %llu , output map %llu , "
+                       "branch stack %llu , routes %llu , trace buffer %llu)\n"
+                       "==============================\n",
+            Arena->Used, Arena->Size, ARENA_MAX_HEIGHT, ARENA_MAX_WIDTH, ARENA_BYTES, ARENA_INPUT_MAP_BYTES,
+            ARENA_OUTPUT_MAP_BYTES, ARENA_BRANCH_STACK_BYTES, ARENA_ROUTE_BYTES, ARENA_TRACE_BYTES);
+#endif
+    voidCloseTrace();
+
+    /*Release maps*/
+    if( TRUE == KeepSummary )
     {
-        /*Goto Left cell*/
-        voidGotoLeftCell();
+        Explorer->Summary = NULL;
+        voidFreeSummary(&Summary);
     }
-    /*in that case you are surrounded by mines and discovered cells */
-    else
-    {
-        /*Terminate condition variable*/
-        u8 TerminateCondition = TRUE;
-        /*loop entire output map cells from (1,1) to (MAP_SIZE,MAP_SIZE)*/
-        /*===================================================================*/
-        for(u8 i = 1;i < (MAP_SIZE+1) ; i++)
-        {
-            for(u8 j = 1;j < (MAP_SIZE+1) ; j++)
-            {
-                if( DISCOVERED_NOT_MINE == Outputmap[i][j].Status)
-                {
-                    /* if you fond any available cell in output map make Terminate Condition false
-                     * then beak j loop*/
-                    TerminateCondition = FALSE;
-                    break;
-                }
-            }/*end of j for loop*/
+    voidFreeExplorer(Explorer);
 
-            /*if you found any available cell in output map beak i loop*/
-            if( FALSE == TerminateCondition) {break;}
+    return 0;
+}
 
-        }/*end of i for loop*/
+/*==================================================================================*/
+/*==================================================================================*/
+/*Function Implementations*/
 
-        /*Termination condition check*/
-        if ( (TRUE == TerminateCondition) || (0 == NumberOfAvailableCells ) )
-        {
-            /*if there are no available moves or there are no cells that has not
-             *a mine in it (all map is either visited or a mine)
-             *then terminate Search and Mark Current cell VISITED*/
-            CurrentOutputCell-> Status = VISITED;
-            /*make dead end condition true*/
-            DeadendCondition = TRUE;
+/*this function reads a generated map description "family:WidthxHeight[:seed[:density]]"
+ *it prints a message and terminates program if description is not valid
+ *Arguments : description , pointers that receive family , number of columns and rows , seed and density
+ *Return    : void */
+void voidParseMapSpec(const char *Spec, u8 *Family, u32 *Width, u32 *Height, u32 *Seed, u32 *Density)
+{
+    char Name[16] = {0};
 
+    *Seed    = BENCH_SEED;
+    *Density = DEFAULT_MINE_DENSITY;
+    if( (sscanf(Spec, "%15[^:]:%ux%u:%u:%u", Name, Width, Height, Seed, Density) < 3) || (*Density > 100) )
+    {
+        printf("Generated map %s is not family:WidthxHeight[:seed[:density]]\n", Spec);
+        exit(1);
+    }
+    for(*Family = 0; *Family < MAP_FAMILIES; (*Family)++)
+    {
+        if( 0 == strcmp(Name, MapFamilyNames[*Family]) )
+        {
+            return;
         }
-        else
+    }
+    printf("Unknown map family %s , families are uniform maze corridor open worst\n", Name);
+    exit(1);
+
+}/*end of voidParseMapSpec()*/
+
+/*this function prints why a library function failed and terminates program , nothing is done if it did not fail
+ *Arguments : error code returned by library function (ERROR_xxx) , what was being done and name of its file or map
+ *            (NULL if there is none) for the message
+ *Return    : void */
+void voidExitOnError(u8 Error, const char *What, const char *Name)
+{
+    if( ERROR_NONE == Error )
+    {
+        return;
+    }
+
+    if( NULL == Name )
+    {
+        printf("%s : %s\n", What, ErrorText[Error]);
+    }
+    else
+    {
+        printf("%s %s : %s\n", What, Name, ErrorText[Error]);
+    }
+    exit(1);
+
+}/*end of voidExitOnError()*/
+
+/*this function selects trace stream , trace is written to a file or to stdout through a large buffer
+ *(a small buffer taken from map arena with MAP_ARENA)
+ *Arguments : trace file name or NULL for stdout
+ *Return    : void */
+void voidOpenTrace(const char *FileName)
+{
+    TraceFile = stdout;
+
+    if( NULL != FileName )
+    {
+        TraceFile = fopen(FileName, "wb");
+        if( NULL == TraceFile )
         {
-            /*Notify Back propagation event*/
-            printf("Back propagation happened\n");
-            /*go to last available cell*/
-            voidBackPropagate();
-        }/*end of termination condition check*/
+            printf("Can not create trace file %s\n", FileName);
+            exit(1);
+        }
+    }
 
-    }/*end of surrounding cells availability check */
+#if MAP_ARENA == TRUE
+    /*fully buffered stream whose buffer is in arena budget , there is no heap*/
+    char *Buffer = (char *)pvArenaAllocate(&MapArena, ARENA_TRACE_BYTES);
+    if( NULL == Buffer )
+    {
+        printf("Map arena has no room for trace buffer\n");
+        exit(1);
+    }
+    setvbuf(TraceFile, Buffer, _IOFBF, ARENA_TRACE_BYTES);
+#else
+    /*Large fully buffered stream so each step costs no system call*/
+    setvbuf(TraceFile, NULL, _IOFBF, TRACE_BUFFER_SIZE);
+#endif
 
-    /*======================================================================================*/
-    /*======================================================================================*/
-}/*end of voidTakeAction();*/
+}/*end of voidOpenTrace()*/
 
-/*this function reposition current cell position to last available cell so that search algorithm can take new rout
+/*this function flushes and closes trace stream
  *Arguments : void
  *Return    : void */
-void voidBackPropagate(void)
+void voidCloseTrace(void)
 {
-    /*Mark current cell visited then reposition to last available cell*/
-    /*========================================================*/
-    /*Mark Current cell VISITED*/
-    CurrentOutputCell-> Status = VISITED;
-    /*reposition current position for both maps to last available position*/
-    /*======================================================================================*/
-    CurrentInputCell  = LastAvailableInputCell[NumberOfAvailableCells-1];
-    CurrentOutputCell = LastAvailableOutputCell[NumberOfAvailableCells-1];
-    /*Decrement number of available cells by one*/
-    NumberOfAvailableCells--;
-    /*======================================================================================*/
-
-    /*increment number of visited cells*/
-    /*========================================================*/
-    visited_cells++;
-
-}/*end of voidBackPropagate();*/
-
-
-/*this function reposition current cell position to Right Cell
- *Arguments : void
+    if( stdout == TraceFile )
+    {
+        fflush(TraceFile);
+    }
+    else
+    {
+        fclose(TraceFile);
+    }
+    TraceFile = NULL;
+
+}/*end of voidCloseTrace()*/
+
+/*this function times parallel flood fill of input map with 1 , 2 , 4 ... MaxThreads explorers , compares
+ *each time with serial flood fill of same kind (walker search is printed for reference only , it takes
+ *backtracking steps and explores cells in another order) and each output map with walker output map
+ *Arguments : pointer to explorer , maximum number of explorers , walker search time in nanoseconds
  *Return    : void */
-void voidGotoRightCell(void)
+void voidParallelReport(explorer *Explorer, u32 MaxThreads, u64 WalkTime)
 {
+#if (MAP_PACKED == TRUE) || (MAP_TILED == TRUE) || defined(_WIN32)
+    (void)Explorer;
+    (void)MaxThreads;
+    (void)WalkTime;
+    fprintf(TraceFile, "Parallel search needs one byte per cell maps and POSIX threads\n");
+#else
+    cellmap Parallelmap;
+    u32 EntryCell = u32FindEntryCell(Explorer);
+    u32 Threads   = 1;
+    u32 Explored;
+    u64 FillTime;
+
+    voidExitOnError(u8CreateMap(&Parallelmap, Explorer->Inputmap.Width, Explorer->Inputmap.Height, NULL),
+                    "Can not create parallel search map", NULL);
+
+    /*speedups are measured against serial fill , walker takes backtracking steps a fill does not take*/
+    voidInitializeMap(&Parallelmap);
+    FillTime = u64ReadClock();
+    voidExitOnError(u8SerialFill(Explorer, &Parallelmap, EntryCell, &Explored), "Serial fill stopped", NULL);
+    FillTime = u64ReadClock() - FillTime;
+    fprintf(TraceFile, "Walker search : %.3f ms , %u steps (reference only , fills explore cells in another order "
+                       "and take no backtracking steps)\n"
+                       "Serial fill : %.3f ms , %u cells explored , output map %s\n",
+            (double)WalkTime / 1e6, Explorer->VisitedCells, (double)FillTime / 1e6, Explored,
+            (TRUE == u8CompareMaps(&Explorer->Outputmap, &Parallelmap)) ? "identical" : "DIFFERENT");
+
+    /*1 , 2 , 4 ... explorers and MaxThreads explorers last*/
+    while( Threads <= MaxThreads )
+    {
+        u64 Steals;
+        u64 Time;
 
-    /*Mark current cell visited then reposition to Right cell*/
-    /*========================================================*/
-    /*Mark Current cell VISITED*/
-    CurrentOutputCell-> Status = VISITED;
-    /*reposition current cell position to Right Cell*/
-    /*========================================================*/
-    /*Reposition Current Cell pointer in both maps to Right Cell*/
-    CurrentInputCell  = CurrentInputCell->RCell;
-    CurrentOutputCell = CurrentOutputCell->RCell;
-    /*increment number of visited cells*/
-    /*========================================================*/
-    visited_cells++;
+        voidInitializeMap(&Parallelmap);
+        Time = u64ReadClock();
+        voidExitOnError(u8ParallelSearch(Explorer, &Parallelmap, Threads, EntryCell, &Steals), "Parallel fill stopped", NULL);
+        Time = u64ReadClock() - Time;
 
-}
+        fprintf(TraceFile, "Parallel fill with %2u explorers : %.3f ms , speedup over serial fill %.2f , steals %llu , output map %s\n",
+                Threads, (double)Time / 1e6, (double)FillTime / (double)((0 == Time) ? 1 : Time), Steals,
+                (TRUE == u8CompareMaps(&Explorer->Outputmap, &Parallelmap)) ? "identical" : "DIFFERENT");
 
-/*this function reposition current cell position to Left Cell
- *Arguments : void
+        Threads = ((Threads < MaxThreads) && ((Threads * 2) > MaxThreads)) ? MaxThreads : (Threads * 2);
+    }
+    /*explorers of a single processor take turns , ratios above are not a speedup*/
+    if( sysconf(_SC_NPROCESSORS_ONLN) < 2 )
+    {
+        fprintf(TraceFile, "Only one processor is online : explorers take turns on it , there is no speedup on this machine\n");
+    }
+    fprintf(TraceFile, "==============================\n");
+
+    voidFreeMap(&Parallelmap);
+#endif
+
+}/*end of voidParallelReport()*/
+
+/*this function is SIGUSR1 handler , it only asks search loop to dump search counters
+ *Arguments : signal number
  *Return    : void */
-void voidGotoLeftCell(void)
+void voidStatsSignal(int Signal)
 {
-    /*Mark current cell visited then reposition to Left cell*/
-    /*========================================================*/
-    /*Mark Current cell VISITED*/
-    CurrentOutputCell-> Status = VISITED;
-    /*reposition current cell position to Left Cell*/
-    /*========================================================*/
-    /*Reposition Current Cell pointer in both maps to Left Cell*/
-    CurrentInputCell  = CurrentInputCell->LCell;
-    CurrentOutputCell = CurrentOutputCell->LCell;
-    /*increment number of visited cells*/
-    /*========================================================*/
-    visited_cells++;
-}
+    (void)Signal;
+    StatsDumpRequest = 1;
 
-/*this function reposition current cell position to Upper Cell
- *Arguments : void
+}/*end of voidStatsSignal()*/
+
+/*this function hashes size and status of all cells of a map (64 bit FNV-1a)
+ *Arguments : pointer to map
+ *Return    : hash */
+u64 u64HashMap(const cellmap *map)
+{
+    u64 Hash = HASH_OFFSET_BASIS;
+    u64 NumberOfCells = (u64)map->Stride * (u64)(map->Height+2);
+
+    for(u8 i = 0; i < 4; i++)
+    {
+        Hash = (Hash ^ (u8)(map->Width  >> (8*i))) * HASH_PRIME;
+        Hash = (Hash ^ (u8)(map->Height >> (8*i))) * HASH_PRIME;
+    }
+    for(u64 Index = 0; Index < NumberOfCells; Index++)
+    {
+        Hash = (Hash ^ MAP_GET(map,(u32)Index)) * HASH_PRIME;
+    }
+
+    return Hash;
+
+}/*end of u64HashMap()*/
+
+/*this function searches every map of a directory of map files or of a file of concatenated maps
+ *on a pool of worker threads and writes one result record per map in batch order to trace stream
+ *Arguments : directory or file name , number of workers or 0 for one worker per processor
  *Return    : void */
-void voidGotoUppertCell(void)
+void voidRunBatch(const char *Path, u32 Workers)
 {
-    /*Mark current cell visited then reposition to Upper cell*/
-    /*========================================================*/
-    /*Mark Current cell VISITED*/
-    CurrentOutputCell-> Status = VISITED;
-    /*reposition current cell position to Upper Cell*/
-    /*========================================================*/
-    /*Reposition Current Cell pointer in both maps to Upper Cell*/
-    CurrentInputCell  = CurrentInputCell->UpCell;
-    CurrentOutputCell = CurrentOutputCell->UpCell;
-    /*increment number of visited cells*/
-    /*========================================================*/
-    visited_cells++;
-}
+#if (MAP_PACKED == TRUE) || (MAP_TILED == TRUE)
+    (void)Path;
+    (void)Workers;
+    printf("Batch mode needs one byte per cell maps\n");
+    exit(1);
+#else
+    batchworker *Worker;
+    u64 Time = u64ReadClock();
+
+    voidScanBatch(Path);
+
+    if( 0 == Workers )
+    {
+#if defined(_WIN32)
+        Workers = 1;
+#else
+        long Processors = sysconf(_SC_NPROCESSORS_ONLN);
+        Workers = (Processors < 1) ? 1 : ((Processors > PARALLEL_MAX_THREADS) ? PARALLEL_MAX_THREADS : (u32)Processors);
+#endif
+    }
 
-/*this function reposition current cell position to Lower Cell
- *Arguments : void
+    Worker       = (batchworker *)calloc(Workers, sizeof(batchworker));
+    BatchResults = (batchresult *)calloc((0 == BatchJobCount) ? 1 : BatchJobCount, sizeof(batchresult));
+    if( (NULL == Worker) || (NULL == BatchResults) )
+    {
+        printf("Not enough memory for batch of %u maps\n", BatchJobCount);
+        exit(1);
+    }
+    atomic_store(&BatchNextJob, 0);
+
+    /*searches run side by side so none of them may write to trace stream*/
+    for(u32 i = 0; i < Workers; i++)
+    {
+        Worker[i].Explorer.TraceFile           = TraceFile;
+        Worker[i].Explorer.TraceLevel          = TRACE_OFF;
+        Worker[i].Explorer.TraceSnapshotPeriod = 1;
+    }
+
+#if defined(_WIN32)
+    Workers = 1;
+    pvBatchWorker(&Worker[0]);
+#else
+    /*calling thread is worker 0*/
+    pthread_t *Thread = (pthread_t *)malloc((size_t)Workers * sizeof(pthread_t));
+    if( NULL == Thread )
+    {
+        printf("Not enough memory for %u batch workers\n", Workers);
+        exit(1);
+    }
+    for(u32 i = 1; i < Workers; i++)
+    {
+        if( 0 != pthread_create(&Thread[i], NULL, pvBatchWorker, &Worker[i]) )
+        {
+            printf("Can not start batch worker %u\n", i);
+            exit(1);
+        }
+    }
+    pvBatchWorker(&Worker[0]);
+    for(u32 i = 1; i < Workers; i++)
+    {
+        pthread_join(Thread[i], NULL);
+    }
+    free(Thread);
+#endif
+    Time = u64ReadClock() - Time;
+
+    /*Write result records in batch order*/
+    /*=============================================*/
+    for(u32 Job = 0; Job < BatchJobCount; Job++)
+    {
+        batchresult *Result = &BatchResults[Job];
+        const char  *Name   = BatchFiles[BatchJobs[Job].File];
+
+        if( BATCH_SEARCHED == Result->Status )
+        {
+            fprintf(TraceFile, "%s#%u : %u x %u , steps %u , backtracks %u , reachable cells %u , hash %016llX\n",
+                    Name, BatchJobs[Job].Number, Result->Height, Result->Width, Result->Steps,
+                    Result->Backtracks, Result->ReachableCells, Result->Hash);
+        }
+        else if( BATCH_NO_ENTRY == Result->Status )
+        {
+            fprintf(TraceFile, "%s#%u : %u x %u , first row is full of mines\n",
+                    Name, BatchJobs[Job].Number, Result->Height, Result->Width);
+        }
+        else if( BATCH_FAILED == Result->Status )
+        {
+            fprintf(TraceFile, "%s#%u : %u x %u , search stopped : %s\n",
+                    Name, BatchJobs[Job].Number, Result->Height, Result->Width, ErrorText[Result->Error]);
+        }
+        else
+        {
+            fprintf(TraceFile, "%s#%u : not a valid map\n", Name, BatchJobs[Job].Number);
+        }
+    }
+    fprintf(TraceFile, "Batch of %u maps from %u files searched by %u workers in %.3f ms\n"
+                       "==============================\n",
+            BatchJobCount, BatchFileCount, Workers, (double)Time / 1e6);
+
+    /*Release workers and batch*/
+    /*=============================================*/
+    for(u32 i = 0; i < Workers; i++)
+    {
+        if( NULL != Worker[i].File )
+        {
+            fclose(Worker[i].File);
+        }
+        free(Worker[i].Bytes);
+        free(Worker[i].Input);
+        free(Worker[i].Output);
+        voidFreeBranchStack(&Worker[i].Explorer);
+    }
+    for(u32 i = 0; i < BatchFileCount; i++)
+    {
+        free(BatchFiles[i]);
+    }
+    free(Worker);
+    free(BatchFiles);
+    free(BatchJobs);
+    free(BatchResults);
+#endif
+
+}/*end of voidRunBatch()*/
+
+/*this function compares two file names for qsort();
+ *Arguments : pointers to two file name pointers
+ *Return    : strcmp(); result */
+int intCompareNames(const void *Name1, const void *Name2)
+{
+    return strcmp(*(char * const *)Name1, *(char * const *)Name2);
+
+}/*end of intCompareNames()*/
+
+/*this function finds maps of a batch , every file of a directory (in name order) is one map
+ *and a file given alone may hold several concatenated maps
+ *Arguments : directory or file name
+ *Return    : void */
+void voidScanBatch(const char *Path)
+{
+#if !defined(_WIN32)
+    struct stat PathStatus;
+    DIR *Directory;
+
+    if( (0 == stat(Path, &PathStatus)) && S_ISDIR(PathStatus.st_mode) && (NULL != (Directory = opendir(Path))) )
+    {
+        struct dirent *Entry;
+
+        while( NULL != (Entry = readdir(Directory)) )
+        {
+            struct stat FileStatus;
+            size_t Size = strlen(Path) + strlen(Entry->d_name) + 2;
+            char   *Name = (char *)malloc(Size);
+
+            if( NULL == Name )
+            {
+                printf("Not enough memory for batch file names\n");
+                exit(1);
+            }
+            snprintf(Name, Size, "%s/%s", Path, Entry->d_name);
+            if( ('.' == Entry->d_name[0]) || (0 != stat(Name, &FileStatus)) || !S_ISREG(FileStatus.st_mode) )
+            {
+                free(Name);
+                continue;
+            }
+            voidAddBatchFile(Name);
+        }
+        closedir(Directory);
+
+        /*same directory gives same batch order*/
+        qsort(BatchFiles, BatchFileCount, sizeof(char *), intCompareNames);
+        for(u32 File = 0; File < BatchFileCount; File++)
+        {
+            struct stat FileStatus;
+            stat(BatchFiles[File], &FileStatus);
+            voidAddBatchJob(File, 0, 0, (u64)FileStatus.st_size);
+        }
+        return;
+    }
+#endif
+
+    /*a single file of concatenated maps*/
+    char *Name = (char *)malloc(strlen(Path) + 1);
+    if( NULL == Name )
+    {
+        printf("Not enough memory for batch file names\n");
+        exit(1);
+    }
+    strcpy(Name, Path);
+    voidAddBatchFile(Name);
+    voidScanBatchFile(0);
+
+}/*end of voidScanBatch()*/
+
+/*this function adds a file name to batch file names
+ *Arguments : allocated file name , released with batch
+ *Return    : void */
+void voidAddBatchFile(char *Name)
+{
+    /*grow by doubling like branch stack*/
+    if( 0 == (BatchFileCount & (BatchFileCount - 1)) )
+    {
+        u32  NewCapacity = (0 == BatchFileCount) ? 1 : (BatchFileCount * 2);
+        char **NewFiles  = (char **)realloc(BatchFiles, (size_t)NewCapacity * sizeof(char *));
+        if( NULL == NewFiles )
+        {
+            printf("Not enough memory for batch file names\n");
+            exit(1);
+        }
+        BatchFiles = NewFiles;
+    }
+    BatchFiles[BatchFileCount] = Name;
+    BatchFileCount++;
+
+}/*end of voidAddBatchFile()*/
+
+/*this function adds a map to batch jobs
+ *Arguments : file index , map number inside file , file offset and length of map bytes
+ *Return    : void */
+void voidAddBatchJob(u32 File, u32 Number, u64 Offset, u64 Length)
+{
+    /*grow by doubling like branch stack*/
+    if( 0 == (BatchJobCount & (BatchJobCount - 1)) )
+    {
+        u32      NewCapacity = (0 == BatchJobCount) ? 1 : (BatchJobCount * 2);
+        batchjob *NewJobs    = (batchjob *)realloc(BatchJobs, (size_t)NewCapacity * sizeof(batchjob));
+        if( NULL == NewJobs )
+        {
+            printf("Not enough memory for batch of %u maps\n", NewCapacity);
+            exit(1);
+        }
+        BatchJobs = NewJobs;
+    }
+    BatchJobs[BatchJobCount].File   = File;
+    BatchJobs[BatchJobCount].Number = Number;
+    BatchJobs[BatchJobCount].Offset = Offset;
+    BatchJobs[BatchJobCount].Length = Length;
+    BatchJobCount++;
+
+}/*end of voidAddBatchJob()*/
+
+/*this function finds concatenated maps of a batch file , map files are found by their headers and
+ *text maps are runs of lines with map characters separated by lines without map characters
+ *Arguments : file index
+ *Return    : void */
+void voidScanBatchFile(u32 File)
+{
+    FILE *Stream = fopen(BatchFiles[File], "rb");
+    u32  Number = 0;
+    u8   Header[MAP_FILE_HEADER_SIZE];
+
+    if( NULL == Stream )
+    {
+        printf("Can not open batch file %s\n", BatchFiles[File]);
+        exit(1);
+    }
+
+    if( (4 == fread(Header, 1, 4, Stream)) && (0 == memcmp(Header, MAP_FILE_MAGIC, 4)) )
+    {
+        /*map files one after the other , anything that is not a whole map file ends the scan*/
+        u64 Offset = 0;
+        size_t Read;
+
+        rewind(Stream);
+        while( 0 != (Read = fread(Header, 1, MAP_FILE_HEADER_SIZE, Stream)) )
+        {
+            u64 Length = MAP_FILE_HEADER_SIZE + (u64)(u32ReadLittleEndian(&Header[4]) + 2ULL) *
+                                                (u64)(u32ReadLittleEndian(&Header[8]) + 2ULL);
+            if( (MAP_FILE_HEADER_SIZE != Read) || (0 != memcmp(Header, MAP_FILE_MAGIC, 4)) )
+            {
+                /*bad record , its job reports it*/
+                voidAddBatchJob(File, Number, Offset, Read);
+                break;
+            }
+            voidAddBatchJob(File, Number, Offset, Length);
+            Number++;
+            Offset += Length;
+#if defined(_WIN32)
+            if( 0 != _fseeki64(Stream, (long long)Offset, SEEK_SET) )
+#else
+            if( 0 != fseeko(Stream, (off_t)Offset, SEEK_SET) )
+#endif
+            {
+                break;
+            }
+        }
+    }
+    else
+    {
+        /*text maps*/
+        u64 Offset    = 0;
+        u64 MapStart  = 0;
+        u8  InMap     = FALSE;
+        u8  MapLine   = FALSE;
+        int Char;
+
+        rewind(Stream);
+        do
+        {
+            Char = getc(Stream);
+            if( (MINE == Char) || (NOT_MINE == Char) )
+            {
+                MapLine = TRUE;
+            }
+            else if( ('\n' == Char) || (EOF == Char) )
+            {
+                if( (TRUE == MapLine) && (FALSE == InMap) )
+                {
+                    /*first row of a map , find start of its line*/
+                    InMap = TRUE;
+                }
+                else if( (FALSE == MapLine) && (TRUE == InMap) )
+                {
+                    /*line without map characters ends a map*/
+                    voidAddBatchJob(File, Number, MapStart, Offset - MapStart);
+                    Number++;
+                    InMap = FALSE;
+                }
+                if( FALSE == InMap )
+                {
+                    MapStart = Offset + 1;
+                }
+                MapLine = FALSE;
+            }
+            Offset++;
+        }while( EOF != Char );
+
+        if( TRUE == InMap )
+        {
+            voidAddBatchJob(File, Number, MapStart, Offset - 1 - MapStart);
+        }
+    }
+
+    fclose(Stream);
+
+}/*end of voidScanBatchFile()*/
+
+/*this function is run by every batch worker , it takes next batch job until all maps are searched
+ *Arguments : pointer to batch worker
+ *Return    : NULL */
+void *pvBatchWorker(void *Argument)
+{
+    batchworker *Worker = (batchworker *)Argument;
+    u32 Job;
+
+    while( (Job = atomic_fetch_add(&BatchNextJob, 1)) < BatchJobCount )
+    {
+        voidSearchBatchJob(Worker, Job);
+    }
+
+    return NULL;
+
+}/*end of pvBatchWorker()*/
+
+/*this function reads , searches and records one batch map using worker buffers
+ *Arguments : pointer to batch worker , job index
+ *Return    : void */
+void voidSearchBatchJob(batchworker *Worker, u32 Job)
+{
+    explorer    *Explorer = &Worker->Explorer;
+    batchresult *Result   = &BatchResults[Job];
+    u32 Width, Height;
+    u8  *Input;
+
+    Result->Status = BATCH_BAD_MAP;
+    if( FALSE == u8ReadBatchMap(Worker, &BatchJobs[Job], &Input, &Width, &Height) )
+    {
+        return;
+    }
+    Result->Width  = Width;
+    Result->Height = Height;
+
+    /*both maps use worker buffers , output buffer only grows*/
+    u64 NumberOfCells = (u64)(Width+2) * (u64)(Height+2);
+    if( FALSE == u8GrowBuffer(&Worker->Output, &Worker->OutputCapacity, NumberOfCells) )
+    {
+        return;
+    }
+    if( (ERROR_NONE != u8CreateInputMap(&Explorer->Inputmap, Input, Width, Height, MAP_STORAGE_STATIC, NULL)) ||
+        (ERROR_NONE != u8CreateInputMap(&Explorer->Outputmap, Worker->Output, Width, Height, MAP_STORAGE_STATIC, NULL)) )
+    {
+        return;
+    }
+    voidInitializeMap(&Explorer->Outputmap);
+    voidResetExplorer(Explorer);
+
+    Result->Error = u8SearchMap(Explorer);
+    if( ERROR_NO_ENTRY == Result->Error )
+    {
+        Result->Status = BATCH_NO_ENTRY;
+        return;
+    }
+    if( ERROR_NONE != Result->Error )
+    {
+        Result->Status = BATCH_FAILED;
+        return;
+    }
+
+    Result->Status         = BATCH_SEARCHED;
+    Result->Steps          = Explorer->VisitedCells;
+    Result->Backtracks     = Explorer->Backtracks;
+    Result->ReachableCells = u32CountStatus(&Explorer->Outputmap, VISITED);
+    Result->Hash           = u64HashMap(&Explorer->Outputmap);
+
+}/*end of voidSearchBatchJob()*/
+
+/*this function makes a worker buffer hold at least a number of bytes , it is cache aligned
+ *and its old content is dropped when it grows
+ *Arguments : pointer to buffer pointer , pointer to buffer capacity , needed number of bytes
+ *Return    : TRUE if buffer is big enough , FALSE if there is not enough memory */
+u8 u8GrowBuffer(u8 **Buffer, u64 *Capacity, u64 Size)
+{
+    if( Size > *Capacity )
+    {
+        /*double capacity so a few maps of growing size do not grow it every time*/
+        u64 NewCapacity = (2 * *Capacity > Size) ? (2 * *Capacity) : Size;
+        NewCapacity = (NewCapacity + CACHE_LINE_SIZE - 1) & ~(u64)(CACHE_LINE_SIZE - 1);
+
+        free(*Buffer);
+        *Buffer   = (u8 *)aligned_alloc(CACHE_LINE_SIZE, (size_t)NewCapacity);
+        *Capacity = (NULL == *Buffer) ? 0 : NewCapacity;
+    }
+
+    return (NULL != *Buffer) ? TRUE : FALSE;
+
+}/*end of u8GrowBuffer()*/
+
+/*this function reads a batch map into worker buffers , a map file is used as it is read and
+ *a text map is converted to a status array with borders like u8LoadTextMap(); does
+ *Arguments : pointer to batch worker , pointer to job , pointers that receive input map status
+ *            array including borders and map dimensions
+ *Return    : TRUE if map is valid , FALSE otherwise */
+u8 u8ReadBatchMap(batchworker *Worker, const batchjob *Job, u8 **Input, u32 *Width, u32 *Height)
+{
+    u8  *Bytes;
+    u32 RowWidth = 0;
+
+    /*Read map bytes , batch file stays open for next map of the same file*/
+    /*=============================================*/
+    if( (NULL == Worker->File) || (Worker->FileIndex != Job->File) )
+    {
+        if( NULL != Worker->File )
+        {
+            fclose(Worker->File);
+        }
+        Worker->File      = fopen(BatchFiles[Job->File], "rb");
+        Worker->FileIndex = Job->File;
+        if( NULL == Worker->File )
+        {
+            return FALSE;
+        }
+    }
+    if( (FALSE == u8GrowBuffer(&Worker->Bytes, &Worker->BytesCapacity, Job->Length + 1)) ||
+#if defined(_WIN32)
+        (0 != _fseeki64(Worker->File, (long long)Job->Offset, SEEK_SET)) ||
+#else
+        (0 != fseeko(Worker->File, (off_t)Job->Offset, SEEK_SET)) ||
+#endif
+        (Job->Length != fread(Worker->Bytes, 1, (size_t)Job->Length, Worker->File)) )
+    {
+        return FALSE;
+    }
+    Bytes = Worker->Bytes;
+
+    /*Map file , status array follows header*/
+    /*=============================================*/
+    if( (Job->Length >= MAP_FILE_HEADER_SIZE) && (0 == memcmp(Bytes, MAP_FILE_MAGIC, 4)) )
+    {
+        *Width  = u32ReadLittleEndian(&Bytes[4]);
+        *Height = u32ReadLittleEndian(&Bytes[8]);
+        if( (0 == *Width) || (0 == *Height) || (((u64)(*Width+2) * (u64)(*Height+2)) > 0xFFFFFFFFULL) ||
+            (Job->Length != (MAP_FILE_HEADER_SIZE + (u64)(*Width+2) * (u64)(*Height+2))) )
+        {
+            return FALSE;
+        }
+        *Input = &Bytes[MAP_FILE_HEADER_SIZE];
+
+        /*Explorer relies on border cells around the map*/
+        for(u32 j = 0; j < (*Width+2); j++)
+        {
+            if( (BORDER != (*Input)[j]) || (BORDER != (*Input)[(u64)(*Height+1)*(*Width+2) + j]) )
+            {
+                return FALSE;
+            }
+        }
+        for(u32 i = 1; i < (*Height+1); i++)
+        {
+            if( (BORDER != (*Input)[(u64)i*(*Width+2)]) || (BORDER != (*Input)[(u64)i*(*Width+2) + *Width+1]) )
+            {
+                return FALSE;
+            }
+        }
+        return TRUE;
+    }
+
+    /*Text map , first pass finds map dimensions and checks that all rows have the same width*/
+    /*=============================================*/
+    *Width  = 0;
+    *Height = 0;
+    Bytes[Job->Length] = '\n';
+    for(u64 i = 0; i <= Job->Length; i++)
+    {
+        if( (MINE == Bytes[i]) || (NOT_MINE == Bytes[i]) )
+        {
+            RowWidth++;
+        }
+        else if( ('\n' == Bytes[i]) && (RowWidth > 0) )
+        {
+            if( (*Height > 0) && (RowWidth != *Width) )
+            {
+                return FALSE;
+            }
+            *Width = RowWidth;
+            (*Height)++;
+            RowWidth = 0;
+        }
+    }
+    if( (0 == *Height) || (((u64)(*Width+2) * (u64)(*Height+2)) > 0xFFFFFFFFULL) ||
+        (FALSE == u8GrowBuffer(&Worker->Input, &Worker->InputCapacity, (u64)(*Width+2) * (u64)(*Height+2))) )
+    {
+        return FALSE;
+    }
+
+    /*Second pass fills inner cells row by row , whole array is filled with borders first*/
+    /*=============================================*/
+    *Input = Worker->Input;
+    memset(*Input, BORDER, (size_t)(*Width+2) * (size_t)(*Height+2));
+    u64 Cell = (u64)(*Width+2) + 1;
+    RowWidth = 0;
+    for(u64 i = 0; i < Job->Length; i++)
+    {
+        if( (MINE == Bytes[i]) || (NOT_MINE == Bytes[i]) )
+        {
+            (*Input)[Cell] = Bytes[i];
+            Cell++;
+            RowWidth++;
+        }
+        else if( ('\n' == Bytes[i]) && (RowWidth > 0) )
+        {
+            /*skip right border of this row and left border of next row*/
+            Cell += 2;
+            RowWidth = 0;
+        }
+    }
+
+    return TRUE;
+
+}/*end of u8ReadBatchMap()*/
+
+/*this function runs benchmark suite , every map family in every suite size up to a maximum side ,
+ *or a single generated map , and writes one JSON record per search to trace stream
+ *Arguments : generated map description or NULL for whole suite , maximum map side of suite , back propagation planner
  *Return    : void */
-void voidGotoLowerCell(void)
+void voidRunBenchmark(const char *Spec, u32 MaxSide, u8 Planner)
 {
-    /*Mark current cell visited then reposition to Lower cell*/
-    /*========================================================*/
-    /*Mark Current cell VISITED*/
-    CurrentOutputCell-> Status = VISITED;
-    /*reposition current cell position to Lower Cell*/
-    /*========================================================*/
-    /*Reposition Current Cell pointer in both maps to Lower Cell*/
-    CurrentInputCell  = CurrentInputCell->LowCell;
-    CurrentOutputCell = CurrentOutputCell->LowCell;
-    /*increment number of visited cells*/
-    /*========================================================*/
-    visited_cells++;
-}
\ No newline at end of file
+    const u32 Sides[BENCH_SIZES] = {5, 64, 256, 1024, 4096, 16384};
+    u8  First = TRUE;
+
+    fprintf(TraceFile, "{\"benchmark\" : [\n");
+
+    if( NULL != Spec )
+    {
+        u8  Family;
+        u32 Width, Height, Seed, Density;
+        voidParseMapSpec(Spec, &Family, &Width, &Height, &Seed, &Density);
+        voidBenchmarkMap(Family, Width, Height, Seed, Density, Planner, First);
+    }
+    else
+    {
+        for(u8 Family = 0; Family < MAP_FAMILIES; Family++)
+        {
+            for(u8 Size = 0; (Size < BENCH_SIZES) && (Sides[Size] <= MaxSide); Size++)
+            {
+                voidBenchmarkMap(Family, Sides[Size], Sides[Size], BENCH_SEED, DEFAULT_MINE_DENSITY, Planner, First);
+                First = FALSE;
+            }
+        }
+    }
+
+    fprintf(TraceFile, "\n]}\n");
+
+}/*end of voidRunBenchmark()*/
+
+/*this function generates and searches one benchmark map and writes its JSON record
+ *per step trace of the search (if any) goes to a temporary file and is only counted
+ *Arguments : family , number of columns and rows , seed , density , back propagation planner , TRUE for first record
+ *Return    : void */
+void voidBenchmarkMap(u8 Family, u32 Width, u32 Height, u32 Seed, u32 Density, u8 Planner, u8 First)
+{
+    explorer Bench;
+    cellmap  Inputmap;
+    u64      Time;
+    u64      OutputBytes;
+    u64      PeakMemory;
+    u64      MaxResident = 0;
+    u64      Reachable;
+    u64      FloodTime;
+    u64      Mismatches;
+    u32      Sweeps;
+    double   Seconds;
+
+    u8       *Source;
+    u8       Error;
+
+    voidExitOnError(u8GenerateMap(Family, Width, Height, Seed, Density, &Source), "Can not generate benchmark map", MapFamilyNames[Family]);
+    voidExitOnError(u8CreateInputMap(&Inputmap, Source, Width, Height, MAP_STORAGE_HEAP, NULL), "Can not create benchmark map", MapFamilyNames[Family]);
+    voidExitOnError(u8CreateExplorer(&Bench, &Inputmap, NULL), "Can not create benchmark explorer", NULL);
+    Bench.Planner             = Planner;
+    Bench.TraceLevel          = TraceLevel;
+    Bench.TraceSnapshotPeriod = TraceSnapshotPeriod;
+
+    /*search writes its trace to a temporary file so trace size can be measured*/
+    Bench.TraceFile = tmpfile();
+    if( NULL == Bench.TraceFile )
+    {
+        printf("Can not create benchmark trace file\n");
+        exit(1);
+    }
+    setvbuf(Bench.TraceFile, NULL, _IOFBF, TRACE_BUFFER_SIZE);
+
+    Time  = u64ReadClock();
+    Error = u8SearchMap(&Bench);
+    fflush(Bench.TraceFile);
+    Time  = u64ReadClock() - Time;
+    /*a map whose first row is full of mines is recorded with no steps*/
+    if( ERROR_NO_ENTRY != Error )
+    {
+        voidExitOnError(Error, "Benchmark search stopped on map", MapFamilyNames[Family]);
+    }
+
+#if defined(_WIN32)
+    OutputBytes = (u64)_ftelli64(Bench.TraceFile);
+#else
+    OutputBytes = (u64)ftello(Bench.TraceFile);
+    struct rusage Usage;
+    if( 0 == getrusage(RUSAGE_SELF, &Usage) )
+    {
+        MaxResident = (u64)Usage.ru_maxrss;
+    }
+#endif
+    fclose(Bench.TraceFile);
+    Bench.TraceFile = TraceFile;
+
+    /*flood fill oracle , its time is reported next to search time*/
+    voidExitOnError(u8CheckCoverage(&Bench, &Mismatches, &Reachable, &FloodTime, &Sweeps), "Can not check coverage of benchmark map", NULL);
+
+    /*branch stack and route queue never shrink during a search so their capacity is their peak*/
+    PeakMemory = u64MapMemory(&Bench.Inputmap) + u64MapMemory(&Bench.Outputmap) +
+                 (u64)Bench.BranchStack.Capacity * sizeof(u32) + (u64)Bench.RouteQueueCapacity * sizeof(u32);
+    if( NULL != Bench.RouteMarks )
+    {
+        PeakMemory += (u64)Bench.Outputmap.Stride * (Bench.Outputmap.Height+2) * sizeof(u32);
+    }
+    Seconds = (double)Time / 1e9;
+
+    fprintf(TraceFile, "%s  {\"family\" : \"%s\", \"width\" : %u, \"height\" : %u, \"seed\" : %u, \"density\" : %u, "
+                       "\"seconds\" : %.6f, \"cells_per_sec\" : %.0f, \"steps\" : %u, \"backtracks\" : %u, "
+                       "\"frontier_rescans\" : %u, \"branch_stack_high_water\" : %u, \"peak_memory_bytes\" : %llu, "
+                       "\"max_resident_kb\" : %llu, \"output_bytes\" : %llu, \"travel_cells\" : %llu, "
+                       "\"reachable_cells\" : %llu, \"flood_seconds\" : %.6f, \"flood_sweeps\" : %u, \"fully_explored\" : %s}",
+            (TRUE == First) ? "" : ",\n", MapFamilyNames[Family], Width, Height, Seed, Density,
+            Seconds, (double)Width * (double)Height / ((Seconds > 0) ? Seconds : 1e-9),
+            Bench.VisitedCells, Bench.Backtracks, Bench.FrontierRescans, Bench.BranchStack.HighWater,
+            PeakMemory, MaxResident, OutputBytes, u64TravelCells(&Bench),
+            Reachable, (double)FloodTime / 1e9, Sweeps, (0 == Mismatches) ? "true" : "false");
+    fflush(TraceFile);
+
+    voidFreeExplorer(&Bench);
+
+}/*end of voidBenchmarkMap()*/
+
+/*this function finds memory used by status of a map
+ *Arguments : pointer to map
+ *Return    : number of bytes */
+u64 u64MapMemory(const cellmap *map)
+{
+#if MAP_PACKED == TRUE
+    return (u64)map->Words * map->Planes * sizeof(u64);
+#elif MAP_TILED == TRUE
+    return (u64)TILE_CACHE_SLOTS * TILE_CELLS + (u64)map->Tiles->Tiles * (sizeof(u32) + 1);
+#else
+    return (u64)map->Stride * (u64)(map->Height+2);
+#endif
+
+}/*end of u64MapMemory()*/
+
+/*this function answers queries of a file over output map of explorer , each query is a line
+ *"row1 col1 row2 col2" in map coordinates (border row and column are 0) , answers go to trace stream
+ *Arguments : pointer to explorer after search , query file name
+ *Return    : void */
+void voidRunPathQueries(explorer *Explorer, const char *FileName)
+{
+    pathindex Index;
+    FILE *File = fopen(FileName, "r");
+    u32  Row1, Col1, Row2, Col2;
+    u32  *Path = NULL;
+    u32  PathCapacity = 0;
+    u64  Queries = 0;
+    u64  Found   = 0;
+    u64  Time;
+    u64  BuildTime;
+
+    if( NULL == File )
+    {
+        printf("Can not open path query file %s\n", FileName);
+        exit(1);
+    }
+
+    BuildTime = u64ReadClock();
+    voidExitOnError(u8BuildPathIndex(&Index, &Explorer->Outputmap), "Can not build path index", NULL);
+    BuildTime = u64ReadClock() - BuildTime;
+
+    /*paths are only written with per step trace levels*/
+    if( TraceLevel >= TRACE_DELTAS )
+    {
+        PathCapacity = Index.Width + Index.Height;
+        Path = (u32 *)malloc((size_t)PathCapacity * sizeof(u32));
+        if( NULL == Path )
+        {
+            printf("Not enough memory for path of %u cells\n", PathCapacity);
+            exit(1);
+        }
+    }
+
+    Time = u64ReadClock();
+    while( 4 == fscanf(File, "%u %u %u %u", &Row1, &Col1, &Row2, &Col2) )
+    {
+        u32 Length = PATH_NONE;
+
+        Queries++;
+        if( (Row1 <= Index.Height) && (Col1 <= Index.Width) && (Row2 <= Index.Height) && (Col2 <= Index.Width) )
+        {
+            voidExitOnError(u8QueryPath(&Index, Row1*Index.Stride + Col1, Row2*Index.Stride + Col2, Path, PathCapacity, &Length),
+                            "Can not answer path query of", FileName);
+        }
+        if( PATH_NONE == Length )
+        {
+            fprintf(TraceFile, "Path %u %u to %u %u : no safe path\n", Row1, Col1, Row2, Col2);
+            continue;
+        }
+        Found++;
+        fprintf(TraceFile, "Path %u %u to %u %u : %u moves\n", Row1, Col1, Row2, Col2, Length);
+
+        if( NULL != Path )
+        {
+            /*path can be longer than any straight route , grow array and walk again when needed*/
+            if( Length >= PathCapacity )
+            {
+                PathCapacity = Length + 1;
+                free(Path);
+                Path = (u32 *)malloc((size_t)PathCapacity * sizeof(u32));
+                if( NULL == Path )
+                {
+                    printf("Not enough memory for path of %u cells\n", PathCapacity);
+                    exit(1);
+                }
+                voidExitOnError(u8QueryPath(&Index, Row1*Index.Stride + Col1, Row2*Index.Stride + Col2, Path, PathCapacity, &Length),
+                                "Can not answer path query of", FileName);
+            }
+            for(u32 i = 0; i <= Length; i++)
+            {
+                fprintf(TraceFile, "%u %u%c", Path[i] / Index.Stride, Path[i] % Index.Stride, (i == Length) ? '\n' : ' ');
+            }
+        }
+    }
+    Time = u64ReadClock() - Time;
+
+    fprintf(TraceFile, "Path index : %u components built in %.3f ms\n"
+                       "Path queries : %llu , found %llu , %.0f queries/s , distance fields built %llu , reused %llu\n"
+                       "==============================\n",
+            Index.Components, (double)BuildTime / 1e6, Queries, Found,
+            (0 == Time) ? 0.0 : ((double)Queries * 1e9 / (double)Time), Index.Misses, Index.Hits);
+
+    free(Path);
+    fclose(File);
+    voidFreePathIndex(&Index);
+
+}/*end of voidRunPathQueries()*/
+
+/*this function reads map changes from a file and applies them to explorer after search , each change is
+ *a line "row col status" in map coordinates with status '*' (new mine) or '-' (cleared cell)
+ *Arguments : pointer to explorer after search , map changes file name
+ *Return    : void */
+void voidRunMapChanges(explorer *Explorer, const char *FileName)
+{
+    FILE      *File;
+    mapchange *Changes = NULL;
+    u32       Count = 0;
+    u32       Capacity = 0;
+    u32       Row, Col;
+    char      Status;
+    u32       Steps = Explorer->VisitedCells;
+    u32       CutCells;
+    u64       Time;
+
+#if MAP_TILED == TRUE
+    /*input map tiles are read from rows of map file and are never written back*/
+    printf("Map changes can not be applied to tiled maps\n");
+    return;
+#endif
+    File = fopen(FileName, "r");
+    if( NULL == File )
+    {
+        printf("Can not open map changes file %s\n", FileName);
+        exit(1);
+    }
+
+    while( 3 == fscanf(File, "%u %u %c", &Row, &Col, &Status) )
+    {
+        if( (0 == Row) || (Row > Explorer->Inputmap.Height) || (0 == Col) || (Col > Explorer->Inputmap.Width) ||
+            ((MINE != Status) && (NOT_MINE != Status)) )
+        {
+            printf("Map change %u %u %c is not a mine or cleared cell inside map\n", Row, Col, Status);
+            exit(1);
+        }
+        if( Count == Capacity )
+        {
+            u32       NewCapacity = (0 == Capacity) ? BRANCH_STACK_INITIAL_SIZE : (Capacity * 2);
+            mapchange *NewChanges = (mapchange *)realloc(Changes, (size_t)NewCapacity * sizeof(mapchange));
+
+            if( NULL == NewChanges )
+            {
+                printf("Not enough memory for %u map changes\n", NewCapacity);
+                exit(1);
+            }
+            Changes  = NewChanges;
+            Capacity = NewCapacity;
+        }
+        Changes[Count].Index  = Row*Explorer->Inputmap.Stride + Col;
+        Changes[Count].Status = (u8)Status;
+        Count++;
+    }
+    fclose(File);
+
+    Time     = u64ReadClock();
+    voidExitOnError(u8ApplyMapChanges(Explorer, Changes, Count, &CutCells), "Can not apply map changes of", FileName);
+    Time     = u64ReadClock() - Time;
+
+    fprintf(TraceFile, "Map changes : %u cells , cut off cells %u , new steps %u , updated in %.3f ms\n"
+                       "==============================\n",
+            Count, CutCells, Explorer->VisitedCells - Steps, (double)Time / 1e6);
+    if( ERROR_CHECK == u8PrintSearchResults(Explorer) )
+    {
+        printf("Reachable cells mismatch : %u reachable , %u visited\n",
+               Explorer->ReachableCells, u32CountStatus(&Explorer->Outputmap, VISITED));
+        exit(1);
+    }
+
+    free(Changes);
+
+}/*end of voidRunMapChanges()*/
+
+/*this function prints explored part of map , cells of every class and finished blocks from block summary
+ *of explorer and frontier cell nearest to explorer
+ *Arguments : pointer to explorer with block summary
+ *Return    : void */
+void voidSummaryReport(explorer *Explorer)
+{
+    blocksummary *Summary = Explorer->Summary;
+    u32 Visited  = SUMMARY_TOTAL(Summary, SUMMARY_VISITED);
+    u32 Frontier = SUMMARY_TOTAL(Summary, SUMMARY_FRONTIER);
+    u32 Unknown  = SUMMARY_TOTAL(Summary, SUMMARY_UNKNOWN);
+    u32 Counted  = Visited + Frontier + Unknown;
+
+    fprintf(TraceFile, "Block summary : %u levels , explored %.2f %% , visited %u , frontier %u , unknown %u , "
+                       "finished blocks %u of %u\n",
+            Summary->Levels, (0 == Counted) ? 100.0 : (100.0 * (Visited + Frontier) / Counted), Visited, Frontier, Unknown,
+            u32FinishedBlocks(Summary, 0), Summary->BlockCols[0] * Summary->BlockRows[0]);
+    if( 0 != Frontier )
+    {
+        u32 Distance;
+        u32 Cell = u32NearestFrontier(Summary, &Explorer->Outputmap, Explorer->CurrentCell, &Distance);
+
+        fprintf(TraceFile, "Nearest frontier cell : (%u,%u) , %u rows and columns away\n",
+                Cell / Summary->Stride, Cell % Summary->Stride, Distance);
+    }
+    fprintf(TraceFile, "==============================\n");
+
+}/*end of voidSummaryReport()*/
+
+/*this function writes a map to a map archive and prints archive size against map file size
+ *Arguments : name of map for the report , pointer to map , map archive file name
+ *Return    : void */
+void voidArchiveReport(const char *Name, cellmap *map, const char *FileName)
+{
+    u64 MapFileSize = MAP_FILE_HEADER_SIZE + (u64)map->Stride * (u64)(map->Height+2);
+    u64 Time        = u64ReadClock();
+    u64 Size;
+
+    voidExitOnError(u8SaveMapArchive(map, FileName, &Size), "Can not write map archive", FileName);
+
+    Time = u64ReadClock() - Time;
+    fprintf(TraceFile, "%s archive : %s , %llu bytes , %.1f times smaller than map file , written in %.3f ms\n"
+                       "==============================\n",
+            Name, FileName, Size, (double)MapFileSize / (double)Size, (double)Time / 1e6);
+
+}/*end of voidArchiveReport()*/
+
+/*this function is run by live monitor thread , it updates snapshot of search at every period until
+ *search ends , then it takes last snapshot
+ *Arguments : pointer to monitor reader
+ *Return    : NULL */
+void *pvMonitorReader(void *Argument)
+{
+    monitorreader   *Reader = (monitorreader *)Argument;
+#if !defined(_WIN32)
+    struct timespec Period;
+
+    Period.tv_sec  = 0;
+    Period.tv_nsec = (long)(1000000000UL / Reader->Rate);
+    if( 1 == Reader->Rate )
+    {
+        Period.tv_sec  = 1;
+        Period.tv_nsec = 0;
+    }
+
+    while( FALSE == atomic_load(&Reader->Done) )
+    {
+        nanosleep(&Period, NULL);
+        voidRecordSnapshot(Reader);
+    }
+#endif
+    /*search ended , no band is being written*/
+    voidRecordSnapshot(Reader);
+    return NULL;
+
+}/*end of pvMonitorReader()*/
+
+/*this function updates snapshot of monitor reader and writes it to snapshot file the way voidTraceStep();
+ *writes output map so GPS_Replay can read it
+ *Arguments : pointer to monitor reader
+ *Return    : void */
+void voidRecordSnapshot(monitorreader *Reader)
+{
+    const snapshot *Snapshot = &Reader->Snapshot;
+    const monitor  *Monitor  = Reader->Monitor;
+
+    Reader->CopiedBands += u32UpdateSnapshot(Reader->Monitor, &Reader->Snapshot);
+    Reader->BusyBands   += Snapshot->BusyBands;
+    Reader->Snapshots++;
+
+    if( NULL != Reader->File )
+    {
+        fprintf(Reader->File, "Step Number : %u\n"
+                              "==============================\n", Snapshot->Step);
+        for(u32 i = 0; i < (Monitor->Height+2); i++)
+        {
+            for(u32 j = 0; j < Monitor->Stride; j++)
+            {
+                putc(Snapshot->Status[i*Monitor->Stride + j], Reader->File);
+                putc(' ', Reader->File);
+            }
+            putc('\n', Reader->File);
+        }
+    }
+
+}/*end of voidRecordSnapshot()*/
@@ -0,0 +1,301 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/*==================================================================================*/
+/*==================================================================================*/
+/*Trace replay tool
+ *this program rebuilds output map of any search step from a trace written by GPS_Project
+ *with trace level deltas (-t deltas) or full (-t full -n N) and prints it like voidPrintMap();
+ *
+ *Usage : GPS_Replay <trace file> <step number>
+ *
+ *when trace has no record of the requested step (full level with N > 1) the latest
+ *recorded step before it is printed instead and a note is written to stderr*/
+/*==================================================================================*/
+/*==================================================================================*/
+/*New Types definitions*/
+/*=========================================*/
+typedef unsigned char   u8;
+typedef unsigned int    u16;
+typedef unsigned int    u32;
+
+/*Define true and false*/
+#define TRUE             1
+#define FALSE            0
+
+/*==================================================================================*/
+/*==================================================================================*/
+/*Functions Prototypes*/
+/*=========================================*/
+
+/*this function reads one line of any length from a stream without its new line character
+ *Arguments : stream , pointer to line buffer and pointer to its size , buffer grows when needed
+ *Return    : TRUE if a line was read , FALSE at end of stream */
+u8 u8ReadLine(FILE *Stream, char **Line, size_t *Size);
+
+/*this function reads map rows printed by voidPrintMap(); into replay map
+ *first call allocates replay map and takes its dimensions from printed rows
+ *Arguments : trace stream
+ *Return    : void */
+void voidReadMap(FILE *Stream);
+
+/*this function skips map rows printed by voidPrintMap();
+ *Arguments : trace stream
+ *Return    : void */
+void voidSkipMap(FILE *Stream);
+
+/*==================================================================================*/
+/*==================================================================================*/
+/*Global variable*/
+/*=========================================*/
+
+/*Replay map status , (Rows) x (Cols) cells including borders*/
+u8  *ReplayMap = NULL;
+u32 Rows = 0;
+u32 Cols = 0;
+
+/*Line buffer and the line following a map block that was read ahead*/
+char   *Line     = NULL;
+size_t LineSize  = 0;
+u8     LinePending = FALSE;
+
+/*==================================================================================*/
+/*==================================================================================*/
+
+int main(int argc, char *argv[])
+{
+    FILE *Trace;
+    u32  TargetStep;
+    u32  CurrentStep = 0;
+    u32  Step;
+    u32  Row, Col, OldStatus, NewStatus;
+    u8   Done = FALSE;
+
+    if( argc < 3 )
+    {
+        printf("Usage : %s <trace file> <step number>\n", argv[0]);
+        return 1;
+    }
+
+    Trace = fopen(argv[1], "rb");
+    if( NULL == Trace )
+    {
+        printf("Can not open trace file %s\n", argv[1]);
+        return 1;
+    }
+    TargetStep = (u32)strtoul(argv[2], NULL, 10);
+
+    /*go through trace records until a step after the requested one is found*/
+    while( (FALSE == Done) && ((TRUE == LinePending) || u8ReadLine(Trace, &Line, &LineSize)) )
+    {
+        LinePending = FALSE;
+
+        if( 0 == strcmp(Line, "Output Map before search :") )
+        {
+            /*initial output map*/
+            voidReadMap(Trace);
+            CurrentStep = 0;
+        }
+        else if( 1 == sscanf(Line, "Step Number : %u", &Step) )
+        {
+            /*full output map snapshot*/
+            if( Step > TargetStep )
+            {
+                Done = TRUE;
+            }
+            else
+            {
+                voidReadMap(Trace);
+                CurrentStep = Step;
+            }
+        }
+        else if( 1 == sscanf(Line, "Step %u", &Step) )
+        {
+            /*start of changed cells of a step*/
+            if( Step > TargetStep )
+            {
+                Done = TRUE;
+            }
+            else
+            {
+                CurrentStep = Step;
+            }
+        }
+        else if( 4 == sscanf(Line, "%u %u %x %x", &Row, &Col, &OldStatus, &NewStatus) )
+        {
+            /*changed cell*/
+            if( (NULL == ReplayMap) || (Row >= Rows) || (Col >= Cols) )
+            {
+                printf("Trace cell change %s is outside output map\n", Line);
+                return 1;
+            }
+            if( ReplayMap[Row*Cols + Col] != (u8)OldStatus )
+            {
+                fprintf(stderr, "Trace cell (%u,%u) was %02X but trace says %02X\n",
+                        Row, Col, ReplayMap[Row*Cols + Col], OldStatus);
+            }
+            ReplayMap[Row*Cols + Col] = (u8)NewStatus;
+        }
+        else if( 0 == strncmp(Line, "Map Searched in", 15) )
+        {
+            /*end of search steps*/
+            Done = TRUE;
+        }
+        else if( (0 == strcmp(Line, "Input Map :")) || (0 == strcmp(Line, "Original Input Map")) ||
+                 (0 == strcmp(Line, "Final Output Map")) )
+        {
+            voidSkipMap(Trace);
+        }
+    }
+
+    fclose(Trace);
+
+    if( NULL == ReplayMap )
+    {
+        printf("Trace %s has no output map , write it with -t deltas or -t full\n", argv[1]);
+        return 1;
+    }
+    if( CurrentStep != TargetStep )
+    {
+        fprintf(stderr, "Step %u is not recorded in trace , showing step %u\n", TargetStep, CurrentStep);
+    }
+
+    /*Print rebuilt map the same way voidPrintMap(); does*/
+    printf("Step Number : %u\n"
+           "==============================\n", CurrentStep);
+    for(u32 i = 0; i < Rows; i++)
+    {
+        for(u32 j = 0; j < Cols; j++)
+        {
+            putchar(ReplayMap[i*Cols + j]);
+            putchar(' ');
+        }
+        putchar('\n');
+    }
+
+    free(ReplayMap);
+    free(Line);
+    return 0;
+}
+
+/*==================================================================================*/
+/*==================================================================================*/
+/*Function Implementations*/
+
+/*this function reads one line of any length from a stream without its new line character
+ *Arguments : stream , pointer to line buffer and pointer to its size , buffer grows when needed
+ *Return    : TRUE if a line was read , FALSE at end of stream */
+u8 u8ReadLine(FILE *Stream, char **Line, size_t *Size)
+{
+    size_t Length = 0;
+    int    Char;
+
+    while( (EOF != (Char = getc(Stream))) && ('\n' != Char) )
+    {
+        /*keep room for the character and terminating null*/
+        if( (Length + 2) > *Size )
+        {
+            size_t NewSize = (0 == *Size) ? 256 : (*Size * 2);
+            char   *NewLine = (char *)realloc(*Line, NewSize);
+            if( NULL == NewLine )
+            {
+                printf("Not enough memory for trace line\n");
+                exit(1);
+            }
+            *Line = NewLine;
+            *Size = NewSize;
+        }
+        (*Line)[Length] = (char)Char;
+        Length++;
+    }
+
+    if( (EOF == Char) && (0 == Length) )
+    {
+        return FALSE;
+    }
+    if( NULL == *Line )
+    {
+        /*empty first line , allocate room for terminating null*/
+        *Line = (char *)malloc(256);
+        if( NULL == *Line )
+        {
+            printf("Not enough memory for trace line\n");
+            exit(1);
+        }
+        *Size = 256;
+    }
+
+    /*drop carriage return of CRLF traces*/
+    if( (Length > 0) && ('\r' == (*Line)[Length-1]) )
+    {
+        Length--;
+    }
+    (*Line)[Length] = '\0';
+    return TRUE;
+
+}/*end of u8ReadLine()*/
+
+/*this function reads map rows printed by voidPrintMap(); into replay map
+ *first call allocates replay map and takes its dimensions from printed rows
+ *Arguments : trace stream
+ *Return    : void */
+void voidReadMap(FILE *Stream)
+{
+    u32 Row = 0;
+
+    /*skip separator line*/
+    u8ReadLine(Stream, &Line, &LineSize);
+
+    /*map rows always start with a border cell followed by a space*/
+    while( (TRUE == (LinePending = u8ReadLine(Stream, &Line, &LineSize))) && ('=' == Line[0]) && (' ' == Line[1]) )
+    {
+        u32 RowCols = (u32)(strlen(Line) / 2);
+
+        if( NULL == ReplayMap )
+        {
+            /*first row of first map gives number of columns , rows are added as they are read*/
+            Cols = RowCols;
+        }
+        if( RowCols != Cols )
+        {
+            printf("Trace map row has %u cells , expected %u\n", RowCols, Cols);
+            exit(1);
+        }
+        if( Row >= Rows )
+        {
+            u8 *NewMap = (u8 *)realloc(ReplayMap, (size_t)(Row+1) * Cols);
+            if( NULL == NewMap )
+            {
+                printf("Not enough memory for replay map\n");
+                exit(1);
+            }
+            ReplayMap = NewMap;
+            Rows = Row + 1;
+        }
+        for(u32 j = 0; j < Cols; j++)
+        {
+            ReplayMap[Row*Cols + j] = (u8)Line[2*j];
+        }
+        Row++;
+    }
+
+    /*line after map block (if any) belongs to next record*/
+
+}/*end of voidReadMap()*/
+
+/*this function skips map rows printed by voidPrintMap();
+ *Arguments : trace stream
+ *Return    : void */
+void voidSkipMap(FILE *Stream)
+{
+    /*skip separator line*/
+    u8ReadLine(Stream, &Line, &LineSize);
+
+    while( (TRUE == (LinePending = u8ReadLine(Stream, &Line, &LineSize))) && ('=' == Line[0]) && (' ' == Line[1]) )
+    {
+    }
+
+    /*line after map block (if any) belongs to next record*/
+
+}/*end of voidSkipMap()*/